@@ -57,7 +57,7 @@ size_t DSPCore::getLatency() { return 0; }
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
   outputGain.METHOD(pv[ID::outputGain]->getDouble());                                    \
   mix.METHOD(pv[ID::mix]->getDouble());                                                  \
@@ -65,7 +65,6 @@ size_t DSPCore::getLatency() { return 0; }
   stereoPhaseLinkKp.METHOD(                                                              \
     EMAFilter<double>::cutoffToP(upRate, pv[ID::stereoPhaseLinkHz]->getDouble()));       \
   stereoPhaseCross.METHOD(pv[ID::stereoPhaseCross]->getDouble());                        \
-  stereoPhaseOffset.METHOD(pv[ID::stereoPhaseOffset]->getDouble());                      \
   phaseWarp.METHOD(pv[ID::phaseWarp]->getDouble());                                      \
                                                                                          \
   auto phaseModCorrection = double(48000) / upRate;                                      \
@@ -107,7 +106,7 @@ void DSPCore::updateUpRate()
 {
   upRate = double(sampleRate) * fold[oversampling];
 
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 
   for (auto &x : inputGate) x.setup(upRate, double(0.001));
 }
@@ -118,6 +117,7 @@ void DSPCore::reset()
   updateUpRate();
 
   ASSIGN_PARAMETER(reset);
+  stereoPhaseOffset.reset(pv[ID::stereoPhaseOffset]->getDouble());
 
   enableInputEnvelope = pv[ID::inputEnvelopeEnable]->getInt();
   enableSideEnvelope = pv[ID::sideChainEnvelopeEnable]->getInt();
@@ -146,6 +146,7 @@ void DSPCore::setParameters()
   }
 
   ASSIGN_PARAMETER(push);
+  stereoPhaseOffset.push(pv[ID::stereoPhaseOffset]->getDouble(), smootherContext);
 
   auto inputGateThreshold = pv[ID::inputGateThreshold]->getDouble();
   inputGate[0].prepare(upRate, inputGateThreshold);
@@ -168,25 +169,25 @@ void DSPCore::setParameters()
 
 std::array<double, 2> DSPCore::processFrame(const std::array<double, 4> &frame)
 {
-  outputGain.process();
-  mix.process();
+  outputGain.process(smootherContext);
+  mix.process(smootherContext);
 
-  stereoPhaseLinkKp.process();
-  stereoPhaseCross.process();
+  stereoPhaseLinkKp.process(smootherContext);
+  stereoPhaseCross.process(smootherContext);
   stereoPhaseOffset.process();
-  phaseWarp.process();
+  phaseWarp.process(smootherContext);
 
-  inputPhaseMod.process();
-  inputPreAsymmetry.process();
-  inputLowpassG.process();
-  inputHighpassG.process();
-  inputPostAsymmetry.process();
+  inputPhaseMod.process(smootherContext);
+  inputPreAsymmetry.process(smootherContext);
+  inputLowpassG.process(smootherContext);
+  inputHighpassG.process(smootherContext);
+  inputPostAsymmetry.process(smootherContext);
 
-  sidePhaseMod.process();
-  sidePreAsymmetry.process();
-  sideLowpassG.process();
-  sideHighpassG.process();
-  sidePostAsymmetry.process();
+  sidePhaseMod.process(smootherContext);
+  sidePreAsymmetry.process(smootherContext);
+  sideLowpassG.process(smootherContext);
+  sideHighpassG.process(smootherContext);
+  sidePostAsymmetry.process(smootherContext);
 
   auto sig0 = frame[0]; // Main L.
   auto sig1 = frame[1]; // Main R.
@@ -240,8 +241,8 @@ std::array<double, 2> DSPCore::processFrame(const std::array<double, 4> &frame)
   auto rot1 = frame[1] * lerp(mod1, mod0, stereoPhaseCross.getValue());
 
   return {
-    outputGain.process() * lerp(frame[0], rot0, mix.getValue()),
-    outputGain.process() * lerp(frame[1], rot1, mix.getValue()),
+    outputGain.process(smootherContext) * lerp(frame[0], rot0, mix.getValue()),
+    outputGain.process(smootherContext) * lerp(frame[1], rot1, mix.getValue()),
   };
 }
 
@@ -259,7 +260,7 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   for (size_t i = 0; i < length; ++i) {
     upSampler[0].process(in0[i]);
@@ -47,6 +47,7 @@ private:
   double sampleRate = 44100;
   double upRate = upFold * 44100;
 
+  SmootherContext<double> smootherContext;
   RotarySmoother<double> stereoPhaseOffset;
   ExpSmoother<double> outputGain;
   ExpSmoother<double> mix;
@@ -15,15 +15,20 @@ inline float maxAbs(const size_t length, const float *buffer)
   return max;
 }
 
-void DSPCore::setup(double sampleRate)
+void DSPCore::setup(double sampleRate, size_t channels)
 {
   this->sampleRate = float(sampleRate);
+  nChannel = std::clamp(channels, size_t(1), maxChannel);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
 
-  for (auto &lm : limiter)
-    lm.resize(size_t(UpSamplerFir::upfold * maxAttackSeconds * this->sampleRate) + 1);
+  // Unused channels are shrunk to save memory on small layouts.
+  const auto limiterSize
+    = size_t(UpSamplerFir::upfold * maxAttackSeconds * this->sampleRate) + 1;
+  for (size_t ch = 0; ch < maxChannel; ++ch) {
+    limiter[ch].resize(ch < nChannel ? limiterSize : 0);
+  }
 
   reset();
   startup();
@@ -78,55 +83,112 @@ void DSPCore::setParameters()
 
 template<typename T> T lerp(T a, T b, T t) { return a + t * (b - a); }
 
-std::array<float, 2> DSPCore::processStereoLink(float in0, float in1)
+/**
+Writes the absolute value of input linked across all channels to `linkedAbs`. The
+maximum over channels is taken in one pass, and each loop runs over frames, so the cost
+per channel is 2 vectorized loops. `length` must be less than or equal to
+`linkBlockSize`.
+*/
+void DSPCore::processLink(const size_t length, const float *const *input)
 {
-  auto &&stereoLink = interpStereoLink.process();
-  auto &&abs0 = std::fabs(in0);
-  auto &&abs1 = std::fabs(in1);
-  auto &&absMax = std::max(abs0, abs1);
-  return {lerp(abs0, absMax, stereoLink), lerp(abs1, absMax, stereoLink)};
+  for (size_t i = 0; i < length; ++i) {
+    linkAmount[i] = interpStereoLink.process(smootherContext);
+  }
+
+  std::fill(linkMax.begin(), linkMax.begin() + length, 0.0f);
+  for (size_t ch = 0; ch < nChannel; ++ch) {
+    const float *in = input[ch];
+    for (size_t i = 0; i < length; ++i) {
+      linkMax[i] = std::max(linkMax[i], std::fabs(in[i]));
+    }
+  }
+
+  for (size_t ch = 0; ch < nChannel; ++ch) {
+    const float *in = input[ch];
+    auto &dest = linkedAbs[ch];
+    for (size_t i = 0; i < length; ++i) {
+      dest[i] = lerp(std::fabs(in[i]), linkMax[i], linkAmount[i]);
+    }
+  }
 }
 
-void DSPCore::process(
-  const size_t length, const float *in0, const float *in1, float *out0, float *out1)
+/**
+Each stage runs over the whole block, so FIR loops stay hot and can be vectorized.
+`length` must be less than or equal to `truePeakBlockSize`.
+*/
+void DSPCore::processTruePeak(
+  const size_t length, const float *const *input, float *const *output)
 {
-  ScopedNoDenormals scopedDenormals;
+  const size_t upLength = upfold * length;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  std::array<const float *, maxChannel> upPtr{};
+  for (size_t ch = 0; ch < nChannel; ++ch) {
+    highEliminator[ch].process(length, input[ch], eliminated[ch].data());
+    upSampler[ch].process(length, eliminated[ch].data(), upSampled[ch].data());
+    upPtr[ch] = upSampled[ch].data();
+  }
 
-  if (param.value[ParameterID::truePeak]->getInt()) {
-    constexpr size_t upfold = UpSamplerFir::upfold;
-    for (size_t i = 0; i < length; ++i) {
-      auto sig0 = highEliminator[0].process(in0[i]);
-      auto sig1 = highEliminator[1].process(in1[i]);
+  processLink(upLength, upPtr.data());
 
-      upSampler[0].process(sig0);
-      upSampler[1].process(sig1);
+  for (size_t ch = 0; ch < nChannel; ++ch) {
+    auto &up = upSampled[ch];
+    auto &upAbs = linkedAbs[ch];
+    for (size_t i = 0; i < upLength; ++i) up[i] = limiter[ch].process(up[i], upAbs[i]);
+  }
 
-      std::array<std::array<float, upfold>, 2> expanded;
-      for (size_t j = 0; j < upfold; ++j) {
-        auto &&tp0 = upSampler[0].output[j];
-        auto &&tp1 = upSampler[1].output[j];
+  for (size_t ch = 0; ch < nChannel; ++ch) {
+    downSampler[ch].process(length, upSampled[ch].data(), output[ch]);
+  }
+}
+
+void DSPCore::process(
+  const size_t length, const float *const *input, float *const *output)
+{
+  ScopedNoDenormals scopedDenormals;
 
-        auto &&inAbs = processStereoLink(tp0, tp1);
+  smootherContext.setBufferSize(float(length));
 
-        expanded[0][j] = limiter[0].process(tp0, inAbs[0]);
-        expanded[1][j] = limiter[1].process(tp1, inAbs[1]);
+  std::array<const float *, maxChannel> in{};
+  std::array<float *, maxChannel> out{};
+  if (param.value[ParameterID::truePeak]->getInt()) {
+    for (size_t offset = 0; offset < length; offset += truePeakBlockSize) {
+      const size_t nFrame = std::min(truePeakBlockSize, length - offset);
+      for (size_t ch = 0; ch < nChannel; ++ch) {
+        in[ch] = input[ch] + offset;
+        out[ch] = output[ch] + offset;
       }
-
-      out0[i] = downSampler[0].process(expanded[0]);
-      out1[i] = downSampler[1].process(expanded[1]);
+      processTruePeak(nFrame, in.data(), out.data());
     }
   } else {
-    for (size_t i = 0; i < length; ++i) {
-      auto &&inAbs = processStereoLink(in0[i], in1[i]);
-      out0[i] = limiter[0].process(in0[i], inAbs[0]);
-      out1[i] = limiter[1].process(in1[i], inAbs[1]);
+    for (size_t offset = 0; offset < length; offset += linkBlockSize) {
+      const size_t nFrame = std::min(linkBlockSize, length - offset);
+      for (size_t ch = 0; ch < nChannel; ++ch) in[ch] = input[ch] + offset;
+      processLink(nFrame, in.data());
+
+      for (size_t ch = 0; ch < nChannel; ++ch) {
+        auto &lm = limiter[ch];
+        auto &inAbs = linkedAbs[ch];
+        const float *src = in[ch];
+        float *dest = output[ch] + offset;
+        for (size_t i = 0; i < nFrame; ++i) dest[i] = lm.process(src[i], inAbs[i]);
+      }
     }
   }
 
-  auto maxOut = std::max(maxAbs(length, out0), maxAbs(length, out1));
+  float maxOut = 0.0f;
+  for (size_t ch = 0; ch < nChannel; ++ch) {
+    maxOut = std::max(maxOut, maxAbs(length, output[ch]));
+  }
   auto &paramClippingPeak = param.value[ParameterID::overshoot];
   auto &&previousPeak = paramClippingPeak->getFloat();
   if (maxOut > previousPeak) paramClippingPeak->setFromFloat(maxOut);
 }
+
+// Stereo shorthand. `setup` must be called with 2 channels.
+void DSPCore::process(
+  const size_t length, const float *in0, const float *in1, float *out0, float *out1)
+{
+  std::array<const float *, 2> input{in0, in1};
+  std::array<float *, 2> output{out0, out1};
+  process(length, input.data(), output.data());
+}
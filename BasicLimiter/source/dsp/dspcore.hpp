@@ -23,25 +23,50 @@ using DownSamplerFir = DownSamplerFir8Fold<float>;
 
 class DSPCore {
 public:
+  // 16 channels covers 7.1.4 and 9.1.6 beds.
+  static constexpr size_t maxChannel = 16;
+
   GlobalParameter param;
 
-  void setup(double sampleRate);
+  void setup(double sampleRate, size_t channels = 2);
   void reset();
   void startup();
   size_t getLatency();
+  size_t getChannels() { return nChannel; }
   void setParameters();
+  void process(const size_t length, const float *const *input, float *const *output);
   void process(
     const size_t length, const float *in0, const float *in1, float *out0, float *out1);
 
 private:
-  std::array<float, 2> processStereoLink(float in0, float in1);
+  void processLink(const size_t length, const float *const *input);
+  void processTruePeak(
+    const size_t length, const float *const *input, float *const *output);
+
+  // Maximum number of frames passed to `processTruePeak`.
+  static constexpr size_t truePeakBlockSize = 64;
+  static constexpr size_t upfold = UpSamplerFir::upfold;
+  static constexpr size_t linkBlockSize = upfold * truePeakBlockSize;
 
   float sampleRate = 44100.0f;
+  size_t nChannel = 2;
 
+  SmootherContext<float> smootherContext;
   ExpSmoother<float> interpStereoLink;
 
-  std::array<Limiter<float>, 2> limiter;
-  std::array<NaiveConvolver<float, HighEliminationFir<float>>, 2> highEliminator;
-  std::array<FirPolyPhaseUpSampler<float, UpSamplerFir>, 2> upSampler;
-  std::array<FirDownSampler<float, DownSamplerFir>, 2> downSampler;
+  using LimiterType
+    = Limiter<float, FixedPointDoubleAverageFilter<double>, VanHerkPeakHold<float>>;
+
+  std::array<LimiterType, maxChannel> limiter;
+  std::array<NaiveConvolver<float, HighEliminationFir<float>>, maxChannel> highEliminator;
+  std::array<FirPolyPhaseUpSampler<float, UpSamplerFir>, maxChannel> upSampler;
+  std::array<FirDownSampler<float, DownSamplerFir>, maxChannel> downSampler;
+
+  std::array<std::array<float, truePeakBlockSize>, maxChannel> eliminated{};
+  std::array<std::array<float, linkBlockSize>, maxChannel> upSampled{};
+
+  // Buffers for `processLink`.
+  std::array<float, linkBlockSize> linkAmount{};
+  std::array<float, linkBlockSize> linkMax{};
+  std::array<std::array<float, linkBlockSize>, maxChannel> linkedAbs{};
 };
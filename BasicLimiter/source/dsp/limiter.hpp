@@ -1,9 +1,13 @@
 // SPDX-License-Identifier: GPL-3.0-only
 // Copyright Takamitsu Endo (ryukau@gmail.com)
 
+#include "../../../common/dsp/peakhold.hpp"
 #include "../../../common/dsp/smoother.hpp"
 
 #include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
 #include <random>
 #include <vector>
 
@@ -253,15 +257,98 @@ public:
   }
 };
 
-template<typename Sample> class Limiter {
+/**
+Double moving average filter with exact integer sums. Output is same as
+`DoubleAverageFilter` except rounding.
+
+Input is quantized towards 0 to a fixed point number. Sums are exact, so they never drift
+or exceed the true sum, and rounding trick in `DoubleAverageFilter::add` is unnecessary.
+Output is `floor(sum2 / denom)` which is also rounded towards 0.
+
+- Input must be in [0, 1]. Input outside of the range is clamped.
+- Number of fractional bits is chosen on `setFrames` so that `sum2` fits in 64 bits.
+  It's 52 bits at most, and decreases as `frames` increases.
+*/
+template<typename Sample> class FixedPointDoubleAverageFilter {
+private:
+  using Int = uint64_t;
+
+  Int denom = 1;
+  int fractionBits = 0;
+  Sample inScale = Sample(1);
+  Sample outScale = Sample(1);
+  Int sum1 = 0;
+  Int sum2 = 0;
+  Int buf = 0;
+  IntDelay<Int> delay1;
+  IntDelay<Int> delay2;
+
+public:
+  void resize(size_t size)
+  {
+    delay1.resize(size / 2 + 1);
+    delay2.resize(size / 2);
+  }
+
+  void reset()
+  {
+    sum1 = 0;
+    sum2 = 0;
+    buf = 0;
+    delay1.reset();
+    delay2.reset();
+  }
+
+  void setFrames(size_t frames)
+  {
+    auto &&half = frames / 2;
+    denom = std::max(Int(1), Int(half + 1) * Int(half));
+    delay1.setFrames(half + 1);
+    delay2.setFrames(half);
+
+    // `sum2 <= denom * 2^bits` must fit in 64 bits, and `sum2 / denom` in significand.
+    int bits = std::min(63 - int(std::bit_width(denom)), 52);
+    if (fractionBits == bits) return;
+    fractionBits = bits;
+    inScale = std::ldexp(Sample(1), bits);
+    outScale = std::ldexp(Sample(1), -bits);
+    reset();
+  }
+
+  Sample process(Sample input)
+  {
+    Int x = Int(std::clamp(input, Sample(0), Sample(1)) * inScale);
+
+    sum1 += x;
+    sum1 -= delay1.process(x);
+
+    sum2 += sum1;
+    sum2 -= delay2.process(sum1);
+
+    auto output = buf;
+    buf = sum2;
+    return Sample(output / denom) * outScale;
+  }
+};
+
+/**
+`Smoother` is either `DoubleAverageFilter<double>` or
+`FixedPointDoubleAverageFilter<double>`. `PeakHoldType` is either `PeakHold<Sample>` or
+`VanHerkPeakHold<Sample>`.
+*/
+template<
+  typename Sample,
+  typename Smoother = DoubleAverageFilter<double>,
+  typename PeakHoldType = PeakHold<Sample>>
+class Limiter {
 private:
   size_t attackFrames = 0;
   size_t sustainFrames = 0;
   Sample thresholdAmp = Sample(1); // thresholdAmp > 0.
   Sample gateAmp = 0;              // gateAmp >= 0.
 
-  PeakHold<Sample> peakhold;
-  DoubleAverageFilter<double> smoother;
+  PeakHoldType peakhold;
+  Smoother smoother;
   DoubleEMAFilter<Sample> releaseFilter;
   IntDelay<Sample> lookaheadDelay;
 
@@ -318,7 +405,14 @@ public:
 
   inline Sample applyCharacteristicCurve(Sample peakAmp)
   {
-    return peakAmp > thresholdAmp ? thresholdAmp / peakAmp : Sample(1);
+    if (peakAmp <= thresholdAmp) return Sample(1);
+
+    // Division may round up. Product of 2 floats is exact in double.
+    Sample gain = thresholdAmp / peakAmp;
+    if (double(gain) * double(peakAmp) > double(thresholdAmp)) {
+      gain = std::nextafter(gain, Sample(0));
+    }
+    return gain;
   }
 
   inline Sample processRelease(Sample gain)
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "../../../common/dsp/fir.hpp"
+
 #include <algorithm>
 #include <array>
 
@@ -10,60 +12,83 @@ namespace SomeDSP {
 
 template<typename Sample, typename Fir> class NaiveConvolver {
 private:
-  std::array<Sample, Fir::fir.size()> buf{};
+  FirHistory<Sample, Fir::fir.size()> buf;
 
 public:
-  void reset() { buf.fill(Sample(0)); }
+  void reset() { buf.reset(); }
 
   Sample process(Sample input)
   {
-    std::rotate(buf.rbegin(), buf.rbegin() + 1, buf.rend());
-    buf[0] = input;
+    buf.push(input);
+    return firDot<Sample, Fir::fir.size()>(buf.data(), Fir::fir.data());
+  }
 
-    Sample output = 0;
-    for (size_t n = 0; n < Fir::fir.size(); ++n) output += buf[n] * Fir::fir[n];
-    return output;
+  void process(const size_t length, const Sample *input, Sample *output)
+  {
+    for (size_t i = 0; i < length; ++i) output[i] = process(input[i]);
   }
 };
 
 template<typename Sample, typename FractionalDelayFIR> class FirPolyPhaseUpSampler {
-  std::array<Sample, FractionalDelayFIR::bufferSize> buf{};
+  static constexpr auto coefficient = transposeFir(FractionalDelayFIR::coefficient);
+
+  FirHistory<Sample, FractionalDelayFIR::bufferSize> buf;
 
 public:
   std::array<Sample, FractionalDelayFIR::upfold> output;
 
-  void reset() { buf.fill(Sample(0)); }
+  void reset() { buf.reset(); }
 
   void process(Sample input)
   {
-    std::rotate(buf.rbegin(), buf.rbegin() + 1, buf.rend());
-    buf[0] = input;
+    buf.push(input);
 
     std::fill(output.begin(), output.end(), Sample(0));
-    for (size_t i = 0; i < FractionalDelayFIR::coefficient.size(); ++i) {
-      auto &&phase = FractionalDelayFIR::coefficient[i];
-      for (size_t n = 0; n < phase.size(); ++n) output[i] += buf[n] * phase[n];
+    firPolyPhase(buf.data(), coefficient, output.data());
+  }
+
+  // Writes `upfold * length` samples to `dest`.
+  void process(const size_t length, const Sample *input, Sample *dest)
+  {
+    constexpr size_t upfold = FractionalDelayFIR::upfold;
+    for (size_t i = 0; i < length; ++i) {
+      buf.push(input[i]);
+
+      Sample *frame = dest + upfold * i;
+      std::fill(frame, frame + upfold, Sample(0));
+      firPolyPhase(buf.data(), coefficient, frame);
     }
   }
 };
 
 template<typename Sample, typename Fir> class FirDownSampler {
-  std::array<std::array<Sample, Fir::bufferSize>, Fir::upfold> buf{{}};
+  std::array<FirHistory<Sample, Fir::bufferSize>, Fir::upfold> buf;
 
 public:
-  void reset() { buf.fill({}); }
+  void reset()
+  {
+    for (auto &bf : buf) bf.reset();
+  }
 
   Sample process(const std::array<Sample, Fir::upfold> &input)
   {
-    for (size_t i = 0; i < Fir::upfold; ++i) {
-      std::rotate(buf[i].rbegin(), buf[i].rbegin() + 1, buf[i].rend());
-      buf[i][0] = input[i];
-    }
+    return process(input.data());
+  }
+
+  // Reads `upfold * length` samples from `input`.
+  void process(const size_t length, const Sample *input, Sample *output)
+  {
+    for (size_t i = 0; i < length; ++i) output[i] = process(input + Fir::upfold * i);
+  }
+
+  Sample process(const Sample *input)
+  {
+    for (size_t i = 0; i < Fir::upfold; ++i) buf[i].push(input[i]);
 
     Sample output = 0;
     for (size_t i = 0; i < Fir::coefficient.size(); ++i) {
       auto &&phase = Fir::coefficient[i];
-      for (size_t n = 0; n < phase.size(); ++n) output += buf[i][n] * phase[n];
+      output += firDot<Sample, Fir::bufferSize>(buf[i].data(), phase.data());
     }
     return output;
   }
@@ -37,10 +37,20 @@ tresult PLUGIN_API PlugProcessor::setBusArrangements(
   Vst::SpeakerArrangement *outputs,
   int32 numOuts)
 {
-  if (numIns == 1 && numOuts == 1 && inputs[0] == outputs[0]) {
-    return AudioEffect::setBusArrangements(inputs, numIns, outputs, numOuts);
-  }
-  return kResultFalse;
+  // Any layout is accepted as long as input and output match, including discrete ones.
+  if (numIns != 1 || numOuts != 1 || inputs[0] != outputs[0]) return kResultFalse;
+
+  auto nChannel = size_t(Vst::SpeakerArr::getChannelCount(inputs[0]));
+  if (nChannel < 1 || nChannel > DSPCore::maxChannel) return kResultFalse;
+
+  return AudioEffect::setBusArrangements(inputs, numIns, outputs, numOuts);
+}
+
+size_t PlugProcessor::getChannelCount()
+{
+  Vst::SpeakerArrangement arrangement;
+  if (getBusArrangement(Vst::kOutput, 0, arrangement) != kResultTrue) return 2;
+  return size_t(Vst::SpeakerArr::getChannelCount(arrangement));
 }
 
 uint32 PLUGIN_API PlugProcessor::getProcessContextRequirements()
@@ -52,14 +62,14 @@ uint32 PLUGIN_API PlugProcessor::getProcessContextRequirements()
 
 tresult PLUGIN_API PlugProcessor::setupProcessing(Vst::ProcessSetup &setup)
 {
-  dsp.setup(processSetup.sampleRate);
+  dsp.setup(processSetup.sampleRate, getChannelCount());
   return AudioEffect::setupProcessing(setup);
 }
 
 tresult PLUGIN_API PlugProcessor::setActive(TBool state)
 {
   if (state) {
-    dsp.setup(processSetup.sampleRate);
+    dsp.setup(processSetup.sampleRate, getChannelCount());
   } else {
     dsp.reset();
     lastState = 0;
@@ -73,20 +83,13 @@ tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
 {
   using ID = ParameterID::ID;
 
-  // Read inputs parameter changes.
-  if (data.inputParameterChanges) {
-    int32 parameterCount = data.inputParameterChanges->getParameterCount();
-    for (int32 index = 0; index < parameterCount; index++) {
-      auto queue = data.inputParameterChanges->getParameterData(index);
-      if (!queue) continue;
-      Vst::ParamValue value;
-      int32 sampleOffset;
-      if (queue->getPoint(queue->getPointCount() - 1, sampleOffset, value) != kResultTrue)
-        continue;
-      size_t id = queue->getParameterId();
-      if (id < dsp.param.value.size()) dsp.param.value[id]->setFromNormalized(value);
-    }
-  }
+  // Read inputs parameter changes. Points after the first frame are applied in
+  // `automation.splitBlock`.
+  automation.fetch(data.inputParameterChanges);
+  auto setParameter = [&](Vst::ParamID id, Vst::ParamValue value) {
+    if (id < dsp.param.value.size()) dsp.param.value[id]->setFromNormalized(value);
+  };
+  automation.dispatch(0, setParameter);
 
   if (data.processContext != nullptr) {
     uint64_t state = data.processContext->state;
@@ -99,27 +102,39 @@ tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
     lastState = state;
   }
 
+  if (
+    data.numInputs == 0 || data.numOutputs == 0 || data.numSamples <= 0
+    || size_t(data.inputs[0].numChannels) < dsp.getChannels()
+    || size_t(data.outputs[0].numChannels) < dsp.getChannels()
+    || data.symbolicSampleSize == Vst::kSample64)
+  {
+    automation.dispatch(ParameterAutomation::endOffset, setParameter);
+    dsp.setParameters();
+    return kResultOk;
+  }
+
   dsp.setParameters();
 
-  if (data.numInputs == 0) return kResultOk;
-  if (data.numOutputs == 0) return kResultOk;
-  if (data.numSamples <= 0) return kResultOk;
-  if (data.inputs[0].numChannels < 2) return kResultOk;
-  if (data.outputs[0].numChannels < 2) return kResultOk;
-  if (data.symbolicSampleSize == Vst::kSample64) return kResultOk;
-
-  auto isBypassing = dsp.param.value[ParameterID::bypass]->getInt();
-  if (isBypassing) {
-    if (!wasBypassing) dsp.reset();
-    processBypass(data);
-  } else {
-    float *in0 = data.inputs[0].channelBuffers32[0];
-    float *in1 = data.inputs[0].channelBuffers32[1];
-    float *out0 = data.outputs[0].channelBuffers32[0];
-    float *out1 = data.outputs[0].channelBuffers32[1];
-    dsp.process((size_t)data.numSamples, in0, in1, out0, out1);
-  }
-  wasBypassing = isBypassing;
+  const size_t nChannel = dsp.getChannels();
+  std::array<const float *, DSPCore::maxChannel> in{};
+  std::array<float *, DSPCore::maxChannel> out{};
+  automation.splitBlock(
+    data.numSamples, setParameter, [&](size_t begin, size_t end) {
+      if (begin > 0) dsp.setParameters();
+
+      auto isBypassing = dsp.param.value[ParameterID::bypass]->getInt();
+      if (isBypassing) {
+        if (!wasBypassing) dsp.reset();
+        processBypass(data, begin, end);
+      } else {
+        for (size_t ch = 0; ch < nChannel; ++ch) {
+          in[ch] = data.inputs[0].channelBuffers32[ch] + begin;
+          out[ch] = data.outputs[0].channelBuffers32[ch] + begin;
+        }
+        dsp.process(end - begin, in.data(), out.data());
+      }
+      wasBypassing = isBypassing;
+    });
 
   // Send parameter changes for GUI.
   if (!data.outputParameterChanges) return kResultOk;
@@ -133,12 +148,13 @@ tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
   return kResultOk;
 }
 
-void PlugProcessor::processBypass(Vst::ProcessData &data)
+void PlugProcessor::processBypass(Vst::ProcessData &data, size_t begin, size_t end)
 {
   float **in = data.inputs[0].channelBuffers32;
   float **out = data.outputs[0].channelBuffers32;
   for (int32_t ch = 0; ch < data.inputs[0].numChannels; ch++) {
-    if (in[ch] != out[ch]) memcpy(out[ch], in[ch], data.numSamples * sizeof(float));
+    if (in[ch] != out[ch])
+      memcpy(out[ch] + begin, in[ch] + begin, (end - begin) * sizeof(float));
   }
 }
 
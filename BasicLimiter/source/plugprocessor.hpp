@@ -10,6 +10,7 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/parameterautomation.hpp"
 #include "dsp/dspcore.hpp"
 
 namespace Steinberg {
@@ -41,7 +42,7 @@ public:
     return (Vst::IAudioProcessor *)new PlugProcessor();
   }
 
-  void processBypass(Vst::ProcessData &data);
+  void processBypass(Vst::ProcessData &data, size_t begin, size_t end);
 
 protected:
   inline int32 toDiscrete(Vst::ParamValue normalized, int32 stepCount)
@@ -49,8 +50,11 @@ protected:
     return int32(std::min<double>(stepCount, normalized * (stepCount + 1.0)));
   }
 
+  size_t getChannelCount();
+
   uint64_t lastState = 0;
   uint32_t wasBypassing = 0;
+  ParameterAutomation automation;
   DSPCore dsp;
 };
 
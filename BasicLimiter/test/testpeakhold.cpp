@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+// Checks that `VanHerkPeakHold` outputs the maximum of last `frames` inputs, for a fixed
+// window. Reference is a brute force maximum over the window.
+
+#include "../../common/dsp/peakhold.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace SomeDSP;
+
+std::vector<float> generateInput(size_t nFrame)
+{
+  std::minstd_rand rng{2345678};
+  std::uniform_real_distribution<float> uniform{0.0f, 1.0f};
+
+  std::vector<float> data(nFrame);
+  for (size_t i = 0; i < nFrame; ++i) {
+    switch ((i / 5000) % 4) {
+      default:
+      case 0: // Uniform noise.
+        data[i] = uniform(rng);
+        break;
+      case 1: // Decreasing ramp. Worst case of monotonic deque.
+        data[i] = float(5000 - i % 5000);
+        break;
+      case 2: // Increasing ramp.
+        data[i] = float(i % 5000);
+        break;
+      case 3: // Sparse spikes on silence.
+        data[i] = rng() % 211 == 0 ? 100.0f * uniform(rng) : 0.0f;
+        break;
+    }
+  }
+  return data;
+}
+
+bool testWindowMax(const std::vector<float> &input, size_t frames)
+{
+  VanHerkPeakHold<float> peakhold(2048);
+  peakhold.setFrames(frames);
+
+  size_t mismatch = 0;
+  for (size_t i = 0; i < input.size(); ++i) {
+    float expected = 0; // History before the first input is 0.
+    for (size_t j = 0; j < frames && j <= i; ++j) {
+      expected = std::max(expected, input[i - j]);
+    }
+    if (peakhold.process(input[i]) != expected) ++mismatch;
+  }
+
+  std::cout << "frames " << frames << ": " << mismatch << " mismatches.\n";
+  return mismatch == 0;
+}
+
+int main()
+{
+  auto input = generateInput(40000);
+
+  bool isPassed = true;
+  for (size_t frames : {0, 1, 2, 3, 4, 5, 16, 100, 1001, 2048}) {
+    isPassed &= testWindowMax(input, frames);
+  }
+  return isPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
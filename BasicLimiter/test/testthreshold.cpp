@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+// Checks that `Limiter` output never exceeds threshold on adversarial input. Also checks
+// that `FixedPointDoubleAverageFilter` follows `DoubleAverageFilter`.
+
+#include "../source/dsp/limiter.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace SomeDSP;
+
+constexpr float sampleRate = 8 * 48000.0f;
+
+std::vector<float> generateAdversarialInput(float threshold, size_t nFrame)
+{
+  std::minstd_rand rng{1234567};
+  std::uniform_real_distribution<float> uniform{0.0f, 1.0f};
+  std::exponential_distribution<float> expo{1.0f};
+  const float justAbove = std::nextafter(threshold, 2 * threshold);
+
+  std::vector<float> data(nFrame);
+  for (size_t i = 0; i < nFrame; ++i) {
+    switch ((i / 20000) % 5) {
+      default:
+      case 0: // Sparse spikes on silence.
+        data[i] = rng() % 97 == 0 ? 1000.0f * uniform(rng) : 0.001f * uniform(rng);
+        break;
+      case 1: // Alternating sign.
+        data[i] = (i & 1 ? 1.0f : -1.0f) * threshold * (1.0f + expo(rng));
+        break;
+      case 2: // Square wave just above threshold.
+        data[i] = (i / 37) & 1 ? justAbove : 0.5f * justAbove;
+        break;
+      case 3: // Heavy tail.
+        data[i] = 3.0f * threshold * expo(rng) * expo(rng);
+        break;
+      case 4: // Extreme jumps.
+        data[i] = uniform(rng) < 0.5f ? justAbove : 1e6f * threshold;
+        break;
+    }
+  }
+  return data;
+}
+
+template<typename Smoother> bool testThreshold(const char *name)
+{
+  constexpr size_t nFrame = 400000;
+
+  size_t overshoot = 0;
+  for (float threshold : {1.0f, 0.99999994f, 0.9f, 0.5f, 0.1234567f}) {
+    auto input = generateAdversarialInput(threshold, nFrame);
+    for (float attack : {0.0001f, 0.001f, 0.01f}) {
+      Limiter<float, Smoother> limiter;
+      limiter.resize(size_t(sampleRate) + 1);
+      limiter.prepare(sampleRate, attack, 0.0f, 0.01f, threshold, 0.0f);
+      limiter.reset(threshold);
+      for (const auto &x : input) {
+        if (std::fabs(limiter.process(x, std::fabs(x))) > threshold) ++overshoot;
+      }
+    }
+  }
+
+  std::cout << name << ": " << overshoot << " samples exceeded threshold.\n";
+  return overshoot == 0;
+}
+
+bool testFilterError()
+{
+  DoubleAverageFilter<double> reference;
+  FixedPointDoubleAverageFilter<double> filter;
+  reference.resize(4096);
+  filter.resize(4096);
+  reference.setFrames(4096);
+  filter.setFrames(4096);
+
+  std::minstd_rand rng{7654321};
+  std::uniform_real_distribution<double> uniform{0.0, 1.0};
+
+  double maxError = 0;
+  for (size_t i = 0; i < 200000; ++i) {
+    auto x = i % 50000 < 25000 ? uniform(rng) : 1.0;
+    auto y = filter.process(x);
+    maxError = std::max(maxError, std::fabs(y - reference.process(x)));
+    if (y > 1.0) {
+      std::cout << "FixedPointDoubleAverageFilter: Output exceeded 1.\n";
+      return false;
+    }
+  }
+
+  std::cout << "FixedPointDoubleAverageFilter: Max error " << maxError << "\n";
+  return maxError < 1e-6;
+}
+
+int main()
+{
+  bool isPassed = testThreshold<FixedPointDoubleAverageFilter<double>>("Fixed point");
+  isPassed &= testThreshold<DoubleAverageFilter<double>>("Floating point");
+  isPassed &= testFilterError();
+  return isPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
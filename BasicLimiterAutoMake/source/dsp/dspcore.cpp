@@ -19,8 +19,8 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.5f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.5f);
 
   auto bufferSize
     = size_t(UpSamplerFir::upfold * maxAttackSeconds * this->sampleRate) + 1;
@@ -95,7 +95,7 @@ template<typename T> inline T lerp(T a, T b, T t) { return a + t * (b - a); }
 
 std::array<float, 2> DSPCore::processStereoLink(float in0, float in1)
 {
-  auto &&stereoLink = interpStereoLink.process();
+  auto &&stereoLink = interpStereoLink.process(smootherContext);
   auto &&abs0 = std::fabs(in0);
   auto &&abs1 = std::fabs(in1);
   auto &&absMax = std::max(abs0, abs1);
@@ -118,6 +118,76 @@ inline void convertToLeftRight(float &mid, float &side)
   side = right;
 }
 
+/**
+Each stage runs over the whole block, so FIR loops stay hot and can be vectorized.
+`length` must be less than or equal to `truePeakBlockSize`.
+*/
+void DSPCore::processTruePeak(
+  const size_t length,
+  const float *in0,
+  const float *in1,
+  const float *sidechain0,
+  const float *sidechain1,
+  float *out0,
+  float *out1,
+  bool enableMidSide,
+  bool enableAutoMakeUp,
+  float makeUpTarget)
+{
+  const size_t upLength = upfold * length;
+
+  std::copy(in0, in0 + length, mainBuffer[0].begin());
+  std::copy(in1, in1 + length, mainBuffer[1].begin());
+  if (enableMidSide) {
+    for (size_t i = 0; i < length; ++i) {
+      convertToMidSide(mainBuffer[0][i], mainBuffer[1][i]);
+    }
+  }
+  for (size_t ch = 0; ch < 2; ++ch) {
+    highEliminatorMain[ch].process(length, mainBuffer[ch].data(), mainBuffer[ch].data());
+    upSamplerMain[ch].process(length, mainBuffer[ch].data(), upMain[ch].data());
+  }
+
+  highEliminatorSide[0].process(length, sidechain0, sideBuffer[0].data());
+  highEliminatorSide[1].process(length, sidechain1, sideBuffer[1].data());
+  if (enableMidSide) {
+    for (size_t i = 0; i < length; ++i) {
+      convertToMidSide(sideBuffer[0][i], sideBuffer[1][i]);
+    }
+  }
+  for (size_t ch = 0; ch < 2; ++ch) {
+    upSamplerSide[ch].process(length, sideBuffer[ch].data(), upSide[ch].data());
+  }
+
+  for (size_t i = 0; i < length; ++i) {
+    thresholdBuffer[i] = interpThreshold.process(smootherContext);
+  }
+
+  // `upSide` is overwritten by the absolute values for the limiter.
+  for (size_t i = 0; i < upLength; ++i) {
+    auto &&inAbs = processStereoLink(upSide[0][i], upSide[1][i]);
+    upSide[0][i] = inAbs[0];
+    upSide[1][i] = inAbs[1];
+    makeUpBuffer[i]
+      = autoMakeUp.process(enableAutoMakeUp, thresholdBuffer[i / upfold], makeUpTarget);
+  }
+
+  for (size_t ch = 0; ch < 2; ++ch) {
+    auto &up = upMain[ch];
+    auto &upAbs = upSide[ch];
+    for (size_t i = 0; i < upLength; ++i) {
+      auto &&threshold = thresholdBuffer[i / upfold];
+      up[i] = makeUpBuffer[i] * limiter[ch].process(up[i], upAbs[i], threshold);
+    }
+  }
+
+  downSampler[0].process(length, upMain[0].data(), out0);
+  downSampler[1].process(length, upMain[1].data(), out1);
+  if (enableMidSide) {
+    for (size_t i = 0; i < length; ++i) convertToLeftRight(out0[i], out1[i]);
+  }
+}
+
 void DSPCore::process(
   const size_t length,
   const float *in0,
@@ -132,7 +202,7 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   bool &&enableSidechain = pv[ID::sidechain]->getInt();
   const float *sidechain0 = enableSidechain ? in2 : in0;
@@ -144,46 +214,11 @@ void DSPCore::process(
     = !enableSidechain && static_cast<bool>(pv[ID::autoMakeupToggle]->getInt());
   float makeUpTarget = pv[ID::autoMakeupTargetGain]->getFloat();
   if (pv[ID::truePeak]->getInt()) {
-    constexpr size_t upfold = UpSamplerFir::upfold;
-    for (size_t i = 0; i < length; ++i) {
-      auto sig0 = in0[i];
-      auto sig1 = in1[i];
-      if (enableMidSide) convertToMidSide(sig0, sig1);
-
-      sig0 = highEliminatorMain[0].process(sig0);
-      sig1 = highEliminatorMain[1].process(sig1);
-      upSamplerMain[0].process(sig0);
-      upSamplerMain[1].process(sig1);
-
-      auto side0 = highEliminatorSide[0].process(sidechain0[i]);
-      auto side1 = highEliminatorSide[1].process(sidechain1[i]);
-      if (enableMidSide) convertToMidSide(side0, side1);
-
-      upSamplerSide[0].process(side0);
-      upSamplerSide[1].process(side1);
-
-      auto threshold = interpThreshold.process();
-      for (size_t j = 0; j < upfold; ++j) {
-        auto &&sc0 = upSamplerSide[0].output[j];
-        auto &&sc1 = upSamplerSide[1].output[j];
-
-        auto &&inAbs = processStereoLink(sc0, sc1);
-        auto &&makeup = autoMakeUp.process(enableAutoMakeUp, threshold, makeUpTarget);
-
-        auto &&tp0 = upSamplerMain[0].output[j];
-        auto &&tp1 = upSamplerMain[1].output[j];
-
-        expanded[0][j] = makeup * limiter[0].process(tp0, inAbs[0], threshold);
-        expanded[1][j] = makeup * limiter[1].process(tp1, inAbs[1], threshold);
-      }
-
-      sig0 = downSampler[0].process(expanded[0]);
-      sig1 = downSampler[1].process(expanded[1]);
-
-      if (enableMidSide) convertToLeftRight(sig0, sig1);
-
-      out0[i] = sig0;
-      out1[i] = sig1;
+    for (size_t offset = 0; offset < length; offset += truePeakBlockSize) {
+      const size_t nFrame = std::min(truePeakBlockSize, length - offset);
+      processTruePeak(
+        nFrame, in0 + offset, in1 + offset, sidechain0 + offset, sidechain1 + offset,
+        out0 + offset, out1 + offset, enableMidSide, enableAutoMakeUp, makeUpTarget);
     }
   } else {
     for (size_t i = 0; i < length; ++i) {
@@ -195,7 +230,7 @@ void DSPCore::process(
       auto side1 = sidechain1[i];
       if (enableMidSide) convertToMidSide(side0, side1);
 
-      auto threshold = interpThreshold.process();
+      auto threshold = interpThreshold.process(smootherContext);
       auto &&makeup = autoMakeUp.process(enableAutoMakeUp, threshold, makeUpTarget);
       auto &&inAbs = processStereoLink(side0, side1);
       sig0 = makeup * limiter[0].process(sig0, inAbs[0], threshold);
@@ -40,10 +40,25 @@ public:
 
 private:
   std::array<float, 2> processStereoLink(float in0, float in1);
+  void processTruePeak(
+    const size_t length,
+    const float *in0,
+    const float *in1,
+    const float *sidechain0,
+    const float *sidechain1,
+    float *out0,
+    float *out1,
+    bool enableMidSide,
+    bool enableAutoMakeUp,
+    float makeUpTarget);
+
+  // Maximum number of frames passed to `processTruePeak`.
+  static constexpr size_t truePeakBlockSize = 64;
+  static constexpr size_t upfold = UpSamplerFir::upfold;
 
   float sampleRate = 44100.0f;
-  std::array<std::array<float, UpSamplerFir::upfold>, 2> expanded{};
 
+  SmootherContext<float> smootherContext;
   ExpSmoother<float> interpStereoLink;
   ExpSmoother<float> interpThreshold;
 
@@ -54,4 +69,11 @@ private:
   std::array<FirPolyPhaseUpSampler<float, UpSamplerFir>, 2> upSamplerSide;
   std::array<FirDownSampler<float, DownSamplerFir>, 2> downSampler;
   AutoMakeUp<float> autoMakeUp;
+
+  std::array<std::array<float, truePeakBlockSize>, 2> mainBuffer{};
+  std::array<std::array<float, truePeakBlockSize>, 2> sideBuffer{};
+  std::array<float, truePeakBlockSize> thresholdBuffer{};
+  std::array<std::array<float, upfold * truePeakBlockSize>, 2> upMain{};
+  std::array<std::array<float, upfold * truePeakBlockSize>, 2> upSide{};
+  std::array<float, upfold * truePeakBlockSize> makeUpBuffer{};
 };
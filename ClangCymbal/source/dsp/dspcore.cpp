@@ -61,7 +61,7 @@ void DSPCore::setup(double sampleRate)
   this->sampleRate = float(sampleRate);
   upRate = upFold * this->sampleRate;
 
-  SmootherCommon<float>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 
   // 10 msec + 1 sample transition time.
   transitionBuffer.resize(1 + size_t(upRate * double(0.005)), float(0));
@@ -289,31 +289,31 @@ inline float alignModValue(float amount, float alignment, float value)
   return alignment * std::floor(value * amount / alignment + float(0.5));
 }
 
-float Note::process(float sampleRate)
+float Note::process(float sampleRate, const SmootherContext<float> &context)
 {
   constexpr auto eps = std::numeric_limits<float>::epsilon();
 
-  modEnvelopeToFdnPitch.process();
-  modEnvelopeToFdnOvertoneAdd.process();
-  modEnvelopeToOscJitter.process();
-  modEnvelopeToOscNoisePulseRatio.process();
-  oscBounce.process();
-  oscBounceCurve.process();
-  oscJitter.process();
-  oscDensity.process();
-  oscPulseAmpRandomness.process();
-  oscNoisePulseRatio.process();
-  fdnFreqOffset.process();
-  fdnOvertoneOffset.process();
-  fdnOvertoneMul.process();
-  fdnOvertoneAdd.process();
-  fdnOvertoneModulo.process();
-  fdnFeedback.process();
-  tremoloMix.process();
-  tremoloDepth.process();
-  tremoloDelayTime.process();
-  tremoloModToDelayTimeOffset.process();
-  tremoloModDeltaPhase.process();
+  modEnvelopeToFdnPitch.process(context);
+  modEnvelopeToFdnOvertoneAdd.process(context);
+  modEnvelopeToOscJitter.process(context);
+  modEnvelopeToOscNoisePulseRatio.process(context);
+  oscBounce.process(context);
+  oscBounceCurve.process(context);
+  oscJitter.process(context);
+  oscDensity.process(context);
+  oscPulseAmpRandomness.process(context);
+  oscNoisePulseRatio.process(context);
+  fdnFreqOffset.process(context);
+  fdnOvertoneOffset.process(context);
+  fdnOvertoneMul.process(context);
+  fdnOvertoneAdd.process(context);
+  fdnOvertoneModulo.process(context);
+  fdnFeedback.process(context);
+  tremoloMix.process(context);
+  tremoloDepth.process(context);
+  tremoloDelayTime.process(context);
+  tremoloModToDelayTimeOffset.process(context);
+  tremoloModDeltaPhase.process(context);
 
   fdnPitch.process(pitchSlideKp);
 
@@ -342,7 +342,7 @@ float Note::process(float sampleRate)
 
     sig += oscGain * oscOut;
   }
-  sig = oscLowpass.process(sig);
+  sig = oscLowpass.process(sig, context);
   auto oscOut = sig;
 
   if (fdnEnable) {
@@ -365,7 +365,7 @@ float Note::process(float sampleRate)
       overtone = ot;
     }
 
-    sig = float(0.01 * pi) * fdn.process(sig, fdnFeedback.getValue());
+    sig = float(0.01 * pi) * fdn.process(sig, fdnFeedback.getValue(), context);
   }
 
   tremoloPhase += tremoloModDeltaPhase.getValue();
@@ -389,9 +389,8 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setSampleRate(upRate);
-  SmootherCommon<float>::setTime(pv[ID::commonSmoothingTimeSecond]->getFloat());
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setTime(pv[ID::commonSmoothingTimeSecond]->getFloat());
+  smootherContext.setBufferSize(float(length));
 
   bool overSampling = pv[ID::overSampling]->getInt();
 
@@ -403,7 +402,7 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
 
       for (size_t j = 0; j < upFold; ++j) {
         if (note.state != NoteState::rest) {
-          halfIn[j] += note.process(upRate);
+          halfIn[j] += note.process(upRate, smootherContext);
         }
 
         if (isTransitioning) {
@@ -413,7 +412,7 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
           if (trIndex == trStop) isTransitioning = false;
         }
 
-        const auto masterGain = interpMasterGain.process();
+        const auto masterGain = interpMasterGain.process(smootherContext);
         halfIn[j] *= masterGain;
       }
 
@@ -424,7 +423,7 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
       float sig = 0;
 
       if (note.state != NoteState::rest) {
-        sig += note.process(upRate);
+        sig += note.process(upRate, smootherContext);
       }
 
       if (isTransitioning) {
@@ -434,7 +433,7 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
         if (trIndex == trStop) isTransitioning = false;
       }
 
-      const auto masterGain = interpMasterGain.process();
+      const auto masterGain = interpMasterGain.process(smootherContext);
       sig *= masterGain;
 
       out0[i] = sig;
@@ -604,7 +603,7 @@ void DSPCore::fillTransitionBuffer()
   if (trStop >= transitionBuffer.size()) trStop += transitionBuffer.size();
 
   for (size_t bufIdx = 0; bufIdx < transitionBuffer.size(); ++bufIdx) {
-    auto oscOut = note.process(upRate);
+    auto oscOut = note.process(upRate, smootherContext);
     auto idx = (trIndex + bufIdx) % transitionBuffer.size();
     auto interp = float(1) - float(bufIdx) / transitionBuffer.size();
 
@@ -5,6 +5,7 @@
 
 #include "../../../common/dsp/constants.hpp"
 #include "../../../common/dsp/multirate.hpp"
+#include "../../../common/dsp/notequeue.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../../../lib/pcg-cpp/pcg_random.hpp"
 #include "../parameter.hpp"
@@ -91,7 +92,7 @@ public:
     GlobalParameter &param);
   void slide(int_fast32_t noteId, float notePitch, float velocity, float sampleRate);
   void release(float sampleRate, GlobalParameter &param);
-  float process(float sampleRate);
+  float process(float sampleRate, const SmootherContext<float> &context);
 };
 
 class DSPCore final {
@@ -120,7 +121,7 @@ public:
     float velocity;
   };
 
-  std::vector<MidiNote> midiNotes;
+  NoteQueue<MidiNote> midiNotes;
 
   void pushMidiNote(
     bool isNoteOn,
@@ -137,22 +138,17 @@ public:
     note.pitch = pitch;
     note.tuning = tuning;
     note.velocity = velocityMap.map(velocity);
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(it->id, it->pitch, it->tuning, it->velocity);
+    midiNotes.dispatch(frame, [&](MidiNote &nt) {
+      if (nt.isNoteOn)
+        noteOn(nt.id, nt.pitch, nt.tuning, nt.velocity);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
-    }
+        noteOff(nt.id);
+    });
   }
 
 private:
@@ -170,6 +166,7 @@ private:
   DecibelScale<float> velocityMap{-60, 0, true};
 
   Note note;
+  SmootherContext<float> smootherContext;
   ExpSmoother<float> interpMasterGain;
 
   std::array<float, 2> halfIn{{}};
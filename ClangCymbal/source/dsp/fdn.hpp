@@ -206,7 +206,7 @@ public:
     highpass.reset();
   }
 
-  Sample process(Sample input, Sample feedback)
+  Sample process(Sample input, Sample feedback, const SmootherContext<Sample> &context)
   {
     bufIndex ^= 1;
     auto &front = buf[bufIndex];
@@ -218,8 +218,8 @@ public:
 
     for (size_t idx = 0; idx < length; ++idx) front[idx] = input + feedback * front[idx];
     delay.process(front);
-    lowpass.lowpass(front);
-    highpass.highpass(front);
+    lowpass.lowpass(front, context);
+    highpass.highpass(front, context);
 
     return std::accumulate(front.begin(), front.end(), Sample(0));
   }
@@ -61,10 +61,10 @@ public:
     ic2eq = 0;
   }
 
-  Sample process(Sample v0)
+  Sample process(Sample v0, const SmootherContext<float> &context)
   {
-    auto g = gSmoother.process();
-    auto k = kSmoother.process();
+    auto g = gSmoother.process(context);
+    auto k = kSmoother.process(context);
 
     // tick.
     auto v1 = (ic1eq + g * (v0 - ic2eq)) / (Sample(1) + g * (g + k));
@@ -121,11 +121,11 @@ public:
     ic2eq.fill(0);
   }
 
-  void lowpass(std::array<Sample, length> &v0)
+  void lowpass(std::array<Sample, length> &v0, const SmootherContext<Sample> &context)
   {
     for (size_t n = 0; n < length; ++n) {
-      auto gn = g[n].process();
-      auto kn = k[n].process();
+      auto gn = g[n].process(context);
+      auto kn = k[n].process(context);
       auto v1 = (ic1eq[n] + gn * (v0[n] - ic2eq[n])) / (Sample(1) + gn * (gn + kn));
       auto v2 = ic2eq[n] + gn * v1;
       ic1eq[n] = Sample(2) * v1 - ic1eq[n];
@@ -134,11 +134,11 @@ public:
     }
   }
 
-  void highpass(std::array<Sample, length> &v0)
+  void highpass(std::array<Sample, length> &v0, const SmootherContext<Sample> &context)
   {
     for (size_t n = 0; n < length; ++n) {
-      auto gn = g[n].process();
-      auto kn = k[n].process();
+      auto gn = g[n].process(context);
+      auto kn = k[n].process(context);
       auto v1 = (ic1eq[n] + gn * (v0[n] - ic2eq[n])) / (Sample(1) + gn * (gn + kn));
       auto v2 = ic2eq[n] + gn * v1;
       ic1eq[n] = Sample(2) * v1 - ic1eq[n];
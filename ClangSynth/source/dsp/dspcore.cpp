@@ -34,16 +34,24 @@ DSPCore::DSPCore()
   unisonPan.reserve(maximumVoice);
   noteIndices.reserve(maximumVoice);
   voiceIndices.reserve(maximumVoice);
+  voiceRenderer.reserve(maximumVoice);
+
+  info.wavetable = &wavetableBuffer[0];
 }
 
 void Note::setup(float sampleRate) { fdn.setup(sampleRate, maxDelayTime); }
 
 void DSPCore::setup(double sampleRate)
 {
+  // Discards the running build. Worker reads `upRate`.
+  wavetableTask.wait();
+  wavetableTask.finish();
+  isWavetableRefreshPending = false;
+
   this->sampleRate = float(sampleRate);
   upRate = upFold * this->sampleRate;
 
-  SmootherCommon<float>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 
   info.synchronizer.reset(upRate, defaultTempo, float(1));
   info.smootherKp = float(EMAFilter<double>::cutoffToP(sampleRate, 100));
@@ -53,6 +61,12 @@ void DSPCore::setup(double sampleRate)
 
   for (auto &note : notes) note.setup(upRate);
 
+  // Synchronous on startup, because table size depends on `upRate`.
+  auto &front = wavetableBuffer[nextWavetable == &wavetableBuffer[0] ? 1 : 0];
+  setWavetableParameter(front);
+  front.fillTable(upRate);
+  isWavetableRefeshed = param.value[ParameterID::ID::refreshWavetable]->getInt();
+
   reset();
 }
 
@@ -113,7 +127,7 @@ void DSPCore::reset()
   using ID = ParameterID::ID;
   auto &pv = param.value;
 
-  info.reset(param);
+  info.reset(param, smootherContext);
   info.synchronizer.reset(upRate, tempo, getTempoSyncInterval());
 
   ASSIGN_PARAMETER(reset);
@@ -175,7 +189,7 @@ void DSPCore::setParameters()
   using ID = ParameterID::ID;
   auto &pv = param.value;
 
-  info.setParameters(param);
+  info.setParameters(param, smootherContext);
 
   ASSIGN_PARAMETER(push);
 
@@ -184,23 +198,46 @@ void DSPCore::setParameters()
     note.setParameters(upRate, info, param);
   }
 
-  if (prepareRefresh || (!isWavetableRefeshed && pv[ID::refreshWavetable]->getInt())) {
-    info.wavetable.param.denominatorSlope
-      = pv[ID::oscSpectrumDenominatorSlope]->getFloat();
-    info.wavetable.param.rotationSlope = pv[ID::oscSpectrumRotationSlope]->getFloat();
-    info.wavetable.param.rotationOffset = pv[ID::oscSpectrumRotationOffset]->getFloat();
-    info.wavetable.param.interval = 1 + pv[ID::oscSpectrumInterval]->getInt();
-    info.wavetable.param.highpassIndex = pv[ID::oscSpectrumHighpass]->getInt();
-    info.wavetable.param.blur = pv[ID::oscSpectrumBlur]->getFloat();
-    for (size_t idx = 0; idx < oscOvertoneSize; ++idx) {
-      info.wavetable.param.overtoneAmp[idx] = std::polar(
-        pv[ID::oscOvertone0 + idx]->getFloat(),
-        float(pi) * pv[ID::oscRotation0 + idx]->getFloat());
-    }
-    info.wavetable.fillTable(upRate);
+  if (!isWavetableRefeshed && pv[ID::refreshWavetable]->getInt()) {
+    isWavetableRefreshPending = true;
   }
   isWavetableRefeshed = pv[ID::refreshWavetable]->getInt();
-  prepareRefresh = false;
+  updateWavetable();
+}
+
+void DSPCore::setWavetableParameter(Wavetable<float, oscOvertoneSize> &target)
+{
+  using ID = ParameterID::ID;
+  auto &pv = param.value;
+
+  target.param.denominatorSlope = pv[ID::oscSpectrumDenominatorSlope]->getFloat();
+  target.param.rotationSlope = pv[ID::oscSpectrumRotationSlope]->getFloat();
+  target.param.rotationOffset = pv[ID::oscSpectrumRotationOffset]->getFloat();
+  target.param.interval = 1 + pv[ID::oscSpectrumInterval]->getInt();
+  target.param.highpassIndex = pv[ID::oscSpectrumHighpass]->getInt();
+  target.param.blur = pv[ID::oscSpectrumBlur]->getFloat();
+  for (size_t idx = 0; idx < oscOvertoneSize; ++idx) {
+    target.param.overtoneAmp[idx] = std::polar(
+      pv[ID::oscOvertone0 + idx]->getFloat(),
+      float(pi) * pv[ID::oscRotation0 + idx]->getFloat());
+  }
+}
+
+// Swaps in the table filled by `wavetableTask`, then starts the pending request.
+void DSPCore::updateWavetable()
+{
+  if (wavetableTask.isDone()) {
+    auto front = nextWavetable;
+    nextWavetable = &wavetableBuffer[front == &wavetableBuffer[0] ? 1 : 0];
+    info.wavetable = front;
+    wavetableTask.finish();
+  }
+
+  if (!isWavetableRefreshPending || !wavetableTask.isIdle()) return;
+  isWavetableRefreshPending = false;
+
+  setWavetableParameter(*nextWavetable);
+  wavetableTask.request();
 }
 
 inline float alignModValue(float amount, float alignment, float value)
@@ -209,55 +246,75 @@ inline float alignModValue(float amount, float alignment, float value)
   return alignment * std::floor(value * amount / alignment + float(0.5));
 }
 
-std::array<float, 2> Note::process(float sampleRate, NoteProcessInfo &info)
+void Note::processModulation(
+  float sampleRate,
+  const NoteProcessInfo &info,
+  const NoteProcessFrame &frame,
+  Modulation &mod,
+  float &oscOctave,
+  float &oscPhase)
 {
   constexpr auto eps = std::numeric_limits<float>::epsilon();
 
-  if (state == NoteState::rest) return {float(0), float(0)};
-
-  auto modenv = info.envelope.process(modEnvelopePhase.process());
-  auto modenvToFdnLp
-    = noteToPitch(modenv * info.modEnvelopeToFdnLowpassCutoff.getValue(), info.eqTemp);
-  auto modenvToFdnHp
-    = noteToPitch(modenv * info.modEnvelopeToFdnHighpassCutoff.getValue(), info.eqTemp);
-  auto modenvToOsc = modenv * info.modEnvelopeToOscPitch.getValue();
-  auto modenvToFdn = modenv * info.modEnvelopeToFdnPitch.getValue();
-  auto modEnvelopeToFdnOvertoneAdd = modenv * info.modEnvelopeToFdnOvertoneAdd.getValue();
-
-  auto lfoValue = info.lfo.process(lfoPhase.process(info.lfoPhase));
-  auto lfoToOsc = alignModValue(
-    info.lfoToOscPitchAmount.getValue(), info.lfoToOscPitchAlignment, lfoValue);
-  auto lfoToFdn = alignModValue(
-    info.lfoToFdnPitchAmount.getValue(), info.lfoToFdnPitchAlignment, lfoValue);
+  auto modenv = info.envelope.process(modEnvelopePhase.process(), frame.envelopeFade);
+  mod.modenvToFdnLp
+    = noteToPitch(modenv * frame.modEnvelopeToFdnLowpassCutoff, info.eqTemp);
+  mod.modenvToFdnHp
+    = noteToPitch(modenv * frame.modEnvelopeToFdnHighpassCutoff, info.eqTemp);
+  auto modenvToOsc = modenv * frame.modEnvelopeToOscPitch;
+  auto modenvToFdn = modenv * frame.modEnvelopeToFdnPitch;
+  mod.modEnvelopeToFdnOvertoneAdd = modenv * frame.modEnvelopeToFdnOvertoneAdd;
+
+  auto lfoValue = info.lfo.process(lfoPhase.process(frame.lfoPhase), frame.lfoFade);
+  auto lfoToOsc
+    = alignModValue(frame.lfoToOscPitchAmount, info.lfoToOscPitchAlignment, lfoValue);
+  auto lfoToFdn
+    = alignModValue(frame.lfoToFdnPitchAmount, info.lfoToFdnPitchAlignment, lfoValue);
 
   auto oscPitchMod = (modenvToOsc + lfoToOsc) * float(12) / info.eqTemp;
-  auto fdnPitchMod = noteToPitch(modenvToFdn + lfoToFdn, info.eqTemp);
+  mod.fdnPitchMod = noteToPitch(modenvToFdn + lfoToFdn, info.eqTemp);
+
+  mod.oscGain = envelope.process() * velocity;
+  if (mod.oscGain >= eps) {
+    auto nt = oscPitchMod + oscNote + frame.oscNoteOffset;
+    oscOctave = info.wavetable->octaveOf(nt);
+    oscPhase = osc.advance(sampleRate, nt);
+  } else {
+    oscOctave = 0;
+    oscPhase = 0;
+  }
+}
+
+std::array<float, 2> Note::processFdn(
+  float sampleRate,
+  const NoteProcessInfo &info,
+  const NoteProcessFrame &frame,
+  const Modulation &mod,
+  float oscOut)
+{
+  constexpr auto eps = std::numeric_limits<float>::epsilon();
 
   float sig = impulse;
   impulse = 0;
 
-  auto oscGain = envelope.process() * velocity;
-  if (oscGain >= eps) {
-    auto nt = oscPitchMod + oscNote + info.oscNoteOffset.getValue();
-    sig += oscGain * osc.process(sampleRate, nt, info.wavetable);
-  }
+  if (mod.oscGain >= eps) sig += mod.oscGain * oscOut;
 
   if (info.fdnEnable) {
-    auto fdnFreq = info.fdnFreqOffset.getValue() * fdnPitch * fdnPitchMod;
+    auto fdnFreq = frame.fdnFreqOffset * fdnPitch * mod.fdnPitchMod;
     float overtone = float(1);
     for (size_t idx = 0; idx < fdnMatrixSize; ++idx) {
       fdn.delay.setDelayTimeAt(
         idx, sampleRate,
-        info.fdnOvertoneOffset.getValue()
+        frame.fdnOvertoneOffset
           + (float(1) + overtoneRandomness[idx]) * overtone,
         fdnFreq);
-      auto ot = overtone * info.fdnOvertoneMul.getValue() + info.fdnOvertoneAdd.getValue()
-        + modEnvelopeToFdnOvertoneAdd;
-      if (info.fdnOvertoneModulo.getValue() >= std::numeric_limits<float>::epsilon()) {
+      auto ot = overtone * frame.fdnOvertoneMul + frame.fdnOvertoneAdd
+        + mod.modEnvelopeToFdnOvertoneAdd;
+      if (frame.fdnOvertoneModulo >= std::numeric_limits<float>::epsilon()) {
         // Almost same operation as `std::fmod()`.
-        ot /= float(1) + info.fdnOvertoneModulo.getValue();
+        ot /= float(1) + frame.fdnOvertoneModulo;
         ot -= std::floor(ot);
-        ot *= float(1) + info.fdnOvertoneModulo.getValue();
+        ot *= float(1) + frame.fdnOvertoneModulo;
       }
       overtone = ot;
     }
@@ -266,15 +323,17 @@ std::array<float, 2> Note::process(float sampleRate, NoteProcessInfo &info)
     constexpr auto nyquist = float(0.49998);
     fdn.lowpass.setCutoff(
       std::clamp(
-        modenvToFdnLp * fdnLowpassCutoff.process(info.smootherKp), minCutoff, nyquist),
-      info.fdnLowpassQ.getValue());
+        mod.modenvToFdnLp * fdnLowpassCutoff.process(info.smootherKp), minCutoff,
+        nyquist),
+      frame.fdnLowpassQ);
     fdn.highpass.setCutoff(
       std::clamp(
-        modenvToFdnHp * fdnHighpassCutoff.process(info.smootherKp), minCutoff, nyquist),
-      info.fdnHighpassQ.getValue());
+        mod.modenvToFdnHp * fdnHighpassCutoff.process(info.smootherKp), minCutoff,
+        nyquist),
+      frame.fdnHighpassQ);
 
     // TODO: FDN gain.
-    sig = float(0.01 * pi) * fdn.process(sig, info.fdnFeedback.getValue());
+    sig = float(0.01 * pi) * fdn.process(sig, frame.fdnFeedback);
   }
 
   auto gateGain = gate.process();
@@ -288,6 +347,45 @@ std::array<float, 2> Note::process(float sampleRate, NoteProcessInfo &info)
   return {(float(1) - panGain) * sig, panGain * sig};
 }
 
+std::array<float, 2> Note::process(
+  float sampleRate, const NoteProcessInfo &info, const NoteProcessFrame &frame)
+{
+  if (state == NoteState::rest) return {float(0), float(0)};
+
+  Modulation mod;
+  float octave;
+  float phase;
+  float out;
+  processModulation(sampleRate, info, frame, mod, octave, phase);
+  info.wavetable->processBatch(1, &octave, &phase, &out);
+  return processFdn(sampleRate, info, frame, mod, out);
+}
+
+size_t Note::process(
+  size_t length,
+  float sampleRate,
+  const NoteProcessInfo &info,
+  const NoteProcessFrame *frame,
+  float *out0,
+  float *out1)
+{
+  if (state == NoteState::rest) return 0;
+
+  for (size_t i = 0; i < length; ++i) {
+    processModulation(
+      sampleRate, info, frame[i], modulation[i], oscOctave[i], oscPhase[i]);
+  }
+  info.wavetable->processBatch(length, oscOctave.data(), oscPhase.data(), oscOut.data());
+
+  for (size_t i = 0; i < length; ++i) {
+    if (state == NoteState::rest) return i;
+    const auto sig = processFdn(sampleRate, info, frame[i], modulation[i], oscOut[i]);
+    out0[i] = sig[0];
+    out1[i] = sig[1];
+  }
+  return length;
+}
+
 void DSPCore::process(const size_t length, float *out0, float *out1)
 {
   ScopedNoDenormals scopedDenormals;
@@ -295,8 +393,8 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<float>::setTime(pv[ID::smoothingTimeSecond]->getFloat());
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setTime(pv[ID::smoothingTimeSecond]->getFloat());
+  smootherContext.setBufferSize(float(length));
 
   // When tempo-sync is off, use defaultTempo BPM.
   bool isTempoSyncing = pv[ID::lfoTempoSync]->getInt();
@@ -304,20 +402,31 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
     upRate, isTempoSyncing ? tempo : defaultTempo, getTempoSyncInterval(), beatsElapsed,
     !isTempoSyncing || !isPlaying);
 
-  for (size_t i = 0; i < length; ++i) {
-    processMidiNote(i);
+  const bool isMultiThreading = pv[ID::multiThreading]->getInt();
 
-    halfIn.fill({});
+  auto prepare = [&](size_t, size_t frames) {
+    // Tables of `info.lfo` and `info.envelope` must stay while notes read them.
+    frames = std::min(frames, info.framesUntilRefresh());
+    for (size_t k = 0; k < frames; ++k) {
+      info.process(smootherContext);
+      processFrame[k] = info.frame();
+    }
+    return frames;
+  };
 
-    for (size_t j = 0; j < upFold; ++j) {
-      info.process();
+  auto renderVoice = [&](Note &note, size_t frames, auto &buffer) {
+    // Floating point environment is not inherited by workers.
+    ScopedNoDenormals scopedDenormals;
+    return note.process(
+      frames, upRate, info, processFrame.data(), buffer[0].data(), buffer[1].data());
+  };
 
-      for (auto &note : notes) {
-        if (note.state == NoteState::rest) continue;
-        auto sig = note.process(upRate, info);
-        halfIn[0][j] += sig[0];
-        halfIn[1][j] += sig[1];
-      }
+  // `offset` is in upsampled frames.
+  auto onBlock = [&](size_t offset, size_t frames, auto &mix) {
+    for (size_t k = 0; k < frames; ++k) {
+      const size_t j = (offset + k) % upFold;
+      halfIn[0][j] = mix[0][k];
+      halfIn[1][j] = mix[1][k];
 
       if (isTransitioning) {
         halfIn[0][j] += transitionBuffer[trIndex][0];
@@ -327,14 +436,39 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
         if (trIndex == trStop) isTransitioning = false;
       }
 
-      const auto masterGain = interpMasterGain.process();
+      const auto masterGain = interpMasterGain.process(smootherContext);
       halfIn[0][j] *= masterGain;
       halfIn[1][j] *= masterGain;
+
+      if (j + 1 < upFold) continue;
+      const size_t i = (offset + k) / upFold;
+      out0[i] = halfbandIir[0].process(halfIn[0]);
+      out1[i] = halfbandIir[1].process(halfIn[1]);
     }
+  };
 
-    out0[i] = halfbandIir[0].process(halfIn[0]);
-    out1[i] = halfbandIir[1].process(halfIn[1]);
-  }
+  midiNotes.splitBlock(
+    length,
+    [&](MidiNote &nt) {
+      if (nt.isNoteOn)
+        noteOn(nt.id, nt.pitch, nt.tuning, nt.velocity);
+      else
+        noteOff(nt.id);
+    },
+    [&](size_t begin, size_t end) {
+      size_t nActive = 0;
+      for (const auto &note : notes) {
+        if (note.state != NoteState::rest) ++nActive;
+      }
+
+      if (isMultiThreading && nActive >= minParallelVoice) {
+        voiceRenderer.render(
+          voicePool, upFold * begin, upFold * end, notes, prepare, renderVoice, onBlock);
+      } else {
+        voiceRenderer.render(
+          upFold * begin, upFold * end, notes, prepare, renderVoice, onBlock);
+      }
+    });
 }
 
 void Note::noteOn(
@@ -538,8 +672,9 @@ void DSPCore::fillTransitionBuffer(size_t noteIndex)
   trStop = trIndex - 1;
   if (trStop >= transitionBuffer.size()) trStop += transitionBuffer.size();
 
+  const auto frame = info.frame();
   for (size_t bufIdx = 0; bufIdx < transitionBuffer.size(); ++bufIdx) {
-    auto oscOut = note.process(upRate, info);
+    auto oscOut = note.process(upRate, info, frame);
     auto idx = (trIndex + bufIdx) % transitionBuffer.size();
     auto interp = float(1) - float(bufIdx) / transitionBuffer.size();
 
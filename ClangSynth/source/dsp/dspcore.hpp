@@ -3,9 +3,13 @@
 
 #pragma once
 
+#include "../../../common/dsp/backgroundtask.hpp"
 #include "../../../common/dsp/constants.hpp"
 #include "../../../common/dsp/multirate.hpp"
+#include "../../../common/dsp/notequeue.hpp"
 #include "../../../common/dsp/smoother.hpp"
+#include "../../../common/dsp/voicerenderer.hpp"
+#include "../../../common/dsp/workerpool.hpp"
 #include "../../../lib/pcg-cpp/pcg_random.hpp"
 #include "../parameter.hpp"
 #include "envelope.hpp"
@@ -13,8 +17,10 @@
 #include "lfo.hpp"
 #include "oscillator.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <memory>
 #include <random>
 
 using namespace SomeDSP;
@@ -34,6 +40,8 @@ inline float noteToPitch(float note, float equalTemperament = 12.0f)
 
 enum class NoteState { active, release, rest };
 
+constexpr size_t voiceBlockSize = 64; // In upsampled frames.
+
 #define NOTE_PROCESS_INFO_SMOOTHER(METHOD)                                                          \
   lfo.interpType = pv[ID::lfoInterpolation]->getInt();                                              \
   for (size_t idx = 0; idx < nLfoWavetable; ++idx) {                                                \
@@ -48,8 +56,8 @@ enum class NoteState { active, release, rest };
                                                                                                     \
   fdnEnable = pv[ID::fdnEnable]->getInt();                                                          \
                                                                                                     \
-  oscNoteOffsetRate = SmootherCommon<float>::timeInSamples >= 1                                     \
-    ? minOscNoteOffsetRate / SmootherCommon<float>::timeInSamples                                   \
+  oscNoteOffsetRate = context.timeInSamples >= 1                                                    \
+    ? minOscNoteOffsetRate / context.timeInSamples                                                  \
     : minOscNoteOffsetRate;                                                                         \
                                                                                                     \
   eqTemp = pv[ID::equalTemperament]->getFloat() + float(1);                                         \
@@ -88,11 +96,34 @@ enum class NoteState { active, release, rest };
   modEnvelopeToFdnPitch.METHOD(pv[ID::modEnvelopeToFdnPitch]->getFloat());                          \
   modEnvelopeToFdnOvertoneAdd.METHOD(pv[ID::modEnvelopeToFdnOvertoneAdd]->getFloat());
 
+// Values of `NoteProcessInfo` which change on each frame.
+struct NoteProcessFrame {
+  float lfoFade = 0;
+  float envelopeFade = 0;
+  float lfoPhase = 0;
+  float oscNoteOffset = 0;
+  float fdnFreqOffset = 0;
+  float fdnOvertoneOffset = 0;
+  float fdnOvertoneMul = 0;
+  float fdnOvertoneAdd = 0;
+  float fdnOvertoneModulo = 0;
+  float fdnLowpassQ = 0;
+  float fdnHighpassQ = 0;
+  float fdnFeedback = 0;
+  float lfoToOscPitchAmount = 0;
+  float lfoToFdnPitchAmount = 0;
+  float modEnvelopeToFdnLowpassCutoff = 0;
+  float modEnvelopeToFdnHighpassCutoff = 0;
+  float modEnvelopeToOscPitch = 0;
+  float modEnvelopeToFdnPitch = 0;
+  float modEnvelopeToFdnOvertoneAdd = 0;
+};
+
 struct NoteProcessInfo {
   pcg64 fdnRng;
   uint32_t previousSeed = 0;
   std::vector<std::vector<float>> fdnMatrixRandomBase;
-  Wavetable<float, oscOvertoneSize> wavetable;
+  const Wavetable<float, oscOvertoneSize> *wavetable = nullptr; // Owned by `DSPCore`.
 
   TableLFO<float, nLfoWavetable, 1024, TableLFOType::lfo> lfo;
   TableLFO<float, nModEnvelopeWavetable + 1, 1024, TableLFOType::envelope> envelope;
@@ -131,7 +162,7 @@ struct NoteProcessInfo {
     }
   }
 
-  void reset(GlobalParameter &param)
+  void reset(GlobalParameter &param, const SmootherContext<float> &context)
   {
     using ID = ParameterID::ID;
     auto &pv = param.value;
@@ -151,7 +182,7 @@ struct NoteProcessInfo {
     NOTE_PROCESS_INFO_SMOOTHER(reset);
   }
 
-  void setParameters(GlobalParameter &param)
+  void setParameters(GlobalParameter &param, const SmootherContext<float> &context)
   {
     using ID = ParameterID::ID;
     auto &pv = param.value;
@@ -169,7 +200,7 @@ struct NoteProcessInfo {
     NOTE_PROCESS_INFO_SMOOTHER(push);
   }
 
-  void process()
+  void process(const SmootherContext<float> &context)
   {
     lfo.processRefresh();
     envelope.processRefresh();
@@ -178,21 +209,56 @@ struct NoteProcessInfo {
 
     oscNoteOffset.process(oscNoteOffsetRate);
 
-    fdnFreqOffset.process();
-    fdnOvertoneOffset.process();
-    fdnOvertoneMul.process();
-    fdnOvertoneAdd.process();
-    fdnOvertoneModulo.process();
-    fdnLowpassQ.process();
-    fdnHighpassQ.process();
-    fdnFeedback.process();
-    lfoToOscPitchAmount.process();
-    lfoToFdnPitchAmount.process();
-    modEnvelopeToFdnLowpassCutoff.process();
-    modEnvelopeToFdnHighpassCutoff.process();
-    modEnvelopeToOscPitch.process();
-    modEnvelopeToFdnPitch.process();
-    modEnvelopeToFdnOvertoneAdd.process();
+    fdnFreqOffset.process(context);
+    fdnOvertoneOffset.process(context);
+    fdnOvertoneMul.process(context);
+    fdnOvertoneAdd.process(context);
+    fdnOvertoneModulo.process(context);
+    fdnLowpassQ.process(context);
+    fdnHighpassQ.process(context);
+    fdnFeedback.process(context);
+    lfoToOscPitchAmount.process(context);
+    lfoToFdnPitchAmount.process(context);
+    modEnvelopeToFdnLowpassCutoff.process(context);
+    modEnvelopeToFdnHighpassCutoff.process(context);
+    modEnvelopeToOscPitch.process(context);
+    modEnvelopeToFdnPitch.process(context);
+    modEnvelopeToFdnOvertoneAdd.process(context);
+  }
+
+  NoteProcessFrame frame()
+  {
+    NoteProcessFrame fr;
+    fr.lfoFade = lfo.getFade();
+    fr.envelopeFade = envelope.getFade();
+    fr.lfoPhase = lfoPhase;
+    fr.oscNoteOffset = oscNoteOffset.getValue();
+    fr.fdnFreqOffset = fdnFreqOffset.getValue();
+    fr.fdnOvertoneOffset = fdnOvertoneOffset.getValue();
+    fr.fdnOvertoneMul = fdnOvertoneMul.getValue();
+    fr.fdnOvertoneAdd = fdnOvertoneAdd.getValue();
+    fr.fdnOvertoneModulo = fdnOvertoneModulo.getValue();
+    fr.fdnLowpassQ = fdnLowpassQ.getValue();
+    fr.fdnHighpassQ = fdnHighpassQ.getValue();
+    fr.fdnFeedback = fdnFeedback.getValue();
+    fr.lfoToOscPitchAmount = lfoToOscPitchAmount.getValue();
+    fr.lfoToFdnPitchAmount = lfoToFdnPitchAmount.getValue();
+    fr.modEnvelopeToFdnLowpassCutoff = modEnvelopeToFdnLowpassCutoff.getValue();
+    fr.modEnvelopeToFdnHighpassCutoff = modEnvelopeToFdnHighpassCutoff.getValue();
+    fr.modEnvelopeToOscPitch = modEnvelopeToOscPitch.getValue();
+    fr.modEnvelopeToFdnPitch = modEnvelopeToFdnPitch.getValue();
+    fr.modEnvelopeToFdnOvertoneAdd = modEnvelopeToFdnOvertoneAdd.getValue();
+    return fr;
+  }
+
+  /*
+  Number of frames to `process` before `lfo` or `envelope` rewrites a table. Notes read
+  the tables, so frames in between can be rendered after all `process` calls.
+  */
+  size_t framesUntilRefresh() const
+  {
+    return std::max(
+      size_t(1), std::min(lfo.getRefreshRemaining(), envelope.getRefreshRemaining()));
   }
 };
 
@@ -236,7 +302,53 @@ public:
   void rest();
   bool isAttacking();
   float getGain();
-  std::array<float, 2> process(float sampleRate, NoteProcessInfo &info);
+
+  std::array<float, 2>
+  process(float sampleRate, const NoteProcessInfo &info, const NoteProcessFrame &frame);
+
+  /**
+  Returns the number of rendered frames. Rendering stops when the note is rested.
+
+  Modulation of all frames is computed first, so that the oscillator is read by one
+  `Wavetable::processBatch` call. Modulators are reset on note-on after rest, so
+  advancing them past the rested frame doesn't change the output.
+  */
+  size_t process(
+    size_t length,
+    float sampleRate,
+    const NoteProcessInfo &info,
+    const NoteProcessFrame *frame,
+    float *out0,
+    float *out1);
+
+private:
+  // Passed from `processModulation` to `processFdn`.
+  struct Modulation {
+    float oscGain = 0;
+    float modenvToFdnLp = 1;
+    float modenvToFdnHp = 1;
+    float modEnvelopeToFdnOvertoneAdd = 0;
+    float fdnPitchMod = 1;
+  };
+
+  void processModulation(
+    float sampleRate,
+    const NoteProcessInfo &info,
+    const NoteProcessFrame &frame,
+    Modulation &mod,
+    float &oscOctave,
+    float &oscPhase);
+  std::array<float, 2> processFdn(
+    float sampleRate,
+    const NoteProcessInfo &info,
+    const NoteProcessFrame &frame,
+    const Modulation &mod,
+    float oscOut);
+
+  std::array<Modulation, voiceBlockSize> modulation{};
+  alignas(64) std::array<float, voiceBlockSize> oscOctave{};
+  alignas(64) std::array<float, voiceBlockSize> oscPhase{};
+  alignas(64) std::array<float, voiceBlockSize> oscOut{};
 };
 
 class DSPCore {
@@ -256,7 +368,7 @@ public:
   float tempo = 120.0f;
   double beatsElapsed = 0.0f;
 
-  std::vector<MidiNote> midiNotes;
+  NoteQueue<MidiNote> midiNotes;
 
   DSPCore();
 
@@ -284,29 +396,25 @@ public:
     note.pitch = pitch;
     note.tuning = tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(it->id, it->pitch, it->tuning, it->velocity);
+    midiNotes.dispatch(frame, [&](MidiNote &nt) {
+      if (nt.isNoteOn)
+        noteOn(nt.id, nt.pitch, nt.tuning, nt.velocity);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
-    }
+        noteOff(nt.id);
+    });
   }
 
 private:
   float getTempoSyncInterval();
+  void setWavetableParameter(Wavetable<float, oscOvertoneSize> &target);
+  void updateWavetable();
 
   static constexpr size_t upFold = 2;
-  bool prepareRefresh = true;
   bool isWavetableRefeshed = false;
   float sampleRate = 44100.0f;
   float upRate = 88200.0f;
@@ -320,8 +428,16 @@ private:
   std::array<Note, maximumVoice> notes;
 
   NoteProcessInfo info;
+  SmootherContext<float> smootherContext;
   ExpSmoother<float> interpMasterGain;
 
+  static constexpr size_t maxVoiceWorker = 3;
+  static constexpr size_t minParallelVoice = 4;
+
+  // Per frame values of a sub-block, read by notes.
+  std::array<NoteProcessFrame, voiceBlockSize> processFrame{};
+  VoiceRenderer<float, 2, voiceBlockSize> voiceRenderer;
+
   std::array<std::array<float, 2>, 2> halfIn{{}};
   std::array<HalfBandIIR<float, HalfBandCoefficient<float>>, 2> halfbandIir;
 
@@ -329,4 +445,15 @@ private:
   bool isTransitioning = false;
   size_t trIndex = 0;
   size_t trStop = 0;
+
+  // `info.wavetable` points the front table, and `nextWavetable` is filled by
+  // `wavetableTask`. They are swapped on audio thread after the task is done.
+  bool isWavetableRefreshPending = false;
+  std::array<Wavetable<float, oscOvertoneSize>, 2> wavetableBuffer;
+  Wavetable<float, oscOvertoneSize> *nextWavetable = &wavetableBuffer[1];
+
+  // Declared last to stop the workers before other members are destructed. Workers are
+  // parked while multi-threading is off.
+  WorkerPool voicePool{maxVoiceWorker};
+  BackgroundTask wavetableTask{[this]() { nextWavetable->fillTable(upRate); }};
 };
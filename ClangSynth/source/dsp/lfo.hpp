@@ -112,7 +112,13 @@ public:
     fade = Sample(refreshCounter) / Sample(refreshInterval);
   }
 
-  Sample process(const Sample phase) const
+  Sample getFade() const { return fade; }
+
+  // Number of `processRefresh` calls until `table` is rewritten.
+  size_t getRefreshRemaining() const { return refreshInterval - refreshCounter; }
+
+  // `fade` is a value of `getFade()` at the frame.
+  Sample process(const Sample phase, const Sample fade) const
   {
     if constexpr (tableType == TableLFOType::envelope) {
       if (phase >= Sample(1)) return 0;
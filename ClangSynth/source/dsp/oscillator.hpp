@@ -7,6 +7,7 @@
 #include "../../../lib/pocketfft/pocketfft_hdronly.h"
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/mipmapwavetable.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -91,15 +92,12 @@ private:
 
   Sample basenote = Sample(0);
   Sample interval = Sample(12);
-  Sample maxIdx = Sample(0);
   size_t bufSize = 2;
 
-  std::vector<std::vector<Sample>> table{
-    {Sample(0), Sample(0), Sample(0)},
-    {Sample(0), Sample(0), Sample(0)},
-  };
+  MipmapWavetable<Sample> table;
 
   std::vector<std::complex<Sample>> fullSpectrum;
+  std::vector<std::complex<Sample>> destSpc;
   PocketFFT<Sample> fft;
 
   void generateSpectrum(size_t spectrumSize)
@@ -167,6 +165,8 @@ private:
 public:
   WavetableParameter<Sample, nOvertone> param;
 
+  // Storage is kept between calls. Refilling with the same `upRate` doesn't allocate
+  // except the plan made inside PocketFFT.
   void fillTable(Sample upRate)
   {
     size_t exponent = std::clamp<size_t>(
@@ -179,45 +179,34 @@ public:
     fft.setShape1D(bufSize);
 
     size_t nTable = size_t(std::log(Sample(nFreq)) / std::log(bendRange));
-    maxIdx = Sample(nTable - 1);
 
     basenote = freqToNote(upRate / Sample(bufSize));
     interval = Sample(12) * std::log2(bendRange);
 
-    table.resize(nTable + 1); // Last table is filled by 0.
-    std::vector<std::complex<Sample>> destSpc(fullSpectrum.size());
-    for (size_t idx = table.size() - 2; idx < table.size(); --idx) {
+    table.resize(nTable + 1, bufSize); // Last table is filled by 0.
+    destSpc.resize(fullSpectrum.size());
+    for (size_t idx = table.levels() - 2; idx < table.levels(); --idx) {
       size_t cutoff = size_t(nFreq * std::pow(bendRange, -Sample(idx))) + 1;
       std::fill(destSpc.begin(), destSpc.end(), std::complex<Sample>(0, 0));
       std::copy(fullSpectrum.begin(), fullSpectrum.begin() + cutoff, destSpc.begin());
 
-      table[idx].resize(bufSize + 1);
-      fft.c2r(destSpc.data(), table[idx].data());
-      table[idx].back() = table[idx][0];
+      fft.c2r(destSpc.data(), table.level(idx));
+      table.fillGuard(idx);
     }
-    table.back().resize(bufSize + 1);
-    std::fill(table.back().begin(), table.back().end(), Sample(0));
   }
 
+  Sample octaveOf(Sample note) const { return (note - basenote) / interval; }
+
   Sample process(Sample note, Sample phase) const
   {
-    auto octFloat = std::clamp((note - basenote) / interval, Sample(0), maxIdx);
-    auto iTbl = size_t(octFloat);
-    auto yFrac = octFloat - Sample(iTbl);
-
-    auto pos = Sample(bufSize) * phase;
-    auto idx = size_t(pos);
-    auto xFrac = pos - Sample(idx);
-
-    auto a0 = table[iTbl][idx];
-    auto a1 = table[iTbl][idx + 1];
-    auto s0 = a0 + xFrac * (a1 - a0);
-
-    auto b0 = table[iTbl + 1][idx];
-    auto b1 = table[iTbl + 1][idx + 1];
-    auto s1 = b0 + xFrac * (b1 - b0);
+    return table.process(octaveOf(note), phase);
+  }
 
-    return s0 + yFrac * (s1 - s0);
+  // `octave` is the output of `octaveOf`.
+  void processBatch(
+    const size_t count, const Sample *octave, const Sample *phase, Sample *output) const
+  {
+    table.processBatch(count, octave, phase, output);
   }
 };
 
@@ -226,11 +215,17 @@ template<typename Sample, size_t nOvertone> struct TableOsc {
 
   void reset() { phase = Sample(0); }
 
-  Sample process(Sample upRate, Sample note, const Wavetable<Sample, nOvertone> &wt)
+  // Returns phase to be passed to `Wavetable::process` or `processBatch`.
+  Sample advance(Sample upRate, Sample note)
   {
     phase += std::clamp(noteToFreq(note) / upRate, Sample(0), Sample(0.5));
     phase -= std::floor(phase);
-    return wt.process(note, phase);
+    return phase;
+  }
+
+  Sample process(Sample upRate, Sample note, const Wavetable<Sample, nOvertone> &wt)
+  {
+    return wt.process(note, advance(upRate, note));
   }
 };
 
@@ -21,7 +21,7 @@ constexpr float barboxWidth = int(64) * int(1 + (7 * labelWidth + 6 * margin) /
 constexpr float barboxHeight = 8 * labelHeight + 14 * margin;
 constexpr float lfoWidthFix = 25.0f;
 constexpr float innerWidth = 6 * labelWidth + 10 * margin + barboxWidth;
-constexpr float innerHeight = 8 * labelY + 2 * barboxHeight + 9 * margin;
+constexpr float innerHeight = 9 * labelY + 2 * barboxHeight + 9 * margin;
 constexpr uint32_t defaultWidth = uint32_t(innerWidth + 2 * uiMargin);
 constexpr uint32_t defaultHeight = uint32_t(innerHeight + 2 * uiMargin);
 
@@ -169,6 +169,7 @@ bool Editor::prepareUI()
   constexpr auto miscTop0 = unisonTop7 + labelY;
   constexpr auto miscTop1 = miscTop0 + labelY;
   constexpr auto miscTop2 = miscTop1 + labelY;
+  constexpr auto miscTop3 = miscTop2 + labelY;
 
   addGroupLabel(miscLeft0, miscTop0, 2 * labelWidth, labelHeight, uiTextSize, "Misc.");
 
@@ -182,6 +183,10 @@ bool Editor::prepareUI()
     miscLeft1, miscTop2, labelWidth, labelHeight, uiTextSize, ID::smoothingTimeSecond,
     Scales::smoothingTimeSecond, false, 5);
 
+  addCheckbox(
+    miscLeft0, miscTop3, 2 * labelWidth, labelHeight, uiTextSize, "Multi-Thread",
+    ID::multiThreading);
+
   // Oscillator.
   constexpr auto oscLeft0 = gainLeft0 + 2 * labelWidth + 4 * margin;
   constexpr auto oscLeft1 = oscLeft0 + labelWidth;
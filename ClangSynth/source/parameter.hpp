@@ -113,6 +113,8 @@ enum ID {
   modEnvelopeToFdnPitch,
   modEnvelopeToFdnOvertoneAdd,
 
+  multiThreading,
+
   ID_ENUM_LENGTH,
 };
 } // namespace ParameterID
@@ -404,6 +406,9 @@ struct GlobalParameter : public ParameterInterface {
     value[ID::modEnvelopeToFdnOvertoneAdd] = std::make_unique<DecibelValue>(
       0.0, Scales::fdnOvertoneAdd, "modEnvelopeToFdnOvertoneAdd", Info::kCanAutomate);
 
+    value[ID::multiThreading] = std::make_unique<UIntValue>(
+      0, Scales::boolScale, "multiThreading", Info::kCanAutomate);
+
     for (size_t id = 0; id < value.size(); ++id) value[id]->setId(Vst::ParamID(id));
   }
 
@@ -169,8 +169,8 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.01f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.01f);
 
   // 10 msec + 1 sample transition time.
   transitionBuffer.resize(1 + size_t(this->sampleRate * 0.005), {0.0f, 0.0f});
@@ -237,13 +237,13 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   std::array<float, 2> frame{};
   for (uint32_t i = 0; i < length; ++i) {
     processMidiNote(i);
 
-    info.process();
+    info.process(smootherContext);
 
     frame.fill(0.0f);
 
@@ -262,7 +262,7 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
       if (trIndex == trStop) isTransitioning = false;
     }
 
-    const auto masterGain = interpMasterGain.process();
+    const auto masterGain = interpMasterGain.process(smootherContext);
     out0[i] = masterGain * frame[0];
     out1[i] = masterGain * frame[1];
   }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/notequeue.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "delay.hpp"
@@ -57,11 +58,11 @@ struct NoteProcessInfo {
     NOTE_PROCESS_INFO_SMOOTHER(push);
   }
 
-  void process()
+  void process(const SmootherContext<float> &context)
   {
-    lowpassCutoff.process();
-    highpassCutoff.process();
-    noiseGain.process();
+    lowpassCutoff.process(context);
+    highpassCutoff.process(context);
+    noiseGain.process(context);
   }
 };
 
@@ -129,7 +130,7 @@ public:
   void noteOff(int32_t noteId);
   void fillTransitionBuffer(size_t noteIndex);
 
-  std::vector<MidiNote> midiNotes;
+  NoteQueue<MidiNote> midiNotes;
 
   void pushMidiNote(
     bool isNoteOn,
@@ -146,22 +147,17 @@ public:
     note.pitch = pitch;
     note.tuning = tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(uint32_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(it->id, it->pitch, it->tuning, it->velocity);
+    midiNotes.dispatch(frame, [&](MidiNote &nt) {
+      if (nt.isNoteOn)
+        noteOn(nt.id, nt.pitch, nt.tuning, nt.velocity);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
-    }
+        noteOff(nt.id);
+    });
   }
 
 private:
@@ -178,6 +174,7 @@ private:
   std::array<Note, maxVoice> notes;
 
   NoteProcessInfo info;
+  SmootherContext<float> smootherContext;
   ExpSmoother<float> interpMasterGain;
 
   std::vector<std::array<float, 2>> transitionBuffer{};
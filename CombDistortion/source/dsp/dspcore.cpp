@@ -29,7 +29,7 @@ size_t DSPCore::getLatency() { return 0; }
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
   pitchReleaseKp                                                                         \
     = EMAFilter<double>::secondToP(upRate, pv[ID::noteReleaseSeconds]->getDouble());     \
@@ -60,7 +60,7 @@ void DSPCore::updateUpRate()
   constexpr std::array<size_t, 3> fold{1, upFold, upFold};
   upRate = double(sampleRate) * fold[oversampling];
 
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 }
 
 void DSPCore::reset()
@@ -101,24 +101,39 @@ void DSPCore::setParameters()
   ASSIGN_PARAMETER(push);
 }
 
+bool DSPCore::isParameterSettled()
+{
+  const auto &sc = smootherContext;
+  return outputGain.isSettled(sc) && mix.isSettled(sc) && feedback.isSettled(sc)
+    && feedbackHighpassKp.isSettled(sc) && feedbackLowpassKp.isSettled(sc)
+    && delayTimeSamples.isSettled(sc) && amMix.isSettled(sc) && amClipGain.isSettled(sc)
+    && fmMix.isSettled(sc) && fmAmount.isSettled(sc) && fmClip.isSettled(sc);
+}
+
+template<bool isSettled>
 std::array<double, 2> DSPCore::processFrame(const std::array<double, 2> &frame)
 {
   notePitchToDelayTimeRelease.processKp(
     notePitchToDelayTime.process(pitchSmoothingKp), pitchReleaseKp);
 
-  outputGain.process();
-  mix.process();
-  feedback.process();
-  feedbackHighpassKp.process();
-  feedbackLowpassKp.process();
-  delayTimeSamples.process();
-  amMix.process();
-  amClipGain.process();
-  fmMix.process();
-  fmAmount.process();
-  fmClip.process();
+  if constexpr (!isSettled) {
+    outputGain.process(smootherContext);
+    mix.process(smootherContext);
+    feedback.process(smootherContext);
+    feedbackHighpassKp.process(smootherContext);
+    feedbackLowpassKp.process(smootherContext);
+    amMix.process(smootherContext);
+    amClipGain.process(smootherContext);
+    fmMix.process(smootherContext);
+    fmAmount.process(smootherContext);
+    fmClip.process(smootherContext);
+
+    // `delayTimeSamples` is updated twice per frame. Kept to preserve the sound.
+    delayTimeSamples.process(smootherContext);
+    delayTimeSamples.process(smootherContext);
+  }
 
-  auto delayTimeBase = delayTimeSamples.process() * notePitchToDelayTimeRelease.v2;
+  auto delayTimeBase = delayTimeSamples.getValue() * notePitchToDelayTimeRelease.v2;
 
   auto fm0 = std::min(fmAmount.getValue() * std::abs(frame[0]), fmClip.getValue());
   auto fm1 = std::min(fmAmount.getValue() * std::abs(frame[1]), fmClip.getValue());
@@ -156,11 +171,20 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  using ID = ParameterID::ID;
-  const auto &pv = param.value;
+  smootherContext.setBufferSize(double(length));
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  // Parameters are only pushed in `setParameters`, so this holds for the whole block.
+  if (isParameterSettled()) {
+    processBlock<true>(length, in0, in1, out0, out1);
+  } else {
+    processBlock<false>(length, in0, in1, out0, out1);
+  }
+}
 
+template<bool isSettled>
+void DSPCore::processBlock(
+  const size_t length, const float *in0, const float *in1, float *out0, float *out1)
+{
   for (size_t i = 0; i < length; ++i) {
     processMidiNote(i);
 
@@ -169,7 +193,8 @@ void DSPCore::process(
 
     if (oversampling == 2) { // 16x.
       for (size_t j = 0; j < upFold; ++j) {
-        auto frame = processFrame({upSampler[0].output[j], upSampler[1].output[j]});
+        auto frame = processFrame<isSettled>(
+          {upSampler[0].output[j], upSampler[1].output[j]});
         decimationLowpass[0].push(frame[0]);
         decimationLowpass[1].push(frame[1]);
         upSampler[0].output[j] = decimationLowpass[0].output();
@@ -181,7 +206,8 @@ void DSPCore::process(
         {upSampler[1].output[0], upSampler[1].output[upFold / 2]});
     } else if (oversampling == 1) { // Incomplete 16x.
       for (size_t j = 0; j < upFold / 2; ++j) {
-        auto frame = processFrame({upSampler[0].output[j], upSampler[1].output[j]});
+        auto frame = processFrame<isSettled>(
+          {upSampler[0].output[j], upSampler[1].output[j]});
         decimationLowpass[0].push(frame[0]);
         decimationLowpass[1].push(frame[1]);
         upSampler[0].output[j] = decimationLowpass[0].output();
@@ -190,7 +216,8 @@ void DSPCore::process(
       out0[i] = halfbandIir[0].process({upSampler[0].output[0], double(0)});
       out1[i] = halfbandIir[1].process({upSampler[1].output[0], double(0)});
     } else { // 1x.
-      auto frame = processFrame({upSampler[0].output[0], upSampler[1].output[0]});
+      auto frame = processFrame<isSettled>(
+        {upSampler[0].output[0], upSampler[1].output[0]});
       out0[i] = frame[0];
       out1[i] = frame[1];
     }
@@ -6,6 +6,7 @@
 #include "../../../common/dsp/constants.hpp"
 #include "../../../common/dsp/lfo.hpp"
 #include "../../../common/dsp/multirate.hpp"
+#include "../../../common/dsp/notequeue.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "filter.hpp"
@@ -60,32 +61,32 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    midiNotes.dispatch(frame, [&](NoteInfo &nt) {
+      if (nt.isNoteOn)
+        noteOn(nt);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
-    }
+        noteOff(nt.id);
+    });
   }
 
 private:
   void updateUpRate();
+  bool isParameterSettled();
+  template<bool isSettled>
   std::array<double, 2> processFrame(const std::array<double, 2> &input);
+  template<bool isSettled>
+  void processBlock(
+    const size_t length, const float *in0, const float *in1, float *out0, float *out1);
   double calcNotePitch(double note, double scale, double equalTemperament = 12);
 
   static constexpr size_t upFold = 16;
 
-  std::vector<NoteInfo> midiNotes;
+  NoteQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
 
   double sampleRate = 44100;
@@ -96,6 +97,7 @@ private:
   ExpSmootherLocal<double> notePitchToDelayTime;
   DoubleEMAFilter<double> notePitchToDelayTimeRelease;
 
+  SmootherContext<double> smootherContext;
   ExpSmoother<double> outputGain;
   ExpSmoother<double> mix;
   ExpSmoother<double> feedback;
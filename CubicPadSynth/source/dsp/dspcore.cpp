@@ -14,6 +14,10 @@
 
 #include <iostream>
 
+namespace SomeDSP {
+std::mutex fftwMutex;
+} // namespace SomeDSP
+
 #define PROCESSING_UNIT_NAME ProcessingUnit_FixedInstruction
 #define NOTE_NAME Note_FixedInstruction
 #define DSPCORE_NAME DSPCore_FixedInstruction
@@ -45,7 +49,8 @@ void NOTE_NAME::noteOn(
   float phase,
   NoteProcessInfo &info,
   std::array<PROCESSING_UNIT_NAME, nUnit> &units,
-  GlobalParameter &param)
+  GlobalParameter &param,
+  const SmootherContext<float> &context)
 {
   using ID = ParameterID::ID;
 
@@ -77,10 +82,11 @@ void NOTE_NAME::noteOn(
     vecIndex, param.value[ID::tableLowpassA]->getFloat(),
     param.value[ID::tableLowpassD]->getFloat(),
     param.value[ID::tableLowpassS]->getFloat(),
-    param.value[ID::tableLowpassR]->getFloat(), sampleRate);
+    param.value[ID::tableLowpassR]->getFloat(), sampleRate, context);
   unit.pitchEnvelope.reset(
     vecIndex, param.value[ID::pitchA]->getFloat(), param.value[ID::pitchD]->getFloat(),
-    param.value[ID::pitchS]->getFloat(), param.value[ID::pitchR]->getFloat(), sampleRate);
+    param.value[ID::pitchS]->getFloat(), param.value[ID::pitchR]->getFloat(), sampleRate,
+    context);
 }
 
 void NOTE_NAME::release(std::array<PROCESSING_UNIT_NAME, nUnit> &units)
@@ -130,12 +136,18 @@ DSPCORE_NAME::DSPCORE_NAME()
 
 void DSPCORE_NAME::setup(double sampleRate)
 {
+  // Discards the running render. It might be for previous sample rate.
+  tableTask.wait();
+  tableTask.finish();
+  isTableRefreshPending.store(false);
+  isTableFading = false;
+
   this->sampleRate = float(sampleRate);
 
-  midiNotes.resize(0);
+  midiNotes.clear();
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.04f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.04f);
 
   for (size_t idx = 0; idx < nUnit; ++idx) {
     units[idx].gainEnvelope.setup(
@@ -147,8 +159,17 @@ void DSPCORE_NAME::setup(double sampleRate)
   // 2 msec + 1 sample transition time.
   transitionBuffer.resize(1 + size_t(this->sampleRate * 0.01), {0.0f, 0.0f});
 
+  // 50 msec crossfade between old and new wavetable.
+  tableFadeDelta = 1.0f / std::max(1.0f, 0.05f * this->sampleRate);
+
   startup();
-  prepareRefresh = true;
+
+  // Synchronous on startup. `tableTask` is already stopped above.
+  refreshLfo();
+  takePadSynthConfig();
+  renderTable(*wavetable);
+  isLFORefreshed = param.value[ParameterID::refreshLFO]->getInt();
+  isTableRefeshed = param.value[ParameterID::refreshTable]->getInt();
 }
 
 void PROCESSING_UNIT_NAME::reset(GlobalParameter &param)
@@ -204,7 +225,10 @@ void DSPCORE_NAME::startup()
 }
 
 void PROCESSING_UNIT_NAME::setParameters(
-  float sampleRate, NoteProcessInfo &info, GlobalParameter &param)
+  float sampleRate,
+  NoteProcessInfo &info,
+  GlobalParameter &param,
+  const SmootherContext<float> &context)
 {
   using ID = ParameterID::ID;
 
@@ -213,85 +237,96 @@ void PROCESSING_UNIT_NAME::setParameters(
     param.value[ID::gainS]->getFloat(), param.value[ID::gainR]->getFloat(),
     notePitchToFrequency(
       notePitch + info.masterPitch.getValue(), info.equalTemperament.getValue(),
-      info.pitchA4Hz.getValue()));
+      info.pitchA4Hz.getValue()),
+    context);
   lowpassEnvelope.set(
     param.value[ID::tableLowpassA]->getFloat(),
     param.value[ID::tableLowpassD]->getFloat(),
     param.value[ID::tableLowpassS]->getFloat(),
-    param.value[ID::tableLowpassR]->getFloat(), sampleRate);
+    param.value[ID::tableLowpassR]->getFloat(), sampleRate, context);
   pitchEnvelope.set(
     param.value[ID::pitchA]->getFloat(), param.value[ID::pitchD]->getFloat(),
-    param.value[ID::pitchS]->getFloat(), param.value[ID::pitchR]->getFloat(), sampleRate);
+    param.value[ID::pitchS]->getFloat(), param.value[ID::pitchR]->getFloat(), sampleRate,
+    context);
 }
 
 void DSPCORE_NAME::setParameters(float tempo)
 {
   using ID = ParameterID::ID;
 
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
 
-  interpMasterGain.push(param.value[ID::gain]->getFloat());
+  interpMasterGain.push(param.value[ID::gain]->getFloat(), smootherContext);
 
-  info.masterPitch.push(getMasterPitch(param));
-  info.equalTemperament.push(param.value[ID::equalTemperament]->getFloat() + 1);
-  info.pitchA4Hz.push(param.value[ID::pitchA4Hz]->getFloat() + 100);
+  info.masterPitch.push(getMasterPitch(param), smootherContext);
+  info.equalTemperament.push(
+    param.value[ID::equalTemperament]->getFloat() + 1, smootherContext);
+  info.pitchA4Hz.push(param.value[ID::pitchA4Hz]->getFloat() + 100, smootherContext);
   info.tableLowpass.push(
-    float(Scales::tableLowpass.getMax()) - param.value[ID::tableLowpass]->getFloat());
-  info.tableLowpassKeyFollow.push(param.value[ID::tableLowpassKeyFollow]->getFloat());
+    float(Scales::tableLowpass.getMax()) - param.value[ID::tableLowpass]->getFloat(),
+    smootherContext);
+  info.tableLowpassKeyFollow.push(
+    param.value[ID::tableLowpassKeyFollow]->getFloat(), smootherContext);
   info.tableLowpassEnvelopeAmount.push(
-    param.value[ID::tableLowpassEnvelopeAmount]->getFloat());
+    param.value[ID::tableLowpassEnvelopeAmount]->getFloat(), smootherContext);
   info.pitchEnvelopeAmount.push(
     param.value[ID::pitchEnvelopeAmount]->getFloat()
-    * (param.value[ID::pitchEnvelopeAmountNegative]->getInt() ? -1 : 1));
+      * (param.value[ID::pitchEnvelopeAmountNegative]->getInt() ? -1 : 1),
+    smootherContext);
 
   const float beat = float(param.value[ID::lfoTempoNumerator]->getInt() + 1)
     / float(param.value[ID::lfoTempoDenominator]->getInt() + 1);
   info.lfoFrequency.push(
-    param.value[ID::lfoFrequencyMultiplier]->getFloat() * tempo / 240.0f / beat);
-  info.lfoPitchAmount.push(param.value[ID::lfoPitchAmount]->getFloat());
-  info.lfoLowpass.push(param.value[ID::lfoLowpass]->getFloat());
+    param.value[ID::lfoFrequencyMultiplier]->getFloat() * tempo / 240.0f / beat,
+    smootherContext);
+  info.lfoPitchAmount.push(param.value[ID::lfoPitchAmount]->getFloat(), smootherContext);
+  info.lfoLowpass.push(param.value[ID::lfoLowpass]->getFloat(), smootherContext);
 
-  for (auto &unit : units) unit.setParameters(sampleRate, info, param);
+  for (auto &unit : units) {
+    unit.setParameters(sampleRate, info, param, smootherContext);
+  }
 
   nVoice = 16 * (param.value[ID::nVoice]->getInt() + 1);
   if (nVoice > notes.size()) nVoice = notes.size();
 
-  if (prepareRefresh || (!isLFORefreshed && param.value[ID::refreshLFO]->getInt()))
-    refreshLfo();
+  if (!isLFORefreshed && param.value[ID::refreshLFO]->getInt()) refreshLfo();
   isLFORefreshed = param.value[ID::refreshLFO]->getInt();
 
-  if (prepareRefresh || (!isTableRefeshed && param.value[ID::refreshTable]->getInt()))
-    refreshTable();
+  if (!isTableRefeshed && param.value[ID::refreshTable]->getInt()) refreshTable();
   isTableRefeshed = param.value[ID::refreshTable]->getInt();
-
-  prepareRefresh = false;
+  updateTable();
 }
 
 std::array<float, 2> PROCESSING_UNIT_NAME::process(
   float sampleRate,
   WaveTable<tableSize, nOvertone> &wavetable,
+  WaveTable<tableSize, nOvertone> *fadingTable,
+  float tableFade,
   LfoWaveTable<lfoTableSize> &lfoWaveTable,
-  NoteProcessInfo &info)
+  const NoteProcessFrame &frame)
 {
-  lfo.setFrequency(sampleRate, info.lfoFrequency.getValue());
-  Vec16f lfoSig = info.lfoPitchAmount.getValue() * lfo.process(lfoWaveTable.table);
-  lfoSmoother.setP(info.lfoLowpass.getValue());
+  lfo.setFrequency(sampleRate, frame.lfoFrequency);
+  Vec16f lfoSig = frame.lfoPitchAmount * lfo.process(lfoWaveTable.table);
+  lfoSmoother.setP(frame.lfoLowpass);
   lfoSig = lfoSmoother.process(lfoSig);
 
-  pitch = lfoSig + notePitch + info.masterPitch.getValue()
-    + info.pitchEnvelopeAmount.getValue() * pitchEnvelope.process();
+  pitch = lfoSig + notePitch + frame.masterPitch
+    + frame.pitchEnvelopeAmount * pitchEnvelope.process();
   osc.setFrequency(
-    notePitchToFrequency(
-      pitch, info.equalTemperament.getValue(), info.pitchA4Hz.getValue()),
+    notePitchToFrequency(pitch, frame.equalTemperament, frame.pitchA4Hz),
     wavetable.tableBaseFreq);
 
-  float lpKey = info.tableLowpassKeyFollow.getValue();
-  float lpCutoff = info.tableLowpass.getValue();
+  float lpKey = frame.tableLowpassKeyFollow;
+  float lpCutoff = frame.tableLowpass;
   float lpPt = lpCutoff * 128.0f; // 128 comes from midi note number range + 1.
   lowpassPitch = (lpPt + lpKey * (lpCutoff * (float(nTable) - pitch) - lpPt))
-    - lowpassEnvelope.process() * info.tableLowpassEnvelopeAmount.getValue();
+    - lowpassEnvelope.process() * frame.tableLowpassEnvelopeAmount;
   lowpassPitch = select(lowpassPitch < 0.0f, 0.0f, lowpassPitch);
   Vec16f sig = osc.processCubic(lowpassPitch + pitch, wavetable.table);
+  if (fadingTable != nullptr) {
+    Vec16f prev = osc.readCubic(lowpassPitch + pitch, fadingTable->table);
+    sig = prev + tableFade * (sig - prev);
+  }
 
   gain = velocity * gainEnvelope.process();
   isActive = horizontal_add(gain) != 0;
@@ -299,17 +334,17 @@ std::array<float, 2> PROCESSING_UNIT_NAME::process(
   gain1 = gain * notePan;
   gain0 = gain - gain1;
 
-  std::array<float, 2> frame;
-  frame[0] = horizontal_add(gain0 * sig);
-  frame[1] = horizontal_add(gain1 * sig);
-  return frame;
+  std::array<float, 2> output;
+  output[0] = horizontal_add(gain0 * sig);
+  output[1] = horizontal_add(gain1 * sig);
+  return output;
 }
 
 void DSPCORE_NAME::process(const size_t length, float *out0, float *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
-  if (wavetable.isRefreshing) {
+  if (wavetable->isRefreshing) {
     for (int i = 0; i < length; ++i) {
       processMidiNote(i);
       out0[i] = 0;
@@ -318,44 +353,65 @@ void DSPCORE_NAME::process(const size_t length, float *out0, float *out1)
     return;
   }
 
-  SmootherCommon<float>::setBufferSize(float(length));
-
-  std::array<float, 2> frame{};
-  for (uint32_t i = 0; i < length; ++i) {
-    processMidiNote(i);
-
-    info.masterPitch.process();
-    info.equalTemperament.process();
-    info.pitchA4Hz.process();
-    info.tableLowpass.process();
-    info.tableLowpassKeyFollow.process();
-    info.tableLowpassEnvelopeAmount.process();
-    info.pitchEnvelopeAmount.process();
-    info.lfoFrequency.process();
-    info.lfoPitchAmount.process();
-    info.lfoLowpass.process();
-
-    frame.fill(0.0f);
-
-    for (auto &unit : units) {
-      if (!unit.isActive) continue;
-      auto sig = unit.process(sampleRate, wavetable, lfoWavetable, info);
-      frame[0] += sig[0];
-      frame[1] += sig[1];
+  smootherContext.setBufferSize(float(length));
+
+  auto onNote = [&](MidiNote &nt) {
+    if (nt.isNoteOn)
+      noteOn(nt.id, nt.pitch, nt.tuning, nt.velocity);
+    else
+      noteOff(nt.id);
+  };
+
+  auto prepare = [&](size_t, size_t frames) {
+    nFadingFrame = 0;
+    for (size_t k = 0; k < frames; ++k) {
+      info.process();
+      processFrame[k] = info.frame();
+
+      if (isTableFading) {
+        tableFade += tableFadeDelta;
+        if (tableFade >= 1.0f)
+          isTableFading = false;
+        else
+          nFadingFrame = k + 1;
+      }
+      tableFadeFrame[k] = tableFade;
+    }
+  };
+
+  auto renderVoice = [&](auto &unit, size_t frames, auto &buffer) {
+    size_t k = 0;
+    for (; k < frames && unit.isActive; ++k) {
+      auto sig = unit.process(
+        sampleRate, *wavetable, k < nFadingFrame ? nextWavetable : nullptr,
+        tableFadeFrame[k], lfoWavetable, processFrame[k]);
+      buffer[0][k] = sig[0];
+      buffer[1][k] = sig[1];
     }
+    return k;
+  };
+
+  auto onBlock = [&](size_t offset, size_t frames, const auto &mix) {
+    std::array<float, 2> frame{};
+    for (size_t j = 0; j < frames; ++j) {
+      frame[0] = mix[0][j];
+      frame[1] = mix[1][j];
+
+      if (isTransitioning) {
+        frame[0] += transitionBuffer[trIndex][0];
+        frame[1] += transitionBuffer[trIndex][1];
+        transitionBuffer[trIndex].fill(0.0f);
+        trIndex = (trIndex + 1) % transitionBuffer.size();
+        if (trIndex == trStop) isTransitioning = false;
+      }
 
-    if (isTransitioning) {
-      frame[0] += transitionBuffer[trIndex][0];
-      frame[1] += transitionBuffer[trIndex][1];
-      transitionBuffer[trIndex].fill(0.0f);
-      trIndex = (trIndex + 1) % transitionBuffer.size();
-      if (trIndex == trStop) isTransitioning = false;
+      const auto masterGain = interpMasterGain.process();
+      out0[offset + j] = masterGain * frame[0];
+      out1[offset + j] = masterGain * frame[1];
     }
+  };
 
-    const auto masterGain = interpMasterGain.process();
-    out0[i] = masterGain * frame[0];
-    out1[i] = masterGain * frame[1];
-  }
+  voiceRenderer.process(length, midiNotes, units, onNote, prepare, renderVoice, onBlock);
 }
 
 enum UnisonPanType {
@@ -419,7 +475,8 @@ void DSPCORE_NAME::noteOn(int32_t identifier, int16_t pitch, float tuning, float
 
   if (nUnison <= 1) {
     notes[noteIndices[0]].noteOn(
-      identifier, float(pitch) + tuning, velocity, 0.5f, 0.0f, info, units, param);
+      identifier, float(pitch) + tuning, velocity, 0.5f, 0.0f, info, units, param,
+      smootherContext);
     terminateNotes(nUnison);
     return;
   }
@@ -530,7 +587,7 @@ void DSPCORE_NAME::noteOn(int32_t identifier, int16_t pitch, float tuning, float
     auto phase = unisonPhase * unison / float(nUnison);
     notes[noteIndices[unison]].noteOn(
       identifier, notePitch, distGain(info.rng) * velocity, unisonPan[unison], phase,
-      info, units, param);
+      info, units, param, smootherContext);
   }
 
   terminateNotes(nUnison);
@@ -560,7 +617,7 @@ void DSPCORE_NAME::fillTransitionBuffer(size_t noteIndex)
       break;
     }
 
-    float oscOut = trOsc.process(pitch, wavetable.table);
+    float oscOut = trOsc.process(pitch, wavetable->table);
     auto idx = (trIndex + bufIdx) % transitionBuffer.size();
     auto interp = 1.0f - float(bufIdx) / transitionBuffer.size();
 
@@ -575,37 +632,70 @@ void DSPCORE_NAME::noteOff(int32_t noteId)
     if (notes[i].id == noteId) notes[i].release(units);
 }
 
-void DSPCORE_NAME::refreshTable()
+void DSPCORE_NAME::refreshTable() { isTableRefreshPending.store(true); }
+
+void DSPCORE_NAME::takePadSynthConfig()
 {
   using ID = ParameterID::ID;
 
-  reset();
+  auto &cfg = padSynthConfig;
+  cfg.sampleRate = sampleRate;
+  cfg.tableBaseFreq = param.value[ID::tableBaseFrequency]->getFloat();
 
-  const float tableBaseFreq = param.value[ID::tableBaseFrequency]->getFloat();
   const float pitchMultiplier = param.value[ID::overtonePitchMultiply]->getFloat();
   const float pitchModulo = param.value[ID::overtonePitchModulo]->getFloat();
   const float gainPow = param.value[ID::overtoneGainPower]->getFloat();
   const float widthMul = param.value[ID::overtoneWidthMultiply]->getFloat();
 
   for (size_t idx = 0; idx < nOvertone; ++idx) {
-    otFrequency[idx] = (pitchMultiplier * idx + 1.0f) * tableBaseFreq
+    cfg.frequency[idx] = (pitchMultiplier * idx + 1.0f) * cfg.tableBaseFreq
       * param.value[ID::overtonePitch0 + idx]->getFloat();
     if (pitchModulo != 0)
-      otFrequency[idx]
-        = fmodf(otFrequency[idx], notePitchToFrequency(pitchModulo, 12.0f, 440.0f));
-    otGain[idx] = powf(param.value[ID::overtoneGain0 + idx]->getFloat(), gainPow);
-    otBandWidth[idx] = widthMul * param.value[ID::overtoneWidth0 + idx]->getFloat();
-    otPhase[idx] = param.value[ID::overtonePhase0 + idx]->getFloat();
+      cfg.frequency[idx]
+        = fmodf(cfg.frequency[idx], notePitchToFrequency(pitchModulo, 12.0f, 440.0f));
+    cfg.gain[idx] = powf(param.value[ID::overtoneGain0 + idx]->getFloat(), gainPow);
+    cfg.bandWidth[idx] = widthMul * param.value[ID::overtoneWidth0 + idx]->getFloat();
+    cfg.phase[idx] = param.value[ID::overtonePhase0 + idx]->getFloat();
   }
 
-  wavetable.padsynth(
-    sampleRate, tableBaseFreq, otFrequency, otGain, otPhase, otBandWidth,
-    param.value[ID::padSynthSeed]->getInt(), param.value[ID::spectrumExpand]->getFloat(),
-    int32_t(param.value[ID::spectrumShift]->getInt()) - spectrumSize,
-    param.value[ID::profileComb]->getInt() + 1, param.value[ID::profileShape]->getFloat(),
-    param.value[ID::overtonePitchRandom]->getInt(),
-    param.value[ID::spectrumInvert]->getInt(),
-    param.value[ID::uniformPhaseProfile]->getInt());
+  cfg.seed = param.value[ID::padSynthSeed]->getInt();
+  cfg.expand = param.value[ID::spectrumExpand]->getFloat();
+  cfg.shift = int32_t(param.value[ID::spectrumShift]->getInt()) - spectrumSize;
+  cfg.profileSkip = param.value[ID::profileComb]->getInt() + 1;
+  cfg.profileShape = param.value[ID::profileShape]->getFloat();
+  cfg.randomPitch = param.value[ID::overtonePitchRandom]->getInt();
+  cfg.invertSpectrum = param.value[ID::spectrumInvert]->getInt();
+  cfg.uniformPhaseProfile = param.value[ID::uniformPhaseProfile]->getInt();
+}
+
+// Called from both audio thread and `tableTask` worker.
+void DSPCORE_NAME::renderTable(WaveTable<tableSize, nOvertone> &target)
+{
+  auto &cfg = padSynthConfig;
+  target.padsynth(
+    cfg.sampleRate, cfg.tableBaseFreq, cfg.frequency, cfg.gain, cfg.phase, cfg.bandWidth,
+    cfg.seed, cfg.expand, cfg.shift, cfg.profileSkip, cfg.profileShape, cfg.randomPitch,
+    cfg.invertSpectrum, cfg.uniformPhaseProfile);
+}
+
+/**
+Swaps in the table rendered by `tableTask`, then starts the next pending request. The
+back table is played during crossfade, so a new request waits until the fade ends.
+*/
+void DSPCORE_NAME::updateTable()
+{
+  if (tableTask.isDone()) {
+    std::swap(wavetable, nextWavetable);
+    tableTask.finish();
+    isTableFading = true;
+    tableFade = 0.0f;
+  }
+
+  if (isTableFading || !tableTask.isIdle()) return;
+  if (!isTableRefreshPending.exchange(false)) return;
+
+  takePadSynthConfig();
+  tableTask.request();
 }
 
 void DSPCORE_NAME::refreshLfo()
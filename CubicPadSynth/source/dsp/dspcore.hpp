@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include "../../../common/dsp/backgroundtask.hpp"
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/notequeue.hpp"
 #include "../../../common/dsp/smoother.hpp"
+#include "../../../common/dsp/voicerenderer.hpp"
 #include "../../../lib/vcl.hpp"
 #include "../../../lib/vcl/vectormath_exp.h"
 #include "../parameter.hpp"
@@ -13,6 +16,7 @@
 #include "oscillator.hpp"
 
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <random>
 
@@ -49,6 +53,20 @@ constexpr size_t nUnit = 8;
 
 enum class NoteState { active, release, rest };
 
+// Values of `NoteProcessInfo` which change on each frame.
+struct NoteProcessFrame {
+  float masterPitch = 0;
+  float equalTemperament = 0;
+  float pitchA4Hz = 0;
+  float tableLowpass = 0;
+  float tableLowpassKeyFollow = 0;
+  float tableLowpassEnvelopeAmount = 0;
+  float pitchEnvelopeAmount = 0;
+  float lfoFrequency = 0;
+  float lfoPitchAmount = 0;
+  float lfoLowpass = 0;
+};
+
 struct NoteProcessInfo {
   std::minstd_rand rng{0};
 
@@ -83,6 +101,36 @@ struct NoteProcessInfo {
     lfoPitchAmount.reset(param.value[ID::lfoPitchAmount]->getFloat());
     lfoLowpass.reset(param.value[ID::lfoLowpass]->getFloat());
   }
+
+  void process()
+  {
+    masterPitch.process();
+    equalTemperament.process();
+    pitchA4Hz.process();
+    tableLowpass.process();
+    tableLowpassKeyFollow.process();
+    tableLowpassEnvelopeAmount.process();
+    pitchEnvelopeAmount.process();
+    lfoFrequency.process();
+    lfoPitchAmount.process();
+    lfoLowpass.process();
+  }
+
+  NoteProcessFrame frame()
+  {
+    NoteProcessFrame fr;
+    fr.masterPitch = masterPitch.getValue();
+    fr.equalTemperament = equalTemperament.getValue();
+    fr.pitchA4Hz = pitchA4Hz.getValue();
+    fr.tableLowpass = tableLowpass.getValue();
+    fr.tableLowpassKeyFollow = tableLowpassKeyFollow.getValue();
+    fr.tableLowpassEnvelopeAmount = tableLowpassEnvelopeAmount.getValue();
+    fr.pitchEnvelopeAmount = pitchEnvelopeAmount.getValue();
+    fr.lfoFrequency = lfoFrequency.getValue();
+    fr.lfoPitchAmount = lfoPitchAmount.getValue();
+    fr.lfoLowpass = lfoLowpass.getValue();
+    return fr;
+  }
 };
 
 #define PROCESSING_UNIT_CLASS(INSTRSET)                                                  \
@@ -106,12 +154,18 @@ struct NoteProcessInfo {
                                                                                          \
     bool isActive = false;                                                               \
                                                                                          \
-    void setParameters(float sampleRate, NoteProcessInfo &info, GlobalParameter &param); \
+    void setParameters(                                                                  \
+      float sampleRate,                                                                  \
+      NoteProcessInfo &info,                                                             \
+      GlobalParameter &param,                                                            \
+      const SmootherContext<float> &context);                                            \
     std::array<float, 2> process(                                                        \
       float sampleRate,                                                                  \
       WaveTable<tableSize, nOvertone> &wavetable,                                        \
+      WaveTable<tableSize, nOvertone> *fadingTable,                                      \
+      float tableFade,                                                                   \
       LfoWaveTable<lfoTableSize> &lfoWaveTable,                                          \
-      NoteProcessInfo &info);                                                            \
+      const NoteProcessFrame &frame);                                                    \
     void reset(GlobalParameter &param);                                                  \
   };
 
@@ -135,7 +189,8 @@ struct NoteProcessInfo {
       float phase,                                                                       \
       NoteProcessInfo &info,                                                             \
       std::array<ProcessingUnit_##INSTRSET, nUnit> &units,                               \
-      GlobalParameter &param);                                                           \
+      GlobalParameter &param,                                                            \
+      const SmootherContext<float> &context);                                            \
     void release(std::array<ProcessingUnit_##INSTRSET, nUnit> &units);                   \
     void release(std::array<ProcessingUnit_##INSTRSET, nUnit> &units, float seconds);    \
     void rest();                                                                         \
@@ -143,6 +198,25 @@ struct NoteProcessInfo {
     float getGain(std::array<ProcessingUnit_##INSTRSET, nUnit> &units);                  \
   };
 
+// Snapshot of parameters for `WaveTable::padsynth`. Taken on audio thread, and read by
+// worker thread.
+struct PadSynthConfig {
+  float sampleRate = 44100.0f;
+  float tableBaseFreq = 20.0f;
+  std::array<float, nOvertone> frequency{};
+  std::array<float, nOvertone> gain{};
+  std::array<float, nOvertone> phase{};
+  std::array<float, nOvertone> bandWidth{};
+  uint32_t seed = 0;
+  float expand = 1.0f;
+  int32_t shift = 0;
+  uint32_t profileSkip = 1;
+  float profileShape = 1.0f;
+  bool randomPitch = false;
+  bool invertSpectrum = false;
+  bool uniformPhaseProfile = false;
+};
+
 class DSPInterface {
 public:
   virtual ~DSPInterface() {};
@@ -157,6 +231,7 @@ public:
   virtual void process(const size_t length, float *out0, float *out1) = 0;
   virtual void noteOn(int32_t noteId, int16_t pitch, float tuning, float velocity) = 0;
   virtual void noteOff(int32_t noteId) = 0;
+  // Asynchronous. Old table is played until the new one is ready.
   virtual void refreshTable() = 0;
   virtual void refreshLfo() = 0;
 
@@ -169,7 +244,7 @@ public:
     float velocity;
   };
 
-  std::vector<MidiNote> midiNotes;
+  NoteQueue<MidiNote> midiNotes;
 
   virtual void pushMidiNote(
     bool isNoteOn,
@@ -213,40 +288,39 @@ public:
       note.pitch = pitch;                                                                \
       note.tuning = tuning;                                                              \
       note.velocity = velocity;                                                          \
-      midiNotes.push_back(note);                                                         \
+      midiNotes.push(note);                                                              \
     }                                                                                    \
                                                                                          \
     void processMidiNote(uint32_t frame) override                                        \
     {                                                                                    \
-      while (true) {                                                                     \
-        auto it                                                                          \
-          = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {   \
-              return nt.frame == frame;                                                  \
-            });                                                                          \
-        if (it == std::end(midiNotes)) return;                                           \
-        if (it->isNoteOn)                                                                \
-          noteOn(it->id, it->pitch, it->tuning, it->velocity);                           \
+      midiNotes.dispatch(frame, [&](MidiNote &nt) {                                      \
+        if (nt.isNoteOn)                                                                 \
+          noteOn(nt.id, nt.pitch, nt.tuning, nt.velocity);                               \
         else                                                                             \
-          noteOff(it->id);                                                               \
-        midiNotes.erase(it);                                                             \
-      }                                                                                  \
+          noteOff(nt.id);                                                                \
+      });                                                                                \
     }                                                                                    \
                                                                                          \
   private:                                                                               \
     void sortVoiceIndicesByGain();                                                       \
     void terminateNotes(size_t nNote);                                                   \
+    void takePadSynthConfig();                                                           \
+    void renderTable(WaveTable<tableSize, nOvertone> &target);                           \
+    void updateTable();                                                                  \
                                                                                          \
     float sampleRate = 44100.0f;                                                         \
                                                                                          \
-    std::array<float, nOvertone> otFrequency{};                                          \
-    std::array<float, nOvertone> otGain{};                                               \
-    std::array<float, nOvertone> otPhase{};                                              \
-    std::array<float, nOvertone> otBandWidth{};                                          \
+    PadSynthConfig padSynthConfig;                                                       \
                                                                                          \
-    bool prepareRefresh = true;                                                          \
     bool isTableRefeshed = false;                                                        \
     bool isLFORefreshed = false;                                                         \
-    WaveTable<tableSize, nOvertone> wavetable;                                           \
+    std::atomic<bool> isTableRefreshPending{false};                                      \
+    bool isTableFading = false;                                                          \
+    float tableFade = 1.0f;                                                              \
+    float tableFadeDelta = 1.0f;                                                         \
+    std::array<WaveTable<tableSize, nOvertone>, 2> wavetableBuffer;                      \
+    WaveTable<tableSize, nOvertone> *wavetable = &wavetableBuffer[0];                    \
+    WaveTable<tableSize, nOvertone> *nextWavetable = &wavetableBuffer[1];                \
     LfoWaveTable<lfoTableSize> lfoWavetable;                                             \
     std::array<ProcessingUnit_##INSTRSET, nUnit> units;                                  \
                                                                                          \
@@ -258,13 +332,24 @@ public:
     std::array<Note_##INSTRSET, maxVoice> notes;                                         \
                                                                                          \
     NoteProcessInfo info;                                                                \
+    SmootherContext<float> smootherContext;                                              \
     LinearSmoother<float> interpMasterGain;                                              \
                                                                                          \
+    /* Per frame values in a sub-block. Table fades on first `nFadingFrame` frames. */   \
+    static constexpr size_t voiceBlockSize = 64;                                         \
+    std::array<NoteProcessFrame, voiceBlockSize> processFrame{};                         \
+    std::array<float, voiceBlockSize> tableFadeFrame{};                                  \
+    size_t nFadingFrame = 0;                                                             \
+    VoiceRenderer<float, 2, voiceBlockSize> voiceRenderer;                               \
+                                                                                         \
     std::vector<std::array<float, 2>> transitionBuffer{};                                \
     bool isTransitioning = false;                                                        \
     size_t trIndex = 0;                                                                  \
     size_t trStop = 0;                                                                   \
     TableOsc<tableSize> trOsc;                                                           \
+                                                                                         \
+    /* Declared last to stop the worker before other members are destructed. */          \
+    BackgroundTask tableTask{[this]() { renderTable(*nextWavetable); }};                 \
   };
 
 PROCESSING_UNIT_CLASS(FixedInstruction)
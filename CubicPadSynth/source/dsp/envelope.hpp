@@ -61,9 +61,10 @@ public:
     float decayTime,
     float sustainLevel,
     float releaseTime,
-    Vec16f noteFreq)
+    Vec16f noteFreq,
+    const SmootherContext<float> &context)
   {
-    sus.push(std::clamp<float>(sustainLevel, 0.0f, 1.0f));
+    sus.push(std::clamp<float>(sustainLevel, 0.0f, 1.0f), context);
     atk = secondToMultiplier(adaptTime(attackTime, noteFreq));
     dec = secondToMultiplier(decayTime);
     rel = secondToMultiplier(adaptTime(releaseTime, noteFreq));
@@ -172,11 +173,12 @@ public:
     float decayTime,
     float sustainLevel,
     float releaseTime,
-    float noteFreq)
+    float noteFreq,
+    const SmootherContext<float> &context)
   {
     state.insert(index, stateAttack);
     value.insert(index, float(1) - value[index]);
-    set(attackTime, decayTime, sustainLevel, releaseTime, noteFreq);
+    set(attackTime, decayTime, sustainLevel, releaseTime, noteFreq, context);
   }
 
   void resetSustain(float sustainLevel)
@@ -192,9 +194,11 @@ public:
     float decayTime,
     float sustainLevel,
     float releaseTime,
-    Vec16f noteFreq)
+    Vec16f noteFreq,
+    const SmootherContext<float> &context)
   {
-    sus.push(std::max<float>(float(0.0), std::min<float>(sustainLevel, float(1.0))));
+    sus.push(
+      std::max<float>(float(0.0), std::min<float>(sustainLevel, float(1.0))), context);
     atk = secondToDelta(adaptTime(attackTime, noteFreq));
     dec = secondToDelta(adaptTime(decayTime, noteFreq));
     rel = secondToDelta(adaptTime(releaseTime, noteFreq));
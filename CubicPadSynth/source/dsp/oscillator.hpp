@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/fftwplancache.hpp"
 #include "../../../lib/fftw3/fftw3.h"
 #include "../../../lib/vcl.hpp"
 
@@ -62,24 +63,19 @@ table is 2d array which has extra padding for interpolation.
 - Padded last 3 row is silence.
 */
 template<size_t tableSize, size_t nPeak> struct WaveTable {
-  // `fftwMutex` is used to lock FFTW3 calls except `fftw*_execute`.
-  static std::mutex fftwMutex;
-
   static constexpr size_t spectrumSize = tableSize / 2 + 1;
   static constexpr size_t paddedSize = tableSize + 3;
   fftwf_complex *spectrum;
   fftwf_complex *bandLimited;
   fftwf_complex *tmpSpec;
   std::array<float *, nTablePadded> table;
-  std::array<fftwf_plan, nTablePadded> plan;
+  fftwf_plan plan; // Shared by all tables. They have the same alignment.
   std::array<float, nTablePadded> frequency; // Must be sorted by ascending order.
   bool isRefreshing = true;
   float tableBaseFreq = 20.0f;
 
   WaveTable()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
-
     spectrum = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex) * spectrumSize);
     bandLimited = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex) * spectrumSize);
     tmpSpec = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex) * spectrumSize);
@@ -89,9 +85,6 @@ template<size_t tableSize, size_t nPeak> struct WaveTable {
       table[idx][0] = 0;
       table[idx][paddedSize - 1] = 0;
 
-      plan[idx]
-        = fftwf_plan_dft_c2r_1d(tableSize, bandLimited, table[idx] + 1, FFTW_ESTIMATE);
-
       // TODO: Experiment with different frequency.
       frequency[idx] = 440.0f * powf(2.0f, (idx - 69.0f) / 12.0f);
     }
@@ -100,13 +93,14 @@ template<size_t tableSize, size_t nPeak> struct WaveTable {
     for (size_t idx = nTablePadded - 3; idx < nTablePadded; ++idx) {
       for (size_t i = 0; i < paddedSize; ++i) table[idx][i] = 0;
     }
+
+    plan = FftwPlanCache::acquire(FftwPlanShape::real(
+      FftwPlanShape::c2r, int(tableSize), bandLimited, table[0] + 1));
   }
 
   ~WaveTable()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
-
-    for (auto &pln : plan) fftwf_destroy_plan(pln);
+    FftwPlanCache::release(plan);
     for (auto &tbl : table) fftwf_free(tbl);
     fftwf_free(tmpSpec);
     fftwf_free(bandLimited);
@@ -129,7 +123,7 @@ template<size_t tableSize, size_t nPeak> struct WaveTable {
     bandLimited[0][1] = 0;
     std::memcpy(
       bandLimited + 1, spectrum + 1, sizeof(fftwf_complex) * (spectrumSize - 1));
-    fftwf_execute(plan[0]);
+    fftwf_execute_dft_c2r(plan, bandLimited, table[0] + 1);
     std::memcpy(table[1], table[0], sizeof(float) * paddedSize);
 
     for (size_t idx = 2; idx <= nTable; ++idx) {
@@ -142,7 +136,7 @@ template<size_t tableSize, size_t nPeak> struct WaveTable {
       std::memset(
         bandLimited + bandIdx, 0, sizeof(fftwf_complex) * (spectrumSize - bandIdx));
 
-      fftwf_execute(plan[idx]);
+      fftwf_execute_dft_c2r(plan, bandLimited, table[idx] + 1);
     }
 
     // Fill padded elements.
@@ -278,9 +272,6 @@ template<size_t tableSize, size_t nPeak> struct WaveTable {
   }
 };
 
-template<size_t tableSize, size_t nPeak>
-std::mutex WaveTable<tableSize, nPeak>::fftwMutex;
-
 template<size_t tableSize> struct TableOsc {
   static constexpr size_t paddedLast = tableSize + 1;
   float phase = 1; // table index starts from 1. 0 is padded index.
@@ -433,7 +424,12 @@ template<size_t tableSize> struct alignas(64) TableOsc16 {
   {
     phase += tick;
     phase = select(phase >= paddedLast, phase - tableSize, phase);
+    return readCubic(notePitch, table);
+  }
 
+  // Reads `table` at current phase without advancing. Used to crossfade 2 tables.
+  Vec16f readCubic(Vec16f notePitch, std::array<float *, nTablePadded> &table)
+  {
     notePitch = select(notePitch <= 0, 0, notePitch);
     notePitch += float(1);
     notePitch = select(notePitch >= notePitchUpperBound, notePitchUpperBound, notePitch);
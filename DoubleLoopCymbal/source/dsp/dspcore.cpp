@@ -62,7 +62,7 @@ void DSPCore::setup(double sampleRate)
   this->sampleRate = sampleRate;
   upRate = sampleRate * upFold;
 
-  SmootherCommon<double>::setTime(double(0.2));
+  smootherContext.setTime(double(0.2));
   baseSampleRateKp = EMAFilter<double>::secondToP(sampleRate, double(0.2));
 
   releaseSmoother.setup(double(2) * upRate);
@@ -141,7 +141,7 @@ void DSPCore::setup(double sampleRate)
 void DSPCore::updateUpRate()
 {
   upRate = sampleRate * fold[overSampling];
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
   spreader.updateBaseTime(spreaderMaxTimeSecond * upRate);
 }
 
@@ -172,7 +172,7 @@ void DSPCore::updateDelayTime()
 
 void DSPCore::reset()
 {
-  midiNotes.resize(0);
+  midiNotes.clear();
   noteStack.resize(0);
 
   overSampling = param.value[ParameterID::ID::overSampling]->getInt();
@@ -238,24 +238,24 @@ double DSPCore::processFrame(const std::array<double, 2> &externalInput)
 
   const auto envRelease = envelopeRelease.process();
 
-  const auto extGain = externalInputGain.process();
-  const auto imTexture = impactTextureMix.process();
-  const auto imCutoff = impactHighpassCutoff.process();
+  const auto extGain = externalInputGain.process(smootherContext);
+  const auto imTexture = impactTextureMix.process(smootherContext);
+  const auto imCutoff = impactHighpassCutoff.process(smootherContext);
   const auto hcGain
-    = halfClosedGain.process() * envelopeHalfClosed.process(halfClosedSustain.process());
-  const auto hcDensity = halfClosedDensityScaler * halfClosedDensity.process();
-  const auto hcCutoff = halfClosedHighpassCutoff.process();
-  const auto clCutoff = closingHighpassCutoff.process();
-  const auto timeModAmt = delayTimeModOffset + delayTimeModAmount.process();
-  const auto apGain1 = allpassFeed1.process();
-  const auto apGain2 = allpassFeed2.process();
-  const auto apMixSpike = allpassMixSpike.process();
-  const auto apMixSign = allpassMixAltSign.process();
-  const auto hsCut = highShelfCutoff.process();
-  const auto hsGain = highShelfGain.process();
-  const auto lsCut = lowShelfCutoff.process();
-  const auto lsGain = lowShelfGain.process();
-  const auto outGain = outputGain.process() * envRelease;
+    = halfClosedGain.process(smootherContext) * envelopeHalfClosed.process(halfClosedSustain.process(smootherContext));
+  const auto hcDensity = halfClosedDensityScaler * halfClosedDensity.process(smootherContext);
+  const auto hcCutoff = halfClosedHighpassCutoff.process(smootherContext);
+  const auto clCutoff = closingHighpassCutoff.process(smootherContext);
+  const auto timeModAmt = delayTimeModOffset + delayTimeModAmount.process(smootherContext);
+  const auto apGain1 = allpassFeed1.process(smootherContext);
+  const auto apGain2 = allpassFeed2.process(smootherContext);
+  const auto apMixSpike = allpassMixSpike.process(smootherContext);
+  const auto apMixSign = allpassMixAltSign.process(smootherContext);
+  const auto hsCut = highShelfCutoff.process(smootherContext);
+  const auto hsGain = highShelfGain.process(smootherContext);
+  const auto lsCut = lowShelfCutoff.process(smootherContext);
+  const auto lsGain = lowShelfGain.process(smootherContext);
+  const auto outGain = outputGain.process(smootherContext) * envRelease;
 
   auto noiseEnv = releaseSmoother.process() + envelopeNoise.process();
 
@@ -313,8 +313,8 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setBufferSize(double(length));
+  smootherContext.setSampleRate(upRate);
 
   double frame = 0;
   for (size_t i = 0; i < length; ++i) {
@@ -195,16 +195,29 @@ template<typename Sample> std::array<Sample, 2> NOTE_NAME<Sample>::process()
   return frame;
 }
 
+// Returns the number of rendered frames. Rendering stops when the note is rested.
+template<typename Sample>
+size_t NOTE_NAME<Sample>::process(size_t length, Sample *out0, Sample *out1)
+{
+  for (size_t i = 0; i < length; ++i) {
+    if (state == NoteState::rest) return i;
+    const auto frame = process();
+    out0[i] = frame[0];
+    out1[i] = frame[1];
+  }
+  return length;
+}
+
 DSPCORE_NAME::DSPCORE_NAME() { midiNotes.reserve(128); }
 
 void DSPCORE_NAME::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  midiNotes.resize(0);
+  midiNotes.clear();
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.04f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.04f);
 
   interpPhaserPhase.setRange(float(twopi));
 
@@ -241,23 +254,24 @@ void DSPCORE_NAME::setParameters()
 {
   using ID = ParameterID::ID;
 
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
+  const auto &sc = smootherContext;
 
   interpMasterGain.push(
-    param.value[ID::gain]->getFloat() * param.value[ID::gainBoost]->getFloat());
+    param.value[ID::gain]->getFloat() * param.value[ID::gainBoost]->getFloat(), sc);
 
-  interpPhaserMix.push(param.value[ID::phaserMix]->getFloat());
+  interpPhaserMix.push(param.value[ID::phaserMix]->getFloat(), sc);
   interpPhaserFrequency.push(
-    param.value[ID::phaserFrequency]->getFloat() * float(twopi) / sampleRate);
-  interpPhaserFeedback.push(param.value[ID::phaserFeedback]->getFloat());
+    param.value[ID::phaserFrequency]->getFloat() * float(twopi) / sampleRate, sc);
+  interpPhaserFeedback.push(param.value[ID::phaserFeedback]->getFloat(), sc);
 
   const float phaserRange = param.value[ID::phaserRange]->getFloat();
-  interpPhaserRange.push(phaserRange);
+  interpPhaserRange.push(phaserRange, sc);
   interpPhaserMin.push(
-    Thiran2Phaser16::getOffset(phaserRange, param.value[ID::phaserMin]->getFloat()));
+    Thiran2Phaser16::getOffset(phaserRange, param.value[ID::phaserMin]->getFloat()), sc);
 
-  interpPhaserPhase.push(param.value[ID::phaserPhase]->getFloat());
-  interpPhaserOffset.push(param.value[ID::phaserOffset]->getFloat());
+  interpPhaserPhase.push(param.value[ID::phaserPhase]->getFloat(), sc);
+  interpPhaserOffset.push(param.value[ID::phaserOffset]->getFloat(), sc);
 
   auto phaserStage = param.value[ID::phaserStage]->getInt();
   phaser[0].setStage(phaserStage);
@@ -271,47 +285,54 @@ void DSPCORE_NAME::process(const size_t length, float *out0, float *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
-
-  std::array<float, 2> frame{};
-  for (uint32_t i = 0; i < length; ++i) {
-    processMidiNote(i);
-
-    frame.fill(0.0f);
-
-    for (auto &note : notes) {
-      if (note.state == NoteState::rest) continue;
-      auto noteOut = note.process();
-      frame[0] += noteOut[0];
-      frame[1] += noteOut[1];
-    }
+  smootherContext.setBufferSize(float(length));
+
+  auto onNote = [&](MidiNote &nt) {
+    if (nt.isNoteOn)
+      noteOn(nt.id, nt.pitch, nt.tuning, nt.velocity);
+    else
+      noteOff(nt.id);
+  };
+
+  auto renderVoice = [&](auto &note, size_t frames, auto &buffer) {
+    return note.process(frames, buffer[0].data(), buffer[1].data());
+  };
+
+  auto onBlock = [&](size_t offset, size_t frames, const auto &mix) {
+    std::array<float, 2> frame{};
+    for (size_t j = 0; j < frames; ++j) {
+      frame[0] = mix[0][j];
+      frame[1] = mix[1][j];
+
+      if (isTransitioning) {
+        frame[0] += transitionBuffer[trIndex][0];
+        frame[1] += transitionBuffer[trIndex][1];
+        transitionBuffer[trIndex].fill(0.0f);
+        trIndex = (trIndex + 1) % transitionBuffer.size();
+        if (trIndex == trStop) isTransitioning = false;
+      }
 
-    if (isTransitioning) {
-      frame[0] += transitionBuffer[trIndex][0];
-      frame[1] += transitionBuffer[trIndex][1];
-      transitionBuffer[trIndex].fill(0.0f);
-      trIndex = (trIndex + 1) % transitionBuffer.size();
-      if (trIndex == trStop) isTransitioning = false;
+      const auto phaserFreq = interpPhaserFrequency.process();
+      const auto phaserFeedback = interpPhaserFeedback.process();
+      const auto phaserRange = interpPhaserRange.process();
+      const auto phaserMin = interpPhaserMin.process();
+      const auto phaserPhase = interpPhaserPhase.process();
+      const auto phaserOffset = interpPhaserOffset.process();
+      phaser[0].setup(phaserPhase, phaserFreq, phaserFeedback, phaserRange, phaserMin);
+      phaser[1].setup(
+        phaserPhase + phaserOffset, phaserFreq, phaserFeedback, phaserRange, phaserMin);
+
+      const auto phaserMix = interpPhaserMix.process();
+      frame[0] += phaserMix * (phaser[0].process(frame[0]) - frame[0]);
+      frame[1] += phaserMix * (phaser[1].process(frame[1]) - frame[1]);
+
+      const auto masterGain = interpMasterGain.process();
+      out0[offset + j] = masterGain * frame[0];
+      out1[offset + j] = masterGain * frame[1];
     }
+  };
 
-    const auto phaserFreq = interpPhaserFrequency.process();
-    const auto phaserFeedback = interpPhaserFeedback.process();
-    const auto phaserRange = interpPhaserRange.process();
-    const auto phaserMin = interpPhaserMin.process();
-    const auto phaserPhase = interpPhaserPhase.process();
-    const auto phaserOffset = interpPhaserOffset.process();
-    phaser[0].setup(phaserPhase, phaserFreq, phaserFeedback, phaserRange, phaserMin);
-    phaser[1].setup(
-      phaserPhase + phaserOffset, phaserFreq, phaserFeedback, phaserRange, phaserMin);
-
-    const auto phaserMix = interpPhaserMix.process();
-    frame[0] += phaserMix * (phaser[0].process(frame[0]) - frame[0]);
-    frame[1] += phaserMix * (phaser[1].process(frame[1]) - frame[1]);
-
-    const auto masterGain = interpMasterGain.process();
-    out0[i] = masterGain * frame[0];
-    out1[i] = masterGain * frame[1];
-  }
+  voiceRenderer.process(length, midiNotes, notes, onNote, renderVoice, onBlock);
 }
 
 void DSPCORE_NAME::noteOn(int32_t identifier, int16_t pitch, float tuning, float velocity)
@@ -16,8 +16,8 @@ void DSPCORE_NAME::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.04f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.04f);
 
   interpPhase.setRange(float(twopi));
 
@@ -27,28 +27,32 @@ void DSPCORE_NAME::setup(double sampleRate)
 }
 
 #define ASSIGN_PARAMETER(METHOD)                                                         \
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());               \
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());                      \
                                                                                          \
-  interpMix.METHOD(param.value[ID::mix]->getFloat());                                    \
-  interpFrequency.METHOD(                                                                \
+  METHOD(interpMix, param.value[ID::mix]->getFloat());                                   \
+  METHOD(                                                                                \
+    interpFrequency,                                                                     \
     param.value[ID::frequency]->getFloat() * float(twopi) / sampleRate);                 \
-  interpFreqSpread.METHOD(param.value[ID::freqSpread]->getFloat());                      \
-  interpFeedback.METHOD(param.value[ID::feedback]->getFloat());                          \
+  METHOD(interpFreqSpread, param.value[ID::freqSpread]->getFloat());                     \
+  METHOD(interpFeedback, param.value[ID::feedback]->getFloat());                         \
                                                                                          \
   const float phaserRange = param.value[ID::range]->getFloat();                          \
-  interpRange.METHOD(phaserRange);                                                       \
-  interpMin.METHOD(                                                                      \
-    Thiran2Phaser::getLfoMin(phaserRange, param.value[ID::min]->getFloat()));            \
+  METHOD(interpRange, phaserRange);                                                      \
+  METHOD(                                                                                \
+    interpMin, Thiran2Phaser::getLfoMin(phaserRange, param.value[ID::min]->getFloat())); \
                                                                                          \
-  interpPhase.METHOD(param.value[ID::phase]->getFloat());                                \
-  interpStereoOffset.METHOD(param.value[ID::stereoOffset]->getFloat());                  \
-  interpCascadeOffset.METHOD(param.value[ID::cascadeOffset]->getFloat());
+  METHOD(interpPhase, param.value[ID::phase]->getFloat());                               \
+  METHOD(interpStereoOffset, param.value[ID::stereoOffset]->getFloat());                 \
+  METHOD(interpCascadeOffset, param.value[ID::cascadeOffset]->getFloat());
+
+#define RESET_PARAMETER(SMOOTHER, VALUE) SMOOTHER.reset(VALUE)
+#define PUSH_PARAMETER(SMOOTHER, VALUE) SMOOTHER.push(VALUE, smootherContext)
 
 void DSPCORE_NAME::reset()
 {
   using ID = ParameterID::ID;
 
-  ASSIGN_PARAMETER(reset);
+  ASSIGN_PARAMETER(RESET_PARAMETER);
 
   auto phaserStage = param.value[ID::stage]->getInt();
   for (auto &ph : phaser) ph.reset(phaserStage);
@@ -66,7 +70,7 @@ void DSPCORE_NAME::setParameters()
 {
   using ID = ParameterID::ID;
 
-  ASSIGN_PARAMETER(push);
+  ASSIGN_PARAMETER(PUSH_PARAMETER);
 
   auto phaserStage = param.value[ID::stage]->getInt();
   phaser[0].setStage(phaserStage);
@@ -79,7 +83,7 @@ void DSPCORE_NAME::process(
   ScopedNoDenormals scopedDenormals;
 
   auto len_f = float(length);
-  SmootherCommon<float>::setBufferSize(float(len_f));
+  smootherContext.setBufferSize(float(len_f));
   phaser[0].interpStage.setBufferSize(float(len_f));
   phaser[1].interpStage.setBufferSize(float(len_f));
 
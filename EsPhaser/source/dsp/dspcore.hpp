@@ -49,6 +49,7 @@ public:
                                                                                          \
     std::array<Thiran2Phaser, 2> phaser;                                                 \
                                                                                          \
+    SmootherContext<float> smootherContext;                                              \
     LinearSmoother<float> interpMix;                                                     \
     LinearSmoother<float> interpFrequency;                                               \
     LinearSmoother<float> interpFreqSpread;                                              \
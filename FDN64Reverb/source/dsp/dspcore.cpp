@@ -21,8 +21,8 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
 
   for (size_t idx = 0; idx < nDelay; ++idx) {
     lowpassLfoTime[0][idx].setCutoff(sampleRate, 1.0f);
@@ -31,7 +31,7 @@ void DSPCore::setup(double sampleRate)
 
   gate.setup(sampleRate, 0.001f);
 
-  for (auto &fdn : feedbackDelayNetwork) fdn.setup(sampleRate, 1.0f);
+  feedbackDelayNetwork.setup(sampleRate, 1.0f);
 
   reset();
   startup();
@@ -43,30 +43,28 @@ size_t DSPCore::getLatency() { return 0; }
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  for (auto &fdn : feedbackDelayNetwork) {                                               \
-    fdn.rate = pv[ID::delayTimeInterpRate]->getFloat();                                  \
-  }                                                                                      \
+  feedbackDelayNetwork.rate = pv[ID::delayTimeInterpRate]->getFloat();                   \
                                                                                          \
   auto timeMul = pv[ID::timeMultiplier]->getFloat() * notePitchMultiplier;               \
   for (size_t idx = 0; idx < nDelay; ++idx) {                                            \
     auto time = timeMul * sampleRate * pv[ID::delayTime0 + idx]->getFloat();             \
     auto timeLfo = sampleRate * pv[ID::timeLfoAmount0 + idx]->getFloat();                \
                                                                                          \
-    feedbackDelayNetwork[0].delayTimeSample[idx].METHOD(                                 \
-      time + timeLfo * lowpassLfoTime[0][idx].value);                                    \
-    feedbackDelayNetwork[1].delayTimeSample[idx].METHOD(                                 \
-      time + timeLfo * lowpassLfoTime[1][idx].value);                                    \
+    feedbackDelayNetwork.delayTimeSample.METHOD##At(                                     \
+      0, idx, time + timeLfo * lowpassLfoTime[0][idx].value);                            \
+    feedbackDelayNetwork.delayTimeSample.METHOD##At(                                     \
+      1, idx, time + timeLfo * lowpassLfoTime[1][idx].value);                            \
                                                                                          \
     auto &&lowpassCutoffHz = pv[ID::lowpassCutoffHz0 + idx]->getFloat();                 \
-    interpLowpassCutoff[idx].METHOD(                                                     \
+    interpLowpassCutoff.METHOD##At(                                                      \
+      idx,                                                                               \
       lowpassCutoffHz >= Scales::lowpassCutoffHz.getMax()                                \
         ? 1.0f                                                                           \
         : float(EMAFilter<double>::cutoffToP(sampleRate, lowpassCutoffHz)));             \
     auto &&highpassCutoffHz = pv[ID::highpassCutoffHz0 + idx]->getFloat();               \
-    interpHighpassCutoff[idx].METHOD(                                                    \
-      float(EMAFilter<double>::cutoffToP(sampleRate, highpassCutoffHz)));                \
+    interpHighpassCutoff.METHOD##At(                                                     \
+      idx, float(EMAFilter<double>::cutoffToP(sampleRate, highpassCutoffHz)));           \
   }                                                                                      \
-  interpSplitPhaseOffset.METHOD(pv[ID::splitPhaseOffset]->getFloat());                   \
   interpSplitSkew.METHOD(std::pow(2.0f, pv[ID::splitSkew]->getFloat()) - 1.0f);          \
   interpStereoCross.METHOD(pv[ID::stereoCross]->getFloat());                             \
   interpFeedback.METHOD(pv[ID::feedback]->getFloat());                                   \
@@ -90,10 +88,11 @@ void DSPCore::reset()
   }
 
   ASSIGN_PARAMETER(reset);
+  interpSplitPhaseOffset.reset(pv[ID::splitPhaseOffset]->getFloat());
 
   crossBuffer.fill(0);
   gate.reset();
-  for (auto &fdn : feedbackDelayNetwork) fdn.reset();
+  feedbackDelayNetwork.reset();
   startup();
 }
 
@@ -107,10 +106,16 @@ void DSPCore::setParameters()
     lowpassLfoTime[1][idx].process(timeLfoDist(rng));
   }
 
+  pushParameters();
+}
+
+void DSPCore::pushParameters()
+{
   ASSIGN_PARAMETER(push);
+  interpSplitPhaseOffset.push(pv[ID::splitPhaseOffset]->getFloat(), smootherContext);
 
   auto &&splitRotationHz = pv[ID::splitRotationHz]->getFloat();
-  for (auto &fdn : feedbackDelayNetwork) fdn.prepare(sampleRate, splitRotationHz);
+  feedbackDelayNetwork.prepare(sampleRate, splitRotationHz);
 
   unsigned seed = pv[ID::seed]->getInt();
   unsigned matrixType = pv[ID::matrixType]->getInt();
@@ -124,8 +129,8 @@ void DSPCore::setParameters()
     pcg64 matrixRng{seed};
     std::uniform_int_distribution<unsigned> seedDist{
       0, std::numeric_limits<unsigned>::max()};
-    feedbackDelayNetwork[0].randomizeMatrix(matrixType, seedDist(matrixRng));
-    feedbackDelayNetwork[1].randomizeMatrix(matrixType, seedDist(matrixRng));
+    feedbackDelayNetwork.randomizeMatrix(0, matrixType, seedDist(matrixRng));
+    feedbackDelayNetwork.randomizeMatrix(1, matrixType, seedDist(matrixRng));
   }
   isMatrixRefeshed = pv[ID::refreshMatrix]->getInt();
   prepareRefresh = false;
@@ -136,37 +141,70 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
+
+  // Parameters are only pushed in `setParameters`, so this holds for the whole block.
+  const auto &sc = smootherContext;
+  const bool isSettled = interpLowpassCutoff.isSettled(sc)
+    && interpHighpassCutoff.isSettled(sc) && interpSplitPhaseOffset.isSettled()
+    && interpSplitSkew.isSettled(sc) && interpStereoCross.isSettled(sc)
+    && interpFeedback.isSettled(sc) && interpDry.isSettled(sc) && interpWet.isSettled(sc);
+
+  midiNotes.splitBlock(
+    length,
+    [&](NoteInfo &nt) {
+      if (nt.isNoteOn)
+        noteOn(nt);
+      else
+        noteOff(nt.id);
+    },
+    [&](size_t begin, size_t end) {
+      if (isSettled)
+        processFrames<true>(begin, end, in0, in1, out0, out1);
+      else
+        processFrames<false>(begin, end, in0, in1, out0, out1);
+    });
+}
 
-  for (size_t i = 0; i < length; ++i) {
-    processMidiNote(i);
+/**
+When `isSettled` is true, smoothers are not updated in the loop. Their values are the same
+as calling `process`, because settled smoothers don't change.
+*/
+template<bool isSettled>
+void DSPCore::processFrames(
+  size_t begin, size_t end, const float *in0, const float *in1, float *out0, float *out1)
+{
+  auto &fdn = feedbackDelayNetwork;
+  if constexpr (isSettled) {
+    std::copy_n(interpLowpassCutoff.value.begin(), nDelay, fdn.lowpassKp.begin());
+    std::copy_n(interpHighpassCutoff.value.begin(), nDelay, fdn.highpassKp.begin());
+  }
 
-    for (size_t idx = 0; idx < nDelay; ++idx) {
-      auto lowpassCutoff = interpLowpassCutoff[idx].process();
-      auto highpassCutoff = interpHighpassCutoff[idx].process();
-      for (auto &fdn : feedbackDelayNetwork) {
-        fdn.lowpassKp[idx] = lowpassCutoff;
-        fdn.highpassKp[idx] = highpassCutoff;
-      }
+  for (size_t i = begin; i < end; ++i) {
+    if constexpr (!isSettled) {
+      interpLowpassCutoff.process(smootherContext);
+      interpHighpassCutoff.process(smootherContext);
+      std::copy_n(interpLowpassCutoff.value.begin(), nDelay, fdn.lowpassKp.begin());
+      std::copy_n(interpHighpassCutoff.value.begin(), nDelay, fdn.highpassKp.begin());
+
+      interpSplitPhaseOffset.process();
+      interpSplitSkew.process(smootherContext);
+      interpStereoCross.process(smootherContext);
+      interpFeedback.process(smootherContext);
+      interpDry.process(smootherContext);
+      interpWet.process(smootherContext);
     }
 
-    auto splitPhaseOffset = interpSplitPhaseOffset.process();
-    auto splitSkew = interpSplitSkew.process();
-    auto stereoCross = interpStereoCross.process();
-    auto feedback = interpFeedback.process();
-
+    auto stereoCross = interpStereoCross.getValue();
     auto gateOut = gate.process(std::max(std::fabs(in0[i]), std::fabs(in1[i])));
     stereoCross = std::min(1.0f, stereoCross + (1.0f - stereoCross) * gateOut);
 
-    auto fdnBuf0 = feedbackDelayNetwork[0].preProcess(splitPhaseOffset, splitSkew);
-    auto fdnBuf1 = feedbackDelayNetwork[1].preProcess(splitPhaseOffset, splitSkew);
-    crossBuffer[0]
-      = feedbackDelayNetwork[0].process(in0[i], fdnBuf1, stereoCross, feedback);
-    crossBuffer[1]
-      = feedbackDelayNetwork[1].process(in1[i], fdnBuf0, stereoCross, feedback);
+    crossBuffer = fdn.process(
+      {in0[i], in1[i]}, interpSplitPhaseOffset.getValue(), interpSplitSkew.getValue(),
+      stereoCross, interpFeedback.getValue());
 
-    auto dry = interpDry.process();
-    auto wet = interpWet.process();
+    const auto dry = interpDry.getValue();
+    const auto wet = interpWet.getValue();
     out0[i] = dry * in0[i] + wet * crossBuffer[0];
     out1[i] = dry * in1[i] + wet * crossBuffer[1];
   }
@@ -206,9 +244,9 @@ void DSPCore::updateDelayTime()
     auto time = timeMul * sampleRate * pv[ID::delayTime0 + idx]->getFloat();
     auto timeLfo = sampleRate * pv[ID::timeLfoAmount0 + idx]->getFloat();
 
-    feedbackDelayNetwork[0].delayTimeSample[idx].push(
-      time + timeLfo * lowpassLfoTime[0][idx].value);
-    feedbackDelayNetwork[1].delayTimeSample[idx].push(
-      time + timeLfo * lowpassLfoTime[1][idx].value);
+    feedbackDelayNetwork.delayTimeSample.pushAt(
+      0, idx, time + timeLfo * lowpassLfoTime[0][idx].value);
+    feedbackDelayNetwork.delayTimeSample.pushAt(
+      1, idx, time + timeLfo * lowpassLfoTime[1][idx].value);
   }
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/notequeue.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "fdnreverb.hpp"
@@ -35,7 +36,14 @@ public:
   void reset();
   void startup();
   size_t getLatency();
+
+  // Advances delay time LFO, then calls `pushParameters`. Call once per host block.
   void setParameters();
+
+  // Only pushes parameters. Called on automation points inside a host block, so that the
+  // LFO doesn't depend on how a block is split.
+  void pushParameters();
+
   void process(
     const size_t length, const float *in0, const float *in1, float *out0, float *out1);
   void noteOn(NoteInfo &info);
@@ -55,28 +63,21 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
-  }
-
-  void processMidiNote(size_t frame)
-  {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
-      else
-        noteOff(it->id);
-      midiNotes.erase(it);
-    }
+    midiNotes.push(note);
   }
 
 private:
+  template<bool isSettled>
+  void processFrames(
+    size_t begin,
+    size_t end,
+    const float *in0,
+    const float *in1,
+    float *out0,
+    float *out1);
   void updateDelayTime();
 
-  std::vector<NoteInfo> midiNotes;
+  NoteQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
   float notePitchMultiplier = float(1);
 
@@ -91,8 +92,9 @@ private:
 
   std::array<std::array<EMAFilter<float>, nDelay>, 2> lowpassLfoTime;
 
-  std::array<ExpSmoother<float>, nDelay> interpLowpassCutoff;
-  std::array<ExpSmoother<float>, nDelay> interpHighpassCutoff;
+  SmootherContext<float> smootherContext;
+  SmootherBank<float, nDelay> interpLowpassCutoff;
+  SmootherBank<float, nDelay> interpHighpassCutoff;
   RotarySmoother<float> interpSplitPhaseOffset;
   ExpSmoother<float> interpSplitSkew;
   ExpSmoother<float> interpStereoCross;
@@ -101,5 +103,5 @@ private:
   ExpSmoother<float> interpWet;
 
   EasyGate<float> gate;
-  std::array<FeedbackDelayNetwork<float, nDelay>, 2> feedbackDelayNetwork;
+  FeedbackDelayNetwork<float, nDelay> feedbackDelayNetwork;
 };
@@ -6,6 +6,7 @@
 #include "../../../common/dsp/constants.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../../../lib/pcg-cpp/pcg_random.hpp"
+#include "matrixmixer.hpp"
 #include "matrixtype.hpp"
 
 #include <algorithm>
@@ -13,6 +14,7 @@
 #include <numeric>
 #include <random>
 #include <set>
+#include <vector>
 
 namespace SomeDSP {
 
@@ -37,55 +39,140 @@ public:
   }
 };
 
-template<typename Sample> class EMAHighpass {
+template<typename Sample, size_t nChannel, size_t length>
+class ParallelDoubleEMAFilterKp {
 private:
-  Sample v1 = 0;
+  std::array<std::array<Sample, length>, nChannel> v1{};
+  std::array<std::array<Sample, length>, nChannel> v2{};
 
 public:
-  void reset(Sample value = 0) { v1 = value; }
+  void reset()
+  {
+    v1.fill({});
+    v2.fill({});
+  }
 
-  Sample process(Sample input, Sample kp)
+  void process(
+    std::array<std::array<Sample, length>, nChannel> &v0,
+    const std::array<Sample, length> &kp)
   {
-    v1 += kp * (input - v1);
-    return input - v1;
+    for (size_t ch = 0; ch < nChannel; ++ch) {
+      for (size_t idx = 0; idx < length; ++idx) {
+        v1[ch][idx] += kp[idx] * (v0[ch][idx] - v1[ch][idx]);
+        v2[ch][idx] += kp[idx] * (v1[ch][idx] - v2[ch][idx]);
+        v0[ch][idx] = v2[ch][idx];
+      }
+    }
   }
 };
 
-template<typename Sample> class Delay {
+template<typename Sample, size_t nChannel, size_t length> class ParallelEMAHighpass {
+private:
+  std::array<std::array<Sample, length>, nChannel> v1{};
+
 public:
-  int wptr = 0;
-  std::vector<Sample> buf;
+  void reset() { v1.fill({}); }
 
-  void setup(Sample sampleRate, Sample maxTime)
+  void process(
+    std::array<std::array<Sample, length>, nChannel> &input,
+    const std::array<Sample, length> &kp)
   {
-    auto &&size = size_t(sampleRate * maxTime) + 2;
-    buf.resize(size < 4 ? 4 : size);
+    for (size_t ch = 0; ch < nChannel; ++ch) {
+      for (size_t idx = 0; idx < length; ++idx) {
+        v1[ch][idx] += kp[idx] * (input[ch][idx] - v1[ch][idx]);
+        input[ch][idx] -= v1[ch][idx];
+      }
+    }
+  }
+};
 
-    reset();
+template<typename Sample, size_t nChannel, size_t length> class ParallelRateLimiter {
+public:
+  std::array<std::array<Sample, length>, nChannel> value{};
+  std::array<std::array<Sample, length>, nChannel> target{};
+
+  inline void resetAt(size_t channel, size_t index, Sample resetValue = 0)
+  {
+    value[channel][index] = resetValue;
+    target[channel][index] = resetValue;
   }
 
-  void reset() { std::fill(buf.begin(), buf.end(), Sample(0)); }
+  inline void pushAt(size_t channel, size_t index, Sample newTarget)
+  {
+    target[channel][index] = newTarget;
+  }
+
+  void process(Sample rate)
+  {
+    for (size_t ch = 0; ch < nChannel; ++ch) {
+      for (size_t idx = 0; idx < length; ++idx) {
+        auto &&val = value[ch][idx];
+        auto &&tgt = target[ch][idx];
+        auto diff = tgt - val;
+        val = diff > rate ? val + rate : diff < -rate ? val - rate : tgt;
+      }
+    }
+  }
+};
+
+/**
+All lines share the same buffer size and write pointer. Buffer is lane major, that is
+`buf[(channel * length + index) * size + frame]`. Reads are gathered from each lane.
+*/
+template<typename Sample, size_t nChannel, size_t length> class ParallelDelay {
+private:
+  static constexpr size_t nLane = nChannel * length;
+
+  int size = 4;
+  int wptr = 0;
+  std::vector<Sample> buf = std::vector<Sample>(nLane * 4);
 
-  Sample process(Sample input, Sample timeInSample)
+public:
+  void setup(Sample sampleRate, Sample maxTime)
   {
-    const int bufSize = buf.size();
+    auto &&frames = size_t(sampleRate * maxTime) + 2;
+    size = int(frames < 4 ? 4 : frames);
+    buf.resize(nLane * size_t(size));
 
-    // Set delay time.
-    Sample clamped = std::clamp(timeInSample, Sample(0), Sample(bufSize - 1));
-    int timeInt = int(clamped);
-    Sample rFraction = clamped - Sample(timeInt);
+    reset();
+  }
 
-    int rptr0 = wptr - timeInt;
-    int rptr1 = rptr0 - 1;
-    if (rptr0 < 0) rptr0 += bufSize; // Unsigned negative overflow case.
-    if (rptr1 < 0) rptr1 += bufSize; // Unsigned negative overflow case.
+  void reset()
+  {
+    std::fill(buf.begin(), buf.end(), Sample(0));
+    wptr = 0;
+  }
 
+  void process(
+    std::array<std::array<Sample, length>, nChannel> &io,
+    const std::array<std::array<Sample, length>, nChannel> &timeInSample)
+  {
     // Write to buffer.
-    buf[wptr] = input;
-    if (++wptr >= bufSize) wptr = 0;
+    for (size_t ch = 0; ch < nChannel; ++ch) {
+      Sample *lane = buf.data() + ch * length * size_t(size) + wptr;
+      for (size_t idx = 0; idx < length; ++idx) lane[idx * size_t(size)] = io[ch][idx];
+    }
 
     // Read from buffer.
-    return buf[rptr0] + rFraction * (buf[rptr1] - buf[rptr0]);
+    const Sample maxTime = Sample(size - 1);
+    for (size_t ch = 0; ch < nChannel; ++ch) {
+      const Sample *lane = buf.data() + ch * length * size_t(size);
+      for (size_t idx = 0; idx < length; ++idx) {
+        Sample clamped = std::clamp(timeInSample[ch][idx], Sample(0), maxTime);
+        int timeInt = int(clamped);
+        Sample rFraction = clamped - Sample(timeInt);
+
+        int rptr0 = wptr - timeInt;
+        int rptr1 = rptr0 - 1;
+        if (rptr0 < 0) rptr0 += size; // Unsigned negative overflow case.
+        if (rptr1 < 0) rptr1 += size; // Unsigned negative overflow case.
+
+        const Sample *bf = lane + idx * size_t(size);
+        io[ch][idx] = bf[rptr0] + rFraction * (bf[rptr1] - bf[rptr0]);
+      }
+    }
+
+    if (++wptr >= size) wptr = 0;
   }
 };
 
@@ -268,24 +355,110 @@ public:
 };
 
 /**
+Generates normalized split gain `exp(skew * sin(2 * pi * (phase + idx / length)))`.
+
+Gain is computed once in every `interval` samples, and linearly interpolated in between.
+Interpolation keeps the sum of gain at 1. `sin(2 * pi * (phase + idx / length))` is
+computed from angle addition, so transcendental calls per update are `length + 2`.
+*/
+template<typename Sample, size_t length> class SplitGainGenerator {
+private:
+  std::array<Sample, length> target{};
+  std::array<Sample, length> delta{};
+  std::array<Sample, length> cosOffset{};
+  std::array<Sample, length> sinOffset{};
+  size_t counter = 0;
+  bool isInitialized = false;
+
+public:
+  static constexpr size_t interval = 32;
+
+  std::array<Sample, length> value{};
+
+  SplitGainGenerator()
+  {
+    for (size_t idx = 0; idx < length; ++idx) {
+      auto theta = double(twopi) * double(idx) / double(length);
+      cosOffset[idx] = Sample(std::cos(theta));
+      sinOffset[idx] = Sample(std::sin(theta));
+    }
+  }
+
+  void reset()
+  {
+    counter = 0;
+    isInitialized = false;
+  }
+
+  /**
+  `phase` is normalized phase in [0, 1].
+  `skew` >= 0.
+  */
+  void compute(Sample phase, Sample skew, std::array<Sample, length> &dest)
+  {
+    auto theta = Sample(twopi) * phase;
+    auto s = std::sin(theta);
+    auto c = std::cos(theta);
+    Sample sum = 0;
+    for (size_t idx = 0; idx < length; ++idx) {
+      dest[idx] = std::exp(skew * (s * cosOffset[idx] + c * sinOffset[idx]));
+      sum += dest[idx];
+    }
+    auto inv = Sample(1) / sum;
+    for (auto &x : dest) x *= inv;
+  }
+
+  void process(Sample phase, Sample skew)
+  {
+    if (counter == 0) {
+      counter = interval;
+      if (!isInitialized) {
+        isInitialized = true;
+        compute(phase, skew, value);
+        target = value;
+        delta.fill(0);
+        return;
+      }
+      value = target;
+      compute(phase, skew, target);
+      for (size_t idx = 0; idx < length; ++idx) {
+        delta[idx] = (target[idx] - value[idx]) / Sample(interval);
+      }
+    }
+    --counter;
+    for (size_t idx = 0; idx < length; ++idx) value[idx] += delta[idx];
+  }
+};
+
+/**
+Stereo FDN. Each channel has its own feedback matrix, and both channels are cross mixed.
+
+States are stored as struct of arrays indexed by `[channel][line]`, so that each pass
+(rate limiter, delay, lowpass, highpass) runs over `nChannel * length` lanes.
+
 If `length` is too long, compiler might silently fail to allocate stack.
 */
 template<typename Sample, size_t length> class FeedbackDelayNetwork {
-private:
-  std::array<std::array<Sample, length>, length> matrix{};
-  std::array<std::array<Sample, length>, 2> buf{};
-  std::array<Delay<Sample>, length> delay;
-  std::array<DoubleEMAFilterKp<Sample>, length> lowpass;
-  std::array<EMAHighpass<Sample>, length> highpass;
+public:
+  static constexpr size_t nChannel = 2;
+  using Lanes = std::array<std::array<Sample, length>, nChannel>;
 
-  std::array<Sample, length> splitGain{};
+private:
+  std::array<std::array<std::array<Sample, length>, length>, nChannel> matrix{};
+  std::array<FeedbackMatrixMixer<Sample, length>, nChannel> mixer;
+  std::array<Lanes, 2> buf{};
+  ParallelDelay<Sample, nChannel, length> delay;
+  ParallelDoubleEMAFilterKp<Sample, nChannel, length> lowpass;
+  ParallelEMAHighpass<Sample, nChannel, length> highpass;
+
+  SplitGainGenerator<Sample, length> splitGain;
   size_t cycle = 100000;
   size_t counter = 0;
   size_t bufIndex = 0;
 
 public:
   Sample rate = Sample(1);
-  std::array<RateLimiter<Sample>, length> delayTimeSample;
+  ParallelRateLimiter<Sample, nChannel, length> delayTimeSample;
   std::array<Sample, length> lowpassKp{};
   std::array<Sample, length> highpassKp{};
 
@@ -531,7 +704,7 @@ public:
     auto &&lastGain = Sample(1) - paraGain * paraGain;
     auto scale2 = Sample(2) / (Sample(length - 2) + paraGain);
     auto scale1 = Sample(2)
-      / (Sample(length - 2) * paraGain + lastGain + matrix[length - 1][length - 1]);
+      / (Sample(length - 2) * paraGain + lastGain + mat[length - 1][length - 1]);
     for (size_t col = 0; col < length - 1; ++col) {
       mat[length - 2][col] = scale2;
       mat[length - 1][col] = -paraGain * scale1;
@@ -668,48 +841,52 @@ public:
     }
   }
 
-  void randomizeMatrix(unsigned matrixType, unsigned seed)
+  void randomizeMatrix(size_t channel, unsigned matrixType, unsigned seed)
   {
+    auto &mat = matrix[channel];
+
     if (matrixType == FeedbackMatrixType::specialOrthogonal) {
-      randomSpecialOrthogonal(seed, matrix);
+      randomSpecialOrthogonal(seed, mat);
     } else if (matrixType == FeedbackMatrixType::circulantOrthogonal) {
-      randomCirculantOrthogonal(seed, length, matrix);
+      randomCirculantOrthogonal(seed, length, mat);
     } else if (matrixType == FeedbackMatrixType::circulant4) {
-      randomCirculantOrthogonal(seed, 4, matrix);
+      randomCirculantOrthogonal(seed, 4, mat);
     } else if (matrixType == FeedbackMatrixType::circulant8) {
-      randomCirculantOrthogonal(seed, 8, matrix);
+      randomCirculantOrthogonal(seed, 8, mat);
     } else if (matrixType == FeedbackMatrixType::circulant16) {
-      randomCirculantOrthogonal(seed, 16, matrix);
+      randomCirculantOrthogonal(seed, 16, mat);
     } else if (matrixType == FeedbackMatrixType::circulant32) {
-      randomCirculantOrthogonal(seed, 32, matrix);
+      randomCirculantOrthogonal(seed, 32, mat);
     } else if (matrixType == FeedbackMatrixType::upperTriangularPositive) {
-      randomUpperTriangular(seed, 0, Sample(1), matrix);
+      randomUpperTriangular(seed, 0, Sample(1), mat);
     } else if (matrixType == FeedbackMatrixType::upperTriangularNegative) {
-      randomUpperTriangular(seed, Sample(-1), 0, matrix);
+      randomUpperTriangular(seed, Sample(-1), 0, mat);
     } else if (matrixType == FeedbackMatrixType::lowerTriangularPositive) {
-      randomLowerTriangular(seed, 0, Sample(1), matrix);
+      randomLowerTriangular(seed, 0, Sample(1), mat);
     } else if (matrixType == FeedbackMatrixType::lowerTriangularNegative) {
-      randomLowerTriangular(seed, Sample(-1), 0, matrix);
+      randomLowerTriangular(seed, Sample(-1), 0, mat);
     } else if (matrixType == FeedbackMatrixType::schroederPositive) {
-      randomSchroeder(seed, 0, Sample(1), matrix);
+      randomSchroeder(seed, 0, Sample(1), mat);
     } else if (matrixType == FeedbackMatrixType::schroederNegative) {
-      randomSchroeder(seed, Sample(-1), 0, matrix);
+      randomSchroeder(seed, Sample(-1), 0, mat);
     } else if (matrixType == FeedbackMatrixType::absorbentPositive) {
-      randomAbsorbent(seed, 0, Sample(1), matrix);
+      randomAbsorbent(seed, 0, Sample(1), mat);
     } else if (matrixType == FeedbackMatrixType::absorbentNegative) {
-      randomAbsorbent(seed, Sample(-1), 0, matrix);
+      randomAbsorbent(seed, Sample(-1), 0, mat);
     } else if (matrixType == FeedbackMatrixType::hadamard) {
-      constructHadamardSylvester(matrix);
+      constructHadamardSylvester(mat);
     } else if (matrixType == FeedbackMatrixType::conference) {
-      constructConference(matrix);
+      constructConference(mat);
     } else { // matrixType == FeedbackMatrixType::orthogonal, or default.
-      randomOrthogonal(seed, matrix);
+      randomOrthogonal(seed, mat);
     }
+
+    mixer[channel].prepare(matrixType, mat);
   }
 
   void setup(Sample sampleRate, Sample maxTime)
   {
-    for (auto &dl : delay) dl.setup(sampleRate, maxTime);
+    delay.setup(sampleRate, maxTime);
 
     lowpassKp.fill(Sample(1));
     highpassKp.fill(Sample(0.0006542843087824565)); // 5Hz cutoff when fs=48000Hz.
@@ -727,57 +904,55 @@ public:
   void reset()
   {
     buf.fill({});
-    for (auto &dl : delay) dl.reset();
-    for (auto &lp : lowpass) lp.reset();
-    for (auto &hp : highpass) hp.reset();
+    delay.reset();
+    lowpass.reset();
+    highpass.reset();
+    splitGain.reset();
 
     counter = 0;
   }
 
-  /**
-  `offset` is normalized phase in [0, 1].
-  `skew` >= 0.
-  */
-  void fillSplitGain(Sample offset, Sample skew)
-  {
-    for (size_t idx = 0; idx < splitGain.size(); ++idx) {
-      auto phase = offset + Sample(idx) / Sample(splitGain.size());
-      splitGain[idx] = std::exp(skew * std::sin(Sample(twopi) * phase));
-    }
-    auto sum = std::accumulate(splitGain.begin(), splitGain.end(), Sample(0));
-    for (auto &value : splitGain) value /= sum;
-  }
-
-  Sample preProcess(Sample splitPhaseOffset, Sample splitSkew)
+  std::array<Sample, nChannel> process(
+    const std::array<Sample, nChannel> &input,
+    Sample splitPhaseOffset,
+    Sample splitSkew,
+    Sample stereoCross,
+    Sample feedback)
   {
     if (++counter >= cycle) counter = 0;
 
-    fillSplitGain(splitPhaseOffset + Sample(counter) / Sample(cycle), splitSkew);
+    splitGain.process(splitPhaseOffset + Sample(counter) / Sample(cycle), splitSkew);
 
     bufIndex ^= 1;
     auto &front = buf[bufIndex];
     auto &back = buf[bufIndex ^ 1];
-    front.fill(0);
-    for (size_t i = 0; i < length; ++i) {
-      for (size_t j = 0; j < length; ++j) front[i] += matrix[i][j] * back[j];
-    }
-    return std::accumulate(front.begin(), front.end(), Sample(0));
-  }
 
-  Sample process(Sample input, Sample crossIn, Sample stereoCross, Sample feedback)
-  {
-    auto &front = buf[bufIndex];
+    std::array<Sample, nChannel> crossIn;
+    for (size_t ch = 0; ch < nChannel; ++ch) {
+      mixer[ch].process(back[ch], front[ch]);
+      crossIn[nChannel - 1 - ch]
+        = std::accumulate(front[ch].begin(), front[ch].end(), Sample(0));
+    }
+    for (auto &x : crossIn) x /= -Sample(length);
 
-    crossIn /= -Sample(length);
-    for (size_t idx = 0; idx < length; ++idx) {
-      auto crossed = front[idx] + stereoCross * (crossIn - front[idx]);
-      auto sig = splitGain[idx] * input + feedback * crossed;
-      auto delayed = delay[idx].process(sig, delayTimeSample[idx].process(rate));
-      auto lowpassed = lowpass[idx].process(delayed, lowpassKp[idx]);
-      front[idx] = highpass[idx].process(lowpassed, highpassKp[idx]);
+    for (size_t ch = 0; ch < nChannel; ++ch) {
+      auto &fr = front[ch];
+      for (size_t idx = 0; idx < length; ++idx) {
+        auto crossed = fr[idx] + stereoCross * (crossIn[ch] - fr[idx]);
+        fr[idx] = splitGain.value[idx] * input[ch] + feedback * crossed;
+      }
     }
 
-    return std::accumulate(front.begin(), front.end(), Sample(0));
+    delayTimeSample.process(rate);
+    delay.process(front, delayTimeSample.value);
+    lowpass.process(front, lowpassKp);
+    highpass.process(front, highpassKp);
+
+    std::array<Sample, nChannel> output;
+    for (size_t ch = 0; ch < nChannel; ++ch) {
+      output[ch] = std::accumulate(front[ch].begin(), front[ch].end(), Sample(0));
+    }
+    return output;
   }
 };
 
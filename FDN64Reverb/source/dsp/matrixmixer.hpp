@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "matrixtype.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace SomeDSP {
+
+/**
+Computes `output = matrix * input` using the structure of each `FeedbackMatrixType`.
+
+- Triangular, Schroeder, absorbent and banded circulant matrices skip the zero entries.
+  Summation order is kept the same as dense product, so the output is bit-identical.
+- Hadamard uses fast Walsh-Hadamard transform. O(N log N).
+- Full-band circulant uses `(u * u^T - I) * x = u * dot(u, x) - x`. O(N).
+- Other types fall back to dense product.
+
+Dense loops are written as column-wise multiply-add on transposed matrix. Inner loops are
+independent for each row, so compiler can vectorize them without reordering the sum.
+*/
+template<typename Sample, size_t length> class FeedbackMatrixMixer {
+public:
+  using Vec = std::array<Sample, length>;
+
+private:
+  enum class Kernel {
+    dense,
+    hadamard,
+    rankOne,
+    band,
+    upperTriangular,
+    lowerTriangular,
+    schroeder,
+    absorbent,
+  };
+
+  Kernel kernel = Kernel::dense;
+  std::array<std::array<Sample, length>, length> column{}; // Transposed matrix.
+  Vec diagonal{};
+  Vec vec{};
+  Sample scale = Sample(1);
+  size_t bandStart = 0;
+  size_t bandEnd = length;
+
+  static constexpr bool isPowerOfTwo = length && ((length & (length - 1)) == 0);
+
+public:
+  template<size_t dim>
+  void
+  prepare(unsigned matrixType, const std::array<std::array<Sample, dim>, dim> &matrix)
+  {
+    for (size_t row = 0; row < length; ++row) {
+      for (size_t col = 0; col < length; ++col) column[col][row] = matrix[row][col];
+    }
+    for (size_t idx = 0; idx < length; ++idx) diagonal[idx] = matrix[idx][idx];
+
+    using MT = FeedbackMatrixType::FeedbackMatrixType;
+    switch (matrixType) {
+      case MT::hadamard: {
+        if constexpr (isPowerOfTwo) {
+          kernel = Kernel::hadamard;
+          scale = matrix[0][0];
+        } else {
+          kernel = Kernel::dense;
+        }
+      } break;
+
+      case MT::circulantOrthogonal: {
+        // Diagonal is `u[i] * u[i] - 1`, and u[i] >= 0 by construction.
+        kernel = Kernel::rankOne;
+        for (size_t idx = 0; idx < length; ++idx) {
+          vec[idx] = std::sqrt(std::max(Sample(0), diagonal[idx] + Sample(1)));
+        }
+      } break;
+
+      case MT::circulant4:
+      case MT::circulant8:
+      case MT::circulant16:
+      case MT::circulant32: {
+        // Non-zero entries are in a square block. Outside of the block is `-I`.
+        size_t band = matrixType == MT::circulant4 ? 4
+          : matrixType == MT::circulant8           ? 8
+          : matrixType == MT::circulant16          ? 16
+                                                   : 32;
+        kernel = Kernel::band;
+        bandStart = std::min<size_t>(1, length);
+        bandEnd = std::min(band, length);
+      } break;
+
+      case MT::upperTriangularPositive:
+      case MT::upperTriangularNegative:
+        kernel = Kernel::upperTriangular;
+        break;
+
+      case MT::lowerTriangularPositive:
+      case MT::lowerTriangularNegative:
+        kernel = Kernel::lowerTriangular;
+        break;
+
+      case MT::schroederPositive:
+      case MT::schroederNegative:
+        kernel = length >= 2 ? Kernel::schroeder : Kernel::dense;
+        break;
+
+      case MT::absorbentPositive:
+      case MT::absorbentNegative:
+        kernel = length >= 2 && length % 2 == 0 ? Kernel::absorbent : Kernel::dense;
+        break;
+
+      default:
+        kernel = Kernel::dense;
+        break;
+    }
+  }
+
+  void process(const Vec &x, Vec &y)
+  {
+    switch (kernel) {
+      case Kernel::hadamard:
+        processHadamard(x, y);
+        break;
+      case Kernel::rankOne:
+        processRankOne(x, y);
+        break;
+      case Kernel::band:
+        processBand(x, y);
+        break;
+      case Kernel::upperTriangular:
+        processUpperTriangular(x, y);
+        break;
+      case Kernel::lowerTriangular:
+        processLowerTriangular(x, y);
+        break;
+      case Kernel::schroeder:
+        processSchroeder(x, y);
+        break;
+      case Kernel::absorbent:
+        processAbsorbent(x, y);
+        break;
+      default:
+        processDense(x, y);
+        break;
+    }
+  }
+
+private:
+  void processDense(const Vec &x, Vec &y)
+  {
+    y.fill(0);
+    for (size_t col = 0; col < length; ++col) {
+      const auto &mc = column[col];
+      const auto xc = x[col];
+      for (size_t row = 0; row < length; ++row) y[row] += mc[row] * xc;
+    }
+  }
+
+  void processHadamard(const Vec &x, Vec &y)
+  {
+    y = x;
+    for (size_t half = 1; half < length; half *= 2) {
+      for (size_t start = 0; start < length; start += 2 * half) {
+        for (size_t idx = start; idx < start + half; ++idx) {
+          auto a = y[idx];
+          auto b = y[idx + half];
+          y[idx] = a + b;
+          y[idx + half] = a - b;
+        }
+      }
+    }
+    for (auto &value : y) value *= scale;
+  }
+
+  void processRankOne(const Vec &x, Vec &y)
+  {
+    Sample dot = 0;
+    for (size_t idx = 0; idx < length; ++idx) dot += vec[idx] * x[idx];
+    for (size_t idx = 0; idx < length; ++idx) y[idx] = vec[idx] * dot - x[idx];
+  }
+
+  void processBand(const Vec &x, Vec &y)
+  {
+    for (size_t idx = 0; idx < length; ++idx) y[idx] = diagonal[idx] * x[idx];
+
+    std::fill(y.begin() + bandStart, y.begin() + bandEnd, Sample(0));
+    for (size_t col = bandStart; col < bandEnd; ++col) {
+      const auto &mc = column[col];
+      const auto xc = x[col];
+      for (size_t row = bandStart; row < bandEnd; ++row) y[row] += mc[row] * xc;
+    }
+  }
+
+  void processUpperTriangular(const Vec &x, Vec &y)
+  {
+    y.fill(0);
+    for (size_t col = 0; col < length; ++col) {
+      const auto &mc = column[col];
+      const auto xc = x[col];
+      for (size_t row = 0; row <= col; ++row) y[row] += mc[row] * xc;
+    }
+  }
+
+  void processLowerTriangular(const Vec &x, Vec &y)
+  {
+    y.fill(0);
+    for (size_t col = 0; col < length; ++col) {
+      const auto &mc = column[col];
+      const auto xc = x[col];
+      for (size_t row = col; row < length; ++row) y[row] += mc[row] * xc;
+    }
+  }
+
+  // Only the last 2 rows are dense. Others are diagonal.
+  void processSchroeder(const Vec &x, Vec &y)
+  {
+    constexpr size_t last = length - 1;
+    constexpr size_t para = length - 2;
+
+    for (size_t idx = 0; idx < para; ++idx) y[idx] = diagonal[idx] * x[idx];
+
+    Sample sumPara = 0;
+    Sample sumLast = 0;
+    for (size_t col = 0; col < length; ++col) {
+      sumPara += column[col][para] * x[col];
+      sumLast += column[col][last] * x[col];
+    }
+    y[para] = sumPara;
+    y[last] = sumLast;
+  }
+
+  // Upper half is dense. Lower half has 2 non-zero entries per row.
+  void processAbsorbent(const Vec &x, Vec &y)
+  {
+    constexpr size_t half = length / 2;
+
+    std::fill(y.begin(), y.begin() + half, Sample(0));
+    for (size_t col = 0; col < length; ++col) {
+      const auto &mc = column[col];
+      const auto xc = x[col];
+      for (size_t row = 0; row < half; ++row) y[row] += mc[row] * xc;
+    }
+
+    for (size_t idx = 0; idx < half; ++idx) {
+      y[half + idx] = column[idx][half + idx] * x[idx]
+        + column[half + idx][half + idx] * x[half + idx];
+    }
+  }
+};
+
+} // namespace SomeDSP
@@ -10,6 +10,8 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/noteeventlist.hpp"
+#include "../../common/parameterautomation.hpp"
 #include "dsp/dspcore.hpp"
 
 namespace Steinberg {
@@ -39,11 +41,9 @@ public:
     return (Vst::IAudioProcessor *)new PlugProcessor();
   }
 
-  void processBypass(Vst::ProcessData &data);
+  void processBypass(Vst::ProcessData &data, size_t begin, size_t end);
 
 protected:
-  void handleEvent(Vst::ProcessData &data);
-
   inline int32 toDiscrete(Vst::ParamValue normalized, int32 stepCount)
   {
     return int32(std::min<double>(stepCount, normalized * (stepCount + 1.0)));
@@ -51,6 +51,8 @@ protected:
 
   uint64_t lastState = 0;
   uint32_t wasBypassing = 0;
+  ParameterAutomation automation;
+  NoteEventList noteEvents;
   DSPCore dsp;
 };
 
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+// Compares `SplitGainGenerator` to the per-sample split gain computation which was used
+// in `FeedbackDelayNetwork::fillSplitGain`.
+
+#include "../source/dsp/fdnreverb.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using namespace SomeDSP;
+
+constexpr size_t length = 64;
+
+void fillSplitGainPerSample(float offset, float skew, std::array<float, length> &splitGain)
+{
+  for (size_t idx = 0; idx < splitGain.size(); ++idx) {
+    auto phase = offset + float(idx) / float(splitGain.size());
+    splitGain[idx] = std::exp(skew * std::sin(float(twopi) * phase));
+  }
+  auto sum = std::accumulate(splitGain.begin(), splitGain.end(), float(0));
+  for (auto &value : splitGain) value /= sum;
+}
+
+int main()
+{
+  constexpr size_t nFrame = 48000 * 10;
+  constexpr size_t cycle = 48000; // 1 Hz rotation at 48 kHz.
+  constexpr float skew = 3.0f;
+
+  std::array<float, length> reference{};
+  SplitGainGenerator<float, length> generator;
+
+  float sinkReference = 0;
+  float sinkGenerator = 0;
+  float maxError = 0;
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (size_t frame = 0; frame < nFrame; ++frame) {
+    fillSplitGainPerSample(float(frame % cycle) / float(cycle), skew, reference);
+    sinkReference += reference[frame % length];
+  }
+
+  auto t1 = std::chrono::steady_clock::now();
+  for (size_t frame = 0; frame < nFrame; ++frame) {
+    generator.process(float(frame % cycle) / float(cycle), skew);
+    sinkGenerator += generator.value[frame % length];
+  }
+
+  auto t2 = std::chrono::steady_clock::now();
+  generator.reset();
+  for (size_t frame = 0; frame < nFrame; ++frame) {
+    auto phase = float(frame % cycle) / float(cycle);
+    fillSplitGainPerSample(phase, skew, reference);
+    generator.process(phase, skew);
+    for (size_t idx = 0; idx < length; ++idx) {
+      maxError = std::max(maxError, std::fabs(reference[idx] - generator.value[idx]));
+    }
+  }
+
+  using ns = std::chrono::duration<double, std::nano>;
+  auto perSample = ns(t1 - t0).count() / double(nFrame);
+  auto blockRate = ns(t2 - t1).count() / double(nFrame);
+
+  std::cout << "Per sample : " << perSample << " ns/frame\n"
+            << "Block rate : " << blockRate << " ns/frame\n"
+            << "Speed up   : " << perSample / blockRate << "\n"
+            << "Max error  : " << maxError << "\n"
+            << "(sink: " << sinkReference << ", " << sinkGenerator << ")\n";
+  return EXIT_SUCCESS;
+}
@@ -147,10 +147,10 @@ public:
     this->maxTime = maxTime;
   }
 
-  void set(Sample gain, Sample timeSec)
+  void set(Sample gain, Sample timeSec, const SmootherContext<Sample> &context)
   {
     this->gain = gain;
-    delayTime.push(timeSec);
+    delayTime.push(timeSec, context);
   }
 
   void reset()
@@ -24,10 +24,10 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  midiNotes.resize(0);
+  midiNotes.clear();
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.01f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.01f);
 
   noteStack.reserve(128);
   noteStack.resize(0);
@@ -118,35 +118,37 @@ void DSPCore::setParameters()
 {
   using ID = ParameterID::ID;
 
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
+  const auto &sc = smootherContext;
 
   if (!noteStack.empty()) {
     velocity = noteStack.back().velocity;
     const auto freq
       = noteStack.back().frequency * paramToPitch(param.value[ID::pitchBend]->getFloat());
-    interpPitch.push(freq);
+    interpPitch.push(freq, sc);
   } else {
-    interpPitch.push(0.0f);
+    interpPitch.push(0.0f, sc);
   }
-  interpMasterGain.push(velocity * param.value[ID::gain]->getFloat());
+  interpMasterGain.push(velocity * param.value[ID::gain]->getFloat(), sc);
 
-  interpStickToneMix.push(param.value[ID::stickToneMix]->getFloat());
-  interpStickPulseMix.push(param.value[ID::stickPulseMix]->getFloat());
-  interpStickVelvetMix.push(param.value[ID::stickVelvetMix]->getFloat());
+  interpStickToneMix.push(param.value[ID::stickToneMix]->getFloat(), sc);
+  interpStickPulseMix.push(param.value[ID::stickPulseMix]->getFloat(), sc);
+  interpStickVelvetMix.push(param.value[ID::stickVelvetMix]->getFloat(), sc);
 
-  interpFDNFeedback.push(param.value[ID::fdnFeedback]->getFloat());
-  interpFDNCascadeMix.push(param.value[ID::fdnCascadeMix]->getFloat());
+  interpFDNFeedback.push(param.value[ID::fdnFeedback]->getFloat(), sc);
+  interpFDNCascadeMix.push(param.value[ID::fdnCascadeMix]->getFloat(), sc);
 
-  interpAllpassMix.push(param.value[ID::allpassMix]->getFloat());
-  interpAllpass1Feedback.push(param.value[ID::allpass1Feedback]->getFloat());
-  interpAllpass2Feedback.push(param.value[ID::allpass2Feedback]->getFloat());
+  interpAllpassMix.push(param.value[ID::allpassMix]->getFloat(), sc);
+  interpAllpass1Feedback.push(param.value[ID::allpass1Feedback]->getFloat(), sc);
+  interpAllpass2Feedback.push(param.value[ID::allpass2Feedback]->getFloat(), sc);
 
-  interpTremoloMix.push(param.value[ID::tremoloMix]->getFloat());
-  interpTremoloDepth.push(randomTremoloDepth * param.value[ID::tremoloDepth]->getFloat());
+  interpTremoloMix.push(param.value[ID::tremoloMix]->getFloat(), sc);
+  interpTremoloDepth.push(
+    randomTremoloDepth * param.value[ID::tremoloDepth]->getFloat(), sc);
   interpTremoloFrequency.push(
-    randomTremoloFrequency * param.value[ID::tremoloFrequency]->getFloat());
+    randomTremoloFrequency * param.value[ID::tremoloFrequency]->getFloat(), sc);
   interpTremoloDelayTime.push(
-    randomTremoloDelayTime * param.value[ID::tremoloDelayTime]->getFloat());
+    randomTremoloDelayTime * param.value[ID::tremoloDelayTime]->getFloat(), sc);
 
   serialAP1Highpass.setCutoffQ(
     param.value[ID::allpass1HighpassCutoff]->getFloat(), highpassQ);
@@ -159,13 +161,13 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   for (auto &fdn : fdnCascade)
-    for (auto &time : fdn.delayTime) time.refresh();
-  for (auto &ap : serialAP1.allpass) ap.delayTime.refresh();
+    for (auto &time : fdn.delayTime) time.refresh(smootherContext);
+  for (auto &ap : serialAP1.allpass) ap.delayTime.refresh(smootherContext);
   for (auto &section : serialAP2)
-    for (auto &ap : section.allpass) ap.delayTime.refresh();
+    for (auto &ap : section.allpass) ap.delayTime.refresh(smootherContext);
 
   const bool enableFDN = param.value[ParameterID::fdn]->getInt();
   const bool allpass1Saturation = param.value[ParameterID::allpass1Saturation]->getInt();
@@ -291,21 +293,26 @@ void DSPCore::noteOn(int32_t noteId, int16_t pitch, float tuning, float velocity
       }
       fdnCascade[n].gain[i] = (rng.process() < 0.5f ? 1.0f : -1.0f)
         * (0.1f + rng.process()) * 2.0f / fdnMatrixSize;
-      fdnCascade[n].delayTime[i].push(rng.process() * delayTimeMod * fdnTime);
+      fdnCascade[n].delayTime[i].push(
+        rng.process() * delayTimeMod * fdnTime, smootherContext);
     }
   }
 
   // Set serialAP.
   float ap1Time = param.value[ParameterID::allpass1Time]->getFloat();
   for (auto &ap : serialAP1.allpass) {
-    ap.set(0.001f + 0.999f * rng.process(), ap1Time + ap1Time * rng.process());
+    ap.set(
+      0.001f + 0.999f * rng.process(), ap1Time + ap1Time * rng.process(),
+      smootherContext);
     ap1Time *= 1.5f;
   }
 
   float ap2Time = param.value[ParameterID::allpass2Time]->getFloat();
   for (auto &allpass : serialAP2) {
     for (auto &ap : allpass.allpass)
-      ap.set(0.001f + 0.999f * rng.process(), ap2Time + ap2Time * rng.process());
+      ap.set(
+        0.001f + 0.999f * rng.process(), ap2Time + ap2Time * rng.process(),
+        smootherContext);
     ap2Time *= 1.5f;
   }
 
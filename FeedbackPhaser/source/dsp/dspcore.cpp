@@ -39,7 +39,7 @@ size_t DSPCore::getLatency() { return 0; }
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
   pitchSmoothingKp                                                                       \
     = EMAFilter<double>::secondToP(upRate, pv[ID::notePitchSlideSecond]->getDouble());   \
@@ -75,7 +75,7 @@ void DSPCore::updateUpRate()
 {
   upRate = double(sampleRate) * fold[oversampling];
 
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 }
 
 void DSPCore::reset()
@@ -135,18 +135,18 @@ std::array<double, 2> DSPCore::processFrame(
   notePitchToAllpassCutoffRelease.processKp(
     notePitchToAllpassCutoff.process(pitchSmoothingKp), pitchReleaseKp);
 
-  const auto outGain = outputGain.process();
-  const auto fbMix = feedbackMix.process();
-  const auto inMixSign = inputMixSign.process();
-  const auto fbGain = feedback.process();
-  const auto fbClip = feedbackClip.process();
-  const auto fbHpG = feedbackHighpassG.process();
-  const auto outHpG = outputHighpassG.process();
-  const auto modAmt = modAmount.process();
-  const auto modAsym = modAsymmetry.process();
-  const auto modLpKp = modLowpassKp.process();
-  const auto apSpread = allpassSpread.process();
-  const auto apCenterCut = allpassCenterCut.process();
+  const auto outGain = outputGain.process(smootherContext);
+  const auto fbMix = feedbackMix.process(smootherContext);
+  const auto inMixSign = inputMixSign.process(smootherContext);
+  const auto fbGain = feedback.process(smootherContext);
+  const auto fbClip = feedbackClip.process(smootherContext);
+  const auto fbHpG = feedbackHighpassG.process(smootherContext);
+  const auto outHpG = outputHighpassG.process(smootherContext);
+  const auto modAmt = modAmount.process(smootherContext);
+  const auto modAsym = modAsymmetry.process(smootherContext);
+  const auto modLpKp = modLowpassKp.process(smootherContext);
+  const auto apSpread = allpassSpread.process(smootherContext);
+  const auto apCenterCut = allpassCenterCut.process(smootherContext);
 
   constexpr double eps = (double)std::numeric_limits<float>::epsilon();
 
@@ -232,7 +232,7 @@ void DSPCore::process(
   const float *side0 = enableSidechain ? in2 : in0;
   const float *side1 = enableSidechain ? in3 : in1;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   if (transitionCounter == 0) {
     currentAllpassStage = pv[ID::stage]->getInt();
@@ -5,6 +5,7 @@
 
 #include "../../../common/dsp/constants.hpp"
 #include "../../../common/dsp/multirate.hpp"
+#include "../../../common/dsp/notequeue.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "filter.hpp"
@@ -67,22 +68,17 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    midiNotes.dispatch(frame, [&](NoteInfo &nt) {
+      if (nt.isNoteOn)
+        noteOn(nt);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
-    }
+        noteOff(nt.id);
+    });
   }
 
 private:
@@ -94,7 +90,7 @@ private:
   static constexpr size_t upFold = 8;
   static constexpr std::array<size_t, 3> fold{1, 2, upFold};
 
-  std::vector<NoteInfo> midiNotes;
+  NoteQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
 
   double sampleRate = 44100;
@@ -105,6 +101,7 @@ private:
   ExpSmootherLocal<double> notePitchToAllpassCutoff;
   DoubleEMAFilter<double> notePitchToAllpassCutoffRelease;
 
+  SmootherContext<double> smootherContext;
   ExpSmoother<double> outputGain;
   ExpSmoother<double> feedbackMix;
   ExpSmoother<double> inputMixSign;
@@ -121,7 +121,7 @@ void DSPCore::setup(double sampleRate)
   this->sampleRate = sampleRate;
   upRate = sampleRate * upFold;
 
-  SmootherCommon<double>::setTime(double(0.2));
+  smootherContext.setTime(double(0.2));
 
   triggerDetector.setup(upRate * double(0.125));
 
@@ -241,7 +241,7 @@ void DSPCore::setup(double sampleRate)
 void DSPCore::updateUpRate()
 {
   upRate = sampleRate * fold[overSampling];
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
   for (auto &x : membrane1) x.onSampleRateChange(upRate);
   for (auto &x : membrane2) x.onSampleRateChange(upRate);
 }
@@ -381,13 +381,13 @@ double DSPCore::processDrum(
   if (!isSecondaryCollided && membrane2Position[index] != 0) isSecondaryCollided = true;
 
   const auto pitch = pitchEnv * interpPitch.process(pitchSmoothingKp);
-  feedbackMatrix.process();
+  feedbackMatrix.process(smootherContext);
 
   const auto collision1
     = membrane1EnergyDecay[index].process(membrane1Position[index], false)
     / double(maxFdnSize);
   const auto p1 = membrane1[index].process(
-    sig + collision1, crossGain, pitch, timeModAmt, feedbackMatrix);
+    sig + collision1, crossGain, pitch, timeModAmt, feedbackMatrix, smootherContext);
   membrane1Velocity[index] = p1 - membrane1Position[index];
   membrane1Position[index] = p1;
 
@@ -395,7 +395,7 @@ double DSPCore::processDrum(
     = membrane2EnergyDecay[index].process(membrane2Position[index], false)
     / double(maxFdnSize);
   const auto p2 = membrane2[index].process(
-    sig + collision2, crossGain, pitch, timeModAmt, feedbackMatrix);
+    sig + collision2, crossGain, pitch, timeModAmt, feedbackMatrix, smootherContext);
   membrane2Velocity[index] = p2 - membrane2Position[index];
   membrane2Position[index] = p2;
 
@@ -406,18 +406,18 @@ double DSPCore::processDrum(
 }
 
 #define PROCESS_COMMON                                                                   \
-  externalInputGain.process();                                                           \
-  wireDistance.process();                                                                \
-  wireCollisionTypeMix.process();                                                        \
-  impactWireMix.process();                                                               \
-  secondaryDistance.process();                                                           \
-  const auto crossGain = crossFeedbackGain.process();                                    \
-  const auto timeModAmt = delayTimeModAmount.process();                                  \
-  secondaryFdnMix.process();                                                             \
-  membraneWireMix.process();                                                             \
-  const auto balance = stereoBalance.process();                                          \
-  const auto merge = stereoMerge.process();                                              \
-  const auto outGain = outputGain.process();                                             \
+  externalInputGain.process(smootherContext);                                            \
+  wireDistance.process(smootherContext);                                                 \
+  wireCollisionTypeMix.process(smootherContext);                                         \
+  impactWireMix.process(smootherContext);                                                \
+  secondaryDistance.process(smootherContext);                                            \
+  const auto crossGain = crossFeedbackGain.process(smootherContext);                     \
+  const auto timeModAmt = delayTimeModAmount.process(smootherContext);                   \
+  secondaryFdnMix.process(smootherContext);                                              \
+  membraneWireMix.process(smootherContext);                                              \
+  const auto balance = stereoBalance.process(smootherContext);                           \
+  const auto merge = stereoMerge.process(smootherContext);                               \
+  const auto outGain = outputGain.process(smootherContext);                              \
                                                                                          \
   std::uniform_real_distribution<double> dist{double(-0.5), double(0.5)};                \
   const auto noise                                                                       \
@@ -480,8 +480,8 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setBufferSize(double(length));
+  smootherContext.setSampleRate(upRate);
 
   bool isStereo = pv[ID::stereoUnison]->getInt();
   bool isSafetyHighpassEnabled = pv[ID::safetyHighpassEnable]->getInt();
@@ -512,16 +512,16 @@ void DSPCore::process(
         frame[0] = halfbandIir[0].process(halfbandInput[0]);
         frame[1] = halfbandIir[1].process(halfbandInput[1]);
         if (isSafetyHighpassEnabled) {
-          frame[0] = safetyHighpass[0].process(frame[0]);
-          frame[1] = safetyHighpass[1].process(frame[1]);
+          frame[0] = safetyHighpass[0].process(frame[0], smootherContext);
+          frame[1] = safetyHighpass[1].process(frame[1], smootherContext);
         }
         out0[i] = float(frame[0]);
         out1[i] = float(frame[1]);
       } else {
         frame = processFrame({extIn0, extIn1});
         if (isSafetyHighpassEnabled) {
-          frame[0] = safetyHighpass[0].process(frame[0]);
-          frame[1] = safetyHighpass[1].process(frame[1]);
+          frame[0] = safetyHighpass[0].process(frame[0], smootherContext);
+          frame[1] = safetyHighpass[1].process(frame[1], smootherContext);
         }
         out0[i] = float(frame[0]);
         out1[i] = float(frame[1]);
@@ -533,12 +533,14 @@ void DSPCore::process(
           = processSample(extInMixed + double(0.5) * (prevExtIn[0] + prevExtIn[1]));
         halfbandInput[0][1] = processSample(extInMixed);
         frame[0] = halfbandIir[0].process(halfbandInput[0]);
-        if (isSafetyHighpassEnabled) frame[0] = safetyHighpass[0].process(frame[0]);
+        if (isSafetyHighpassEnabled)
+          frame[0] = safetyHighpass[0].process(frame[0], smootherContext);
         out0[i] = float(frame[0]);
         out1[i] = float(frame[0]);
       } else {
         frame[0] = processSample(extInMixed);
-        if (isSafetyHighpassEnabled) frame[0] = safetyHighpass[0].process(frame[0]);
+        if (isSafetyHighpassEnabled)
+          frame[0] = safetyHighpass[0].process(frame[0], smootherContext);
         out0[i] = float(frame[0]);
         out1[i] = float(frame[0]);
       }
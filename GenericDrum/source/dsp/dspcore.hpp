@@ -5,6 +5,7 @@
 
 #include "../../../common/dsp/constants.hpp"
 #include "../../../common/dsp/multirate.hpp"
+#include "../../../common/dsp/notequeue.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "envelope.hpp"
@@ -61,22 +62,17 @@ public:
     note.id = noteId;
     note.noteNumber = noteNumber + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    midiNotes.dispatch(frame, [&](NoteInfo &nt) {
+      if (nt.isNoteOn)
+        noteOn(nt);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
-    }
+        noteOff(nt.id);
+    });
   }
 
 private:
@@ -94,7 +90,7 @@ private:
     double timeModAmt);
   inline void processExternalInput(double absed);
 
-  std::vector<NoteInfo> midiNotes;
+  NoteQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
 
   double maxExtInAmplitude = 0;
@@ -115,6 +111,7 @@ private:
   double pitchSmoothingKp = 1.0;
   ExpSmootherLocal<double> interpPitch;
 
+  SmootherContext<double> smootherContext;
   ExpSmoother<double> externalInputGain;
   ExpSmoother<double> wireDistance;
   ExpSmoother<double> wireCollisionTypeMix;
@@ -60,6 +60,10 @@ private:
   ExpSmoother<std::complex<Sample>> b{};
   ExpSmoother<std::complex<Sample>> a1{};
 
+  // Never configured, so `kp` stays at 1. It matches the former shared context of
+  // `std::complex`, which no caller had set.
+  SmootherContext<std::complex<Sample>> smootherContext{};
+
   inline Sample setR(Sample cut, Sample lowR, Sample highR, Sample lowCut, Sample highCut)
   {
     if (cut <= lowCut) return lowR;
@@ -90,7 +94,7 @@ public:
 
   Sample process(Sample x0)
   {
-    y1 = b.process() * (x0 + x1) + a1.process() * y1;
+    y1 = b.process(smootherContext) * (x0 + x1) + a1.process(smootherContext) * y1;
     x1 = x0;
     return y1.real();
   }
@@ -187,11 +191,11 @@ public:
     d.catchUp();
   }
 
-  Sample process(Sample v0)
+  Sample process(Sample v0, const SmootherContext<Sample> &context)
   {
-    g.process();
-    d.process();
-    k.process();
+    g.process(context);
+    d.process(context);
+    k.process(context);
     auto v1 = (s1 + g.value * (v0 - s2)) * d.value;
     auto v2 = s2 + g.value * v1;
     s1 = Sample(2) * v1 - s1;
@@ -504,9 +508,9 @@ public:
     for (auto &x : matrix) x.catchUp();
   }
 
-  void process()
+  void process(const SmootherContext<Sample> &context)
   {
-    for (auto &x : matrix) x.process();
+    for (auto &x : matrix) x.process(context);
   }
 
   Sample at(size_t i, size_t j) { return matrix[i].value[j]; }
@@ -563,7 +567,8 @@ public:
     Sample crossGain,
     Sample pitchMod,
     Sample timeModAmount,
-    FeedbackMatrix<Sample, length> &feedbackMatrix)
+    FeedbackMatrix<Sample, length> &feedbackMatrix,
+    const SmootherContext<Sample> &context)
   {
     bufIndex ^= 1;
     auto &front = buf[bufIndex];
@@ -576,8 +581,8 @@ public:
     const auto feedbackGain = safetyGain * crossGain;
     for (size_t i = 0; i < length; ++i) front[i] = input + feedbackGain * front[i];
 
-    bandpassCutoff.process();
-    bandpass.process(front, bandpassCutoff.value, bandpassQ.process(), pitchMod);
+    bandpassCutoff.process(context);
+    bandpass.process(front, bandpassCutoff.value, bandpassQ.process(context), pitchMod);
 
     delayTimeRateLimiter.process(delayTimeSamples, front, timeModAmount);
     delay.process(front, delayTimeRateLimiter.value, pitchMod);
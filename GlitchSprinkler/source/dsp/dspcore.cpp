@@ -21,7 +21,7 @@ void DSPCore::setup(double sampleRate_)
 
   sampleRate = sampleRate_;
 
-  SmootherCommon<double>::setTime(double(0.2));
+  smootherContext.setTime(double(0.2));
 
   terminationLength = int_fast32_t(double(0.002) * sampleRate);
   lowpassInterpRate = sampleRate / double(48000 * 64);
@@ -154,8 +154,8 @@ void DSPCore::reset()
   polynomial.updateCoefficients(true);
   isPolynomialUpdated = true;
 
-  modifierNotes.resize(0);
-  midiNotes.resize(0);
+  modifierNotes.clear();
+  midiNotes.clear();
   activeNote.resize(0);
   activeModifier.resize(0);
   noteIndices.resize(0);
@@ -309,7 +309,7 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
 
   isPolynomialUpdated = false;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   const auto beatPerSample = tempo / (double(60) * sampleRate);
   std::array<double, 2> frame{};
@@ -330,11 +330,11 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
       frame[1] += voiceOut[1];
     }
 
-    const auto safetyFiltMix = safetyFilterMix.process();
+    const auto safetyFiltMix = safetyFilterMix.process(smootherContext);
     frame[0] = std::lerp(frame[0], safetyFilter[0].process(frame[0]), safetyFiltMix);
     frame[1] = std::lerp(frame[1], safetyFilter[1].process(frame[1]), safetyFiltMix);
 
-    const auto outGain = outputGain.process();
+    const auto outGain = outputGain.process(smootherContext);
     out0[i] = float(outGain * frame[0]);
     out1[i] = float(outGain * frame[1]);
   }
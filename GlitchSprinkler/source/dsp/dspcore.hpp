@@ -5,6 +5,7 @@
 
 #include "../../../common/dsp/constants.hpp"
 #include "../../../common/dsp/multirate.hpp"
+#include "../../../common/dsp/notequeue.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "polynomial.hpp"
@@ -123,6 +124,7 @@ public:
   int_fast32_t pwmChangeCycle = 1;
   int_fast32_t pwmAmount = 1;
   DecibelScale<double> velocityMap{-60, 0, true};
+  SmootherContext<double> smootherContext;
   ExpSmoother<double> safetyFilterMix;
   ExpSmoother<double> outputGain;
 
@@ -132,8 +134,8 @@ public:
   // Maybe make it possible to change the pitch modifier channel.
   static constexpr size_t pitchModifierChannel = 15;
 
-  std::vector<NoteInfo> modifierNotes;
-  std::vector<NoteInfo> midiNotes;
+  NoteQueue<NoteInfo> modifierNotes;
+  NoteQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> activeNote;
   std::vector<NoteInfo> activeModifier;
   std::vector<size_t> noteIndices;
@@ -186,27 +188,22 @@ public:
     note.velocity = velocity;
 
     if (note.channel == pitchModifierChannel) {
-      modifierNotes.push_back(note);
+      modifierNotes.push(note);
     } else {
-      midiNotes.push_back(note);
+      midiNotes.push(note);
     }
   }
 
-#define DEFINE_NOTE_PROC_FUNC(FUNC_NAME, VECTOR, ON_FUNC, OFF_FUNC)                      \
+#define DEFINE_NOTE_PROC_FUNC(FUNC_NAME, QUEUE, ON_FUNC, OFF_FUNC)                       \
   void FUNC_NAME(size_t frame)                                                           \
   {                                                                                      \
-    while (true) {                                                                       \
-      auto it = std::find_if(VECTOR.begin(), VECTOR.end(), [&](const NoteInfo &nt) {     \
-        return nt.frame == frame;                                                        \
-      });                                                                                \
-      if (it == std::end(VECTOR)) return;                                                \
-      if (it->isNoteOn) {                                                                \
-        ON_FUNC(*it);                                                                    \
+    QUEUE.dispatch(frame, [&](NoteInfo &nt) {                                            \
+      if (nt.isNoteOn) {                                                                 \
+        ON_FUNC(nt);                                                                     \
       } else {                                                                           \
-        OFF_FUNC(it->id);                                                                \
+        OFF_FUNC(nt.id);                                                                 \
       }                                                                                  \
-      VECTOR.erase(it);                                                                  \
-    }                                                                                    \
+    });                                                                                  \
   }
 
   DEFINE_NOTE_PROC_FUNC(processMidiNote, midiNotes, noteOn, noteOff);
@@ -31,8 +31,8 @@ void DSPCore::setup(double sampleRate)
 
   constexpr auto smoothingTimeSecond = 0.2;
 
-  SmootherCommon<double>::setSampleRate(upRate);
-  SmootherCommon<double>::setTime(smoothingTimeSecond);
+  smootherContext.setSampleRate(upRate);
+  smootherContext.setTime(smoothingTimeSecond);
 
   for (auto &x : blitFormant.lpComb) x.setup(upRate, double(1));
   modComb.setup(upRate, double(0.5), double(Scales::maxTimeSpreadSeconds.getMax()));
@@ -129,17 +129,17 @@ double DSPCore::processSample()
   interpPitch.process(pitchSmoothingKp);
   noteFrequency.process(pitchSmoothingKp);
 
-  outputGain.process();
-  envelopeAM.process();
-  pulseGain.process();
-  pulsePitchOctave.process();
-  pulseBendOctave.process();
-  pulsePitchModMix.process();
-  pulseFormantOctave.process();
-  breathGain.process();
-  breathFormantOctave.process();
-  combFollowNote.process();
-  combFeedbackFollowEnvelope.process();
+  outputGain.process(smootherContext);
+  envelopeAM.process(smootherContext);
+  pulseGain.process(smootherContext);
+  pulsePitchOctave.process(smootherContext);
+  pulseBendOctave.process(smootherContext);
+  pulsePitchModMix.process(smootherContext);
+  pulseFormantOctave.process(smootherContext);
+  breathGain.process(smootherContext);
+  breathFormantOctave.process(smootherContext);
+  combFollowNote.process(smootherContext);
+  combFeedbackFollowEnvelope.process(smootherContext);
 
   if (noteGate.isTerminated()) return 0;
 
@@ -155,13 +155,16 @@ double DSPCore::processSample()
     pulseFormantOctave.getValue() * pulsePitchRatio);
 
   auto noise = breathFormant.process(
-    envAm * breathGain.getValue() * breathNoise.process(pulsePitchRatio * frequency),
-    std::exp2(pulseBendOctave.getValue() * envOut) * breathFormantOctave.getValue());
+    envAm * breathGain.getValue()
+      * breathNoise.process(pulsePitchRatio * frequency, smootherContext),
+    std::exp2(pulseBendOctave.getValue() * envOut) * breathFormantOctave.getValue(),
+    smootherContext);
 
   auto fbMod = std::lerp(double(1), envOut, combFeedbackFollowEnvelope.getValue());
   auto combInvPitchRatio
     = double(1) / std::lerp(double(1), interpPitch.getValue(), combFollowNote.getValue());
-  auto sig = modComb.process(s0 + noise, combInvPitchRatio, -envAm, fbMod);
+  auto sig
+    = modComb.process(s0 + noise, combInvPitchRatio, -envAm, fbMod, smootherContext);
   return outputGain.getValue() * noteGate.process() * sig;
 }
 
@@ -172,8 +175,8 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setBufferSize(double(length));
+  smootherContext.setSampleRate(upRate);
 
   bool overSampling = pv[ID::overSampling]->getInt();
   bool isSafetyHighpassEnabled = pv[ID::safetyHighpassEnable]->getInt();
@@ -185,12 +188,12 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
     if (overSampling) {
       for (size_t j = 0; j < upFold; ++j) halfbandInput[j] = processSample();
       auto sig = float(halfbandIir.process(halfbandInput));
-      if (isSafetyHighpassEnabled) sig = safetyHighpass.process(sig);
+      if (isSafetyHighpassEnabled) sig = safetyHighpass.process(sig, smootherContext);
       out0[i] = sig;
       out1[i] = sig;
     } else {
       auto sig = float(processSample());
-      if (isSafetyHighpassEnabled) sig = safetyHighpass.process(sig);
+      if (isSafetyHighpassEnabled) sig = safetyHighpass.process(sig, smootherContext);
       out0[i] = sig;
       out1[i] = sig;
     }
@@ -50,9 +50,9 @@ public:
   void push(Sample cutoffNormalized) { ASSIGN_COEFFICINETS(push); }
 #undef ASSIGN_COEFFICINETS
 
-  Sample process(Sample x0)
+  Sample process(Sample x0, const SmootherContext<Sample> &context)
   {
-    y1 = bn.process() * (x0 + x1) + a1.process() * y1;
+    y1 = bn.process(context) * (x0 + x1) + a1.process(context) * y1;
     x1 = x0;
     return y1;
   }
@@ -187,11 +187,11 @@ public:
   ASSIGN_COEFFICINETS(push, )
 #undef ASSIGN_COEFFICINETS
 
-  Sample process(Sample v0)
+  Sample process(Sample v0, const SmootherContext<Sample> &context)
   {
-    g.process();
-    d.process();
-    k.process();
+    g.process(context);
+    d.process(context);
+    k.process(context);
     auto v1 = (s1 + g.value * (v0 - s2)) * d.value;
     auto v2 = s2 + g.value * v1;
     s1 = Sample(2) * v1 - s1;
@@ -402,11 +402,11 @@ public:
   }
 
   // freqRatio = exp2(octave) / sampleRate.
-  Sample process(Sample x0, Sample freqRatio)
+  Sample process(Sample x0, Sample freqRatio, const SmootherContext<Sample> &context)
   {
     Sample sum = 0;
     for (size_t idx = 0; idx < nBandpass; ++idx) {
-      sum += bandGain[idx].process()
+      sum += bandGain[idx].process(context)
         * bandpass[idx].process(x0, bandpassCut[idx] * freqRatio, bandpassQ[idx]);
     }
     return lowpass.process(sum, lowpassCut * freqRatio, lowpassQ);
@@ -437,9 +437,9 @@ public:
     std::fill(buf.begin(), buf.end(), Sample(0));
   }
 
-  void process(Sample input)
+  void process(Sample input, const SmootherContext<Sample> &context)
   {
-    timeInSamples.process();
+    timeInSamples.process(context);
 
     const int size = int(buf.size());
     buf[wptr] = input;
@@ -489,10 +489,10 @@ public:
   ASSIGN_COEFFICINETS(reset)
 #undef ASSIGN_COEFFICINETS
 
-  void process(std::array<Sample, length> &x0)
+  void process(std::array<Sample, length> &x0, const SmootherContext<Sample> &context)
   {
-    bn.process();
-    a1.process();
+    bn.process(context);
+    a1.process(context);
     for (size_t i = 0; i < length; ++i) {
       y1[i] = bn.value[i] * (x0[i] + x1[i]) + a1.value[i] * y1[i];
       x1[i] = x0[i];
@@ -535,10 +535,10 @@ public:
   ASSIGN_COEFFICINETS(reset)
 #undef ASSIGN_COEFFICINETS
 
-  void process(std::array<Sample, length> &x0)
+  void process(std::array<Sample, length> &x0, const SmootherContext<Sample> &context)
   {
-    b0.process();
-    a1.process();
+    b0.process(context);
+    a1.process(context);
     for (size_t i = 0; i < length; ++i) {
       y1[i] = b0.value[i] * (x0[i] - x1[i]) - a1.value[i] * y1[i];
       x1[i] = x0[i];
@@ -775,21 +775,25 @@ public:
     delay.setup(sampleRate, maxCombSeconds);
   }
 
-  Sample
-  process(Sample input, Sample invPitchRatio, Sample delayModIn, Sample feedbackModIn)
+  Sample process(
+    Sample input,
+    Sample invPitchRatio,
+    Sample delayModIn,
+    Sample feedbackModIn,
+    const SmootherContext<Sample> &context)
   {
-    spreadDelay.process(input);
+    spreadDelay.process(input, context);
     auto &x0 = spreadDelay.output;
 
     for (size_t i = 0; i < length; ++i) x0[i] += fbSig[i];
-    highpass.process(x0);
-    lowpass.process(x0);
+    highpass.process(x0, context);
+    lowpass.process(x0, context);
 
-    lossThreshold.process();
-    allpassMod.process();
-    allpassQ.process();
+    lossThreshold.process(context);
+    allpassMod.process(context);
+    allpassQ.process(context);
     for (size_t idx = 0; idx < nAllpass; ++idx) {
-      allpassCut[idx].process();
+      allpassCut[idx].process(context);
 
       allpass[idx].process(x0, allpassMod.value, allpassCut[idx].value, allpassQ.value);
 
@@ -799,18 +803,18 @@ public:
       }
     }
 
-    timeMod.process();
-    timeSamples.process();
+    timeMod.process(context);
+    timeSamples.process(context);
     for (size_t idx = 0; idx < length; ++idx) {
       tmp[idx] = timeSamples.value[idx] * invPitchRatio
         * std::exp2(std::min(timeMod.getValue() * (x0[idx] + delayModIn), Sample(1)));
     }
-    timeLimiter.process(tmp, timeRate.process());
+    timeLimiter.process(tmp, timeRate.process(context));
 
     fbSig = x0;
     delay.process(fbSig, timeLimiter.value);
 
-    feedbackGain.process();
+    feedbackGain.process(context);
     for (size_t idx = 0; idx < length; ++idx) {
       fbSig[idx] *= std::min(feedbackGain.value[idx] * feedbackModIn, Sample(1));
     }
@@ -63,17 +63,17 @@ public:
     lowpass.push(lowpassCutoff);
   }
 
-  Sample process(Sample freqNormalized)
+  Sample process(Sample freqNormalized, const SmootherContext<Sample> &context)
   {
     phase += freqNormalized;
     if (phase >= Sample(1)) {
       phase -= std::floor(phase);
       gain = Sample(1);
     }
-    gain *= decay.process();
+    gain *= decay.process(context);
 
     std::uniform_real_distribution<Sample> dist{Sample(-1), Sample(1)};
-    return lowpass.process(gain) * dist(rng);
+    return lowpass.process(gain, context) * dist(rng);
   }
 };
 
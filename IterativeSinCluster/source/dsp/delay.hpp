@@ -108,14 +108,15 @@ public:
     Sample feedback,
     Sample depth,
     Sample delayTimeRange,
-    Sample minDelayTime)
+    Sample minDelayTime,
+    const SmootherContext<Sample> &context)
   {
-    interpTick.push(Sample(twopi) * frequency / delay.sampleRate);
-    interpPhase.push(phase);
-    interpFeedback.push(feedback);
-    interpDepth.push(depth);
-    interpDelayTimeRange.push(delayTimeRange);
-    interpMinDelayTime.push(minDelayTime);
+    interpTick.push(Sample(twopi) * frequency / delay.sampleRate, context);
+    interpPhase.push(phase, context);
+    interpFeedback.push(feedback, context);
+    interpDepth.push(depth, context);
+    interpDelayTimeRange.push(delayTimeRange, context);
+    interpMinDelayTime.push(minDelayTime, context);
   }
 
   void reset(
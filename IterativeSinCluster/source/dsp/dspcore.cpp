@@ -189,16 +189,29 @@ template<typename Sample> std::array<Sample, 2> NOTE_NAME<Sample>::process()
   return out;
 }
 
+// Returns the number of rendered frames. Rendering stops when the note is rested.
+template<typename Sample>
+size_t NOTE_NAME<Sample>::process(size_t length, Sample *out0, Sample *out1)
+{
+  for (size_t i = 0; i < length; ++i) {
+    if (state == NoteState::rest) return i;
+    const auto frame = process();
+    out0[i] = frame[0];
+    out1[i] = frame[1];
+  }
+  return length;
+}
+
 DSPCORE_NAME::DSPCORE_NAME() { midiNotes.reserve(128); }
 
 void DSPCORE_NAME::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  midiNotes.resize(0);
+  midiNotes.clear();
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.04f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.04f);
 
   for (auto &note : notes) note.setup(this->sampleRate);
 
@@ -218,7 +231,7 @@ void DSPCORE_NAME::reset()
 {
   using ID = ParameterID::ID;
 
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
 
   interpChorusMix.reset(param.value[ID::chorusMix]->getFloat());
   interpMasterGain.reset(
@@ -258,11 +271,12 @@ void DSPCORE_NAME::setParameters()
 {
   using ID = ParameterID::ID;
 
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
 
-  interpChorusMix.push(param.value[ID::chorusMix]->getFloat());
+  interpChorusMix.push(param.value[ID::chorusMix]->getFloat(), smootherContext);
   interpMasterGain.push(
-    param.value[ID::gain]->getFloat() * param.value[ID::gainBoost]->getFloat());
+    param.value[ID::gain]->getFloat() * param.value[ID::gainBoost]->getFloat(),
+    smootherContext);
 
   nVoice = size_t(1) << param.value[ID::nVoice]->getInt();
   if (nVoice > notes.size()) nVoice = notes.size();
@@ -285,7 +299,8 @@ void DSPCORE_NAME::setParameters()
       param.value[ID::chorusDelayTimeRange0 + i]->getFloat(),
       param.value[ID::chorusKeyFollow]->getInt()
         ? 200.0f * param.value[ID::chorusMinDelayTime0 + i]->getFloat() / lastNoteFreq
-        : param.value[ID::chorusMinDelayTime0 + i]->getFloat());
+        : param.value[ID::chorusMinDelayTime0 + i]->getFloat(),
+      smootherContext);
   }
 }
 
@@ -293,45 +308,53 @@ void DSPCORE_NAME::process(const size_t length, float *out0, float *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
-
-  std::array<float, 2> frame{};
-  std::array<float, 2> chorusOut{};
-  for (uint32_t i = 0; i < length; ++i) {
-    processMidiNote(i);
-
-    frame.fill(0.0f);
-
-    for (auto &note : notes) {
-      if (note.state == NoteState::rest) continue;
-      auto noteSig = note.process();
-      frame[0] += noteSig[0];
-      frame[1] += noteSig[1];
-    }
-
-    if (isTransitioning) {
-      frame[0] += transitionBuffer[mptIndex][0];
-      frame[1] += transitionBuffer[mptIndex][1];
-      transitionBuffer[mptIndex].fill(0.0f);
-      mptIndex = (mptIndex + 1) % transitionBuffer.size();
-      if (mptIndex == mptStop) isTransitioning = false;
-    }
+  smootherContext.setBufferSize(float(length));
+
+  auto onNote = [&](MidiNote &nt) {
+    if (nt.isNoteOn)
+      noteOn(nt.id, nt.pitch, nt.tuning, nt.velocity);
+    else
+      noteOff(nt.id);
+  };
+
+  auto renderVoice = [&](auto &note, size_t frames, auto &buffer) {
+    return note.process(frames, buffer[0].data(), buffer[1].data());
+  };
+
+  auto onBlock = [&](size_t offset, size_t frames, const auto &mix) {
+    std::array<float, 2> frame{};
+    std::array<float, 2> chorusOut{};
+    for (size_t j = 0; j < frames; ++j) {
+      frame[0] = mix[0][j];
+      frame[1] = mix[1][j];
+
+      if (isTransitioning) {
+        frame[0] += transitionBuffer[mptIndex][0];
+        frame[1] += transitionBuffer[mptIndex][1];
+        transitionBuffer[mptIndex].fill(0.0f);
+        mptIndex = (mptIndex + 1) % transitionBuffer.size();
+        if (mptIndex == mptStop) isTransitioning = false;
+      }
 
-    const auto chorusIn = frame[0] + frame[1];
-    chorusOut.fill(0.0f);
-    for (auto &chrs : chorus) {
-      const auto out = chrs.process(chorusIn);
-      chorusOut[0] += out[0];
-      chorusOut[1] += out[1];
+      const auto chorusIn = frame[0] + frame[1];
+      chorusOut.fill(0.0f);
+      for (auto &chrs : chorus) {
+        const auto out = chrs.process(chorusIn);
+        chorusOut[0] += out[0];
+        chorusOut[1] += out[1];
+      }
+      chorusOut[0] /= chorus.size();
+      chorusOut[1] /= chorus.size();
+
+      const auto chorusMix = interpChorusMix.process();
+      const auto masterGain = interpMasterGain.process();
+      const size_t i = offset + j;
+      out0[i] = masterGain * (frame[0] + chorusMix * (chorusOut[0] - frame[0]));
+      out1[i] = masterGain * (frame[1] + chorusMix * (chorusOut[1] - frame[1]));
     }
-    chorusOut[0] /= chorus.size();
-    chorusOut[1] /= chorus.size();
+  };
 
-    const auto chorusMix = interpChorusMix.process();
-    const auto masterGain = interpMasterGain.process();
-    out0[i] = masterGain * (frame[0] + chorusMix * (chorusOut[0] - frame[0]));
-    out1[i] = masterGain * (frame[1] + chorusMix * (chorusOut[1] - frame[1]));
-  }
+  voiceRenderer.process(length, midiNotes, notes, onNote, renderVoice, onBlock);
 }
 
 void DSPCORE_NAME::noteOn(int32_t noteId, int16_t pitch, float tuning, float velocity)
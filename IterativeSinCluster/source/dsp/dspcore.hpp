@@ -4,7 +4,9 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/notequeue.hpp"
 #include "../../../common/dsp/smoother.hpp"
+#include "../../../common/dsp/voicerenderer.hpp"
 #include "../parameter.hpp"
 #include "delay.hpp"
 #include "envelope.hpp"
@@ -54,6 +56,7 @@ enum class NoteState { active, release, rest };
     void release();                                                                      \
     void rest();                                                                         \
     std::array<Sample, 2> process();                                                     \
+    size_t process(size_t length, Sample *out0, Sample *out1);                           \
   };
 
 class DSPInterface {
@@ -80,7 +83,7 @@ public:
     float velocity;
   };
 
-  std::vector<MidiNote> midiNotes;
+  NoteQueue<MidiNote> midiNotes;
 
   virtual void pushMidiNote(
     bool isNoteOn,
@@ -127,23 +130,17 @@ mpt stands for Max Poly Transition. I guess this sounds weird for English native
       note.pitch = pitch;                                                                \
       note.tuning = tuning;                                                              \
       note.velocity = velocity;                                                          \
-      midiNotes.push_back(note);                                                         \
+      midiNotes.push(note);                                                              \
     }                                                                                    \
                                                                                          \
     void processMidiNote(uint32_t frame) override                                        \
     {                                                                                    \
-      while (true) {                                                                     \
-        auto it                                                                          \
-          = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {   \
-              return nt.frame == frame;                                                  \
-            });                                                                          \
-        if (it == std::end(midiNotes)) return;                                           \
-        if (it->isNoteOn)                                                                \
-          noteOn(it->id, it->pitch, it->tuning, it->velocity);                           \
+      midiNotes.dispatch(frame, [&](MidiNote &nt) {                                      \
+        if (nt.isNoteOn)                                                                 \
+          noteOn(nt.id, nt.pitch, nt.tuning, nt.velocity);                               \
         else                                                                             \
-          noteOff(it->id);                                                               \
-        midiNotes.erase(it);                                                             \
-      }                                                                                  \
+          noteOff(nt.id);                                                                \
+      });                                                                                \
     }                                                                                    \
                                                                                          \
   private:                                                                               \
@@ -153,10 +150,12 @@ mpt stands for Max Poly Transition. I guess this sounds weird for English native
                                                                                          \
     size_t nVoice = 32;                                                                  \
     std::array<Note_##INSTRSET<float>, maxVoice> notes;                                  \
+    VoiceRenderer<float, 2> voiceRenderer;                                               \
     float lastNoteFreq = 1.0f;                                                           \
                                                                                          \
     std::array<Chorus<float>, 3> chorus;                                                 \
                                                                                          \
+    SmootherContext<float> smootherContext;                                              \
     LinearSmoother<float> interpChorusMix;                                               \
     LinearSmoother<float> interpMasterGain;                                              \
                                                                                          \
@@ -4,12 +4,12 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/delayline.hpp"
 #include "../../../common/dsp/smoother.hpp"
 
 #include <algorithm>
 #include <array>
 #include <climits>
-#include <vector>
 
 namespace SomeDSP {
 
@@ -17,61 +17,26 @@ namespace SomeDSP {
 template<typename Sample> class Delay {
 public:
   Sample w1 = 0;
-  Sample rFraction = 0.0;
-  int wptr = 0;
-  int rptr = 0;
-  int size = 0;
-  std::vector<Sample> buf;
+  DelayLine<Sample> line;
 
   void setup(Sample sampleRate, Sample maxTime)
   {
-    size = int(Sample(2) * sampleRate * maxTime) + 1;
-    if (size < 4) size = 4;
-
-    buf.resize(size);
-
+    line.setup(size_t(Sample(2) * sampleRate * maxTime) + 1);
     reset();
   }
 
   void reset()
   {
     w1 = 0;
-    std::fill(buf.begin(), buf.end(), Sample(0));
+    line.reset();
   }
 
   Sample process(Sample input, Sample sampleRate, Sample seconds)
   {
-    // Set delay time.
-    Sample timeInSample
-      = std::clamp<Sample>(Sample(2) * sampleRate * seconds, Sample(0), Sample(size));
-
-    int timeInt = int(timeInSample);
-    rFraction = timeInSample - Sample(timeInt);
-
-    rptr = wptr - timeInt;
-    if (rptr < 0) rptr += size;
-
-    // Write to buffer.
-    buf[wptr] = Sample(0.5) * (input + w1);
-    ++wptr;
-    if (wptr >= size) wptr -= size;
-
-    buf[wptr] = input;
-    ++wptr;
-    if (wptr >= size) wptr -= size;
-
+    line.write(Sample(0.5) * (input + w1));
+    line.write(input);
     w1 = input;
-
-    // Read from buffer.
-    const size_t i1 = rptr;
-    ++rptr;
-    if (rptr >= size) rptr -= size;
-
-    const size_t i0 = rptr;
-    ++rptr;
-    if (rptr >= size) rptr -= size;
-
-    return buf[i0] - rFraction * (buf[i0] - buf[i1]);
+    return line.readFractional(Sample(2) * sampleRate * seconds);
   }
 };
 
@@ -104,9 +69,10 @@ public:
 
 template<typename Sample, size_t nest> class NestedLongAllpass {
 public:
-  std::array<ExpSmoother<Sample>, nest> seconds{};
-  std::array<ExpSmoother<Sample>, nest> innerFeed{};
-  std::array<ExpSmoother<Sample>, nest> outerFeed{};
+  // Point to `nest` lanes of `SmootherBank`. Assigned by `DSPCore::setup`.
+  const Sample *seconds = nullptr;
+  const Sample *innerFeed = nullptr;
+  const Sample *outerFeed = nullptr;
 
   std::array<Sample, nest> in{};
   std::array<Sample, nest> buffer{};
@@ -127,15 +93,15 @@ public:
   Sample process(Sample input, Sample sampleRate)
   {
     for (size_t idx = 0; idx < nest; ++idx) {
-      input -= outerFeed[idx].process() * buffer[idx];
+      input -= outerFeed[idx] * buffer[idx];
       in[idx] = input;
     }
 
     Sample out = in.back();
     for (size_t idx = nest - 1; idx != size_t(-1); --idx) {
-      auto apOut = allpass[idx].process(
-        out, sampleRate, seconds[idx].process(), innerFeed[idx].process());
-      out = buffer[idx] + outerFeed[idx].getValue() * in[idx];
+      auto apOut
+        = allpass[idx].process(out, sampleRate, seconds[idx], innerFeed[idx]);
+      out = buffer[idx] + outerFeed[idx] * in[idx];
       buffer[idx] = apOut;
     }
 
@@ -147,7 +113,7 @@ template<typename Sample, size_t nSection1, size_t nest> class NestD2 {
 public:
   std::array<Sample, nest> in{};
   std::array<Sample, nest> buffer{};
-  std::array<ExpSmoother<Sample>, nest> feed;
+  const Sample *feed = nullptr;
   std::array<NestedLongAllpass<Sample, nSection1>, nest> allpass;
 
   void setup(Sample sampleRate, Sample maxTime)
@@ -165,14 +131,14 @@ public:
   Sample process(Sample input, Sample sampleRate)
   {
     for (size_t idx = 0; idx < nest; ++idx) {
-      input -= feed[idx].process() * buffer[idx];
+      input -= feed[idx] * buffer[idx];
       in[idx] = input;
     }
 
     Sample out = in.back();
     for (size_t idx = nest - 1; idx != size_t(-1); --idx) {
       auto apOut = allpass[idx].process(out, sampleRate);
-      out = buffer[idx] + feed[idx].getValue() * in[idx];
+      out = buffer[idx] + feed[idx] * in[idx];
       buffer[idx] = apOut;
     }
 
@@ -184,7 +150,7 @@ template<typename Sample, size_t nSection1, size_t nSection2, size_t nest> class
 public:
   std::array<Sample, nest> in{};
   std::array<Sample, nest> buffer{};
-  std::array<ExpSmoother<Sample>, nest> feed;
+  const Sample *feed = nullptr;
   std::array<NestD2<Sample, nSection1, nSection2>, nest> allpass;
 
   void setup(Sample sampleRate, Sample maxTime)
@@ -202,14 +168,14 @@ public:
   Sample process(Sample input, Sample sampleRate)
   {
     for (size_t idx = 0; idx < nest; ++idx) {
-      input -= feed[idx].process() * buffer[idx];
+      input -= feed[idx] * buffer[idx];
       in[idx] = input;
     }
 
     Sample out = in.back();
     for (size_t idx = nest - 1; idx != size_t(-1); --idx) {
       auto apOut = allpass[idx].process(out, sampleRate);
-      out = buffer[idx] + feed[idx].getValue() * in[idx];
+      out = buffer[idx] + feed[idx] * in[idx];
       buffer[idx] = apOut;
     }
 
@@ -227,7 +193,7 @@ class NestD4 {
 public:
   std::array<Sample, nest> in{};
   std::array<Sample, nest> buffer{};
-  std::array<ExpSmoother<Sample>, nest> feed;
+  const Sample *feed = nullptr;
   std::array<NestD3<Sample, nSection1, nSection2, nSection3>, nest> allpass;
 
   void setup(Sample sampleRate, Sample maxTime)
@@ -245,14 +211,14 @@ public:
   Sample process(Sample input, Sample sampleRate)
   {
     for (size_t idx = 0; idx < nest; ++idx) {
-      input -= feed[idx].process() * buffer[idx];
+      input -= feed[idx] * buffer[idx];
       in[idx] = input;
     }
 
     Sample out = in.back();
     for (size_t idx = nest - 1; idx != size_t(-1); --idx) {
       auto apOut = allpass[idx].process(out, sampleRate);
-      out = buffer[idx] + feed[idx].getValue() * in[idx];
+      out = buffer[idx] + feed[idx] * in[idx];
       buffer[idx] = apOut;
     }
 
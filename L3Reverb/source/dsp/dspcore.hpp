@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/notequeue.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 
@@ -56,29 +57,25 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    midiNotes.dispatch(frame, [&](NoteInfo &nt) {
+      if (nt.isNoteOn)
+        noteOn(nt);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
-    }
+        noteOff(nt.id);
+    });
   }
 
 private:
   void refreshSeed();
   void updateDelayTime();
+  void assignSmootherLanes();
 
-  std::vector<NoteInfo> midiNotes;
+  NoteQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
   float notePitchMultiplier = float(1);
 
@@ -99,6 +96,15 @@ private:
 
   std::array<NestD4<float, nSection1, nSection2, nSection3, nSection4>, 2> delay;
   std::array<float, 2> delayOut{};
+
+  // Lanes are `[left, right]`. Each half follows the order of `ParameterID`.
+  SmootherContext<float> smootherContext;
+  SmootherBank<float, 2 * nDepth1> interpSeconds;
+  SmootherBank<float, 2 * nDepth1> interpInnerFeed;
+  SmootherBank<float, 2 * nDepth1> interpD1Feed;
+  SmootherBank<float, 2 * nDepth2> interpD2Feed;
+  SmootherBank<float, 2 * nDepth3> interpD3Feed;
+  SmootherBank<float, 2 * nDepth4> interpD4Feed;
   ExpSmoother<float> interpStereoCross;
   ExpSmoother<float> interpStereoSpread;
   ExpSmoother<float> interpDry;
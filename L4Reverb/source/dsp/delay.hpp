@@ -3,13 +3,14 @@
 
 #pragma once
 
+#include "../../../common/dsp/arena.hpp"
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/delayline.hpp"
 #include "../../../common/dsp/smoother.hpp"
 
 #include <algorithm>
 #include <array>
 #include <climits>
-#include <vector>
 
 namespace SomeDSP {
 
@@ -17,61 +18,36 @@ namespace SomeDSP {
 template<typename Sample> class Delay {
 public:
   Sample w1 = 0;
-  Sample rFraction = 0.0;
-  int wptr = 0;
-  int rptr = 0;
-  int size = 0;
-  std::vector<Sample> buf;
+  DelayLine<Sample> line;
 
-  void setup(Sample sampleRate, Sample maxTime)
+  static size_t maxFrames(Sample sampleRate, Sample maxTime)
   {
-    size = int(Sample(2) * sampleRate * maxTime) + 1;
-    if (size < 4) size = 4;
+    return size_t(Sample(2) * sampleRate * maxTime) + 1;
+  }
 
-    buf.resize(size);
+  static size_t bufferBytes(Sample sampleRate, Sample maxTime)
+  {
+    return DelayLine<Sample>::bufferBytes(maxFrames(sampleRate, maxTime));
+  }
 
+  void setup(Arena &arena, Sample sampleRate, Sample maxTime)
+  {
+    line.setup(arena, maxFrames(sampleRate, maxTime));
     reset();
   }
 
   void reset()
   {
     w1 = 0;
-    std::fill(buf.begin(), buf.end(), Sample(0));
+    line.reset();
   }
 
   Sample process(Sample input, Sample sampleRate, Sample seconds)
   {
-    // Set delay time.
-    Sample timeInSample
-      = std::clamp<Sample>(Sample(2) * sampleRate * seconds, Sample(0), Sample(size));
-
-    int timeInt = int(timeInSample);
-    rFraction = timeInSample - Sample(timeInt);
-
-    rptr = wptr - timeInt;
-    if (rptr < 0) rptr += size;
-
-    // Write to buffer.
-    buf[wptr] = Sample(0.5) * (input + w1);
-    ++wptr;
-    if (wptr >= size) wptr -= size;
-
-    buf[wptr] = input;
-    ++wptr;
-    if (wptr >= size) wptr -= size;
-
+    line.write(Sample(0.5) * (input + w1));
+    line.write(input);
     w1 = input;
-
-    // Read from buffer.
-    const size_t i1 = rptr;
-    ++rptr;
-    if (rptr >= size) rptr -= size;
-
-    const size_t i0 = rptr;
-    ++rptr;
-    if (rptr >= size) rptr -= size;
-
-    return buf[i0] - rFraction * (buf[i0] - buf[i1]);
+    return line.readFractional(Sample(2) * sampleRate * seconds);
   }
 };
 
@@ -84,7 +60,10 @@ public:
   Sample buffer = 0;
   Delay<Sample> delay;
 
-  void setup(Sample sampleRate, Sample maxTime) { delay.setup(sampleRate, maxTime); }
+  void setup(Arena &arena, Sample sampleRate, Sample maxTime)
+  {
+    delay.setup(arena, sampleRate, maxTime);
+  }
 
   void reset()
   {
@@ -104,17 +83,18 @@ public:
 
 template<typename Sample, size_t nest> class NestedLongAllpass {
 public:
-  std::array<ExpSmoother<Sample>, nest> seconds{};
-  std::array<ExpSmoother<Sample>, nest> innerFeed{};
-  std::array<ExpSmoother<Sample>, nest> outerFeed{};
+  // Point to `nest` lanes of `SmootherBank`. Assigned by `DSPCore::setup`.
+  const Sample *seconds = nullptr;
+  const Sample *innerFeed = nullptr;
+  const Sample *outerFeed = nullptr;
 
   std::array<Sample, nest> in{};
   std::array<Sample, nest> buffer{};
   std::array<LongAllpass<Sample>, nest> allpass;
 
-  void setup(Sample sampleRate, Sample maxTime)
+  void setup(Arena &arena, Sample sampleRate, Sample maxTime)
   {
-    for (auto &ap : allpass) ap.setup(sampleRate, maxTime);
+    for (auto &ap : allpass) ap.setup(arena, sampleRate, maxTime);
   }
 
   void reset()
@@ -127,15 +107,15 @@ public:
   Sample process(Sample input, Sample sampleRate)
   {
     for (size_t idx = 0; idx < nest; ++idx) {
-      input -= outerFeed[idx].process() * buffer[idx];
+      input -= outerFeed[idx] * buffer[idx];
       in[idx] = input;
     }
 
     Sample out = in.back();
     for (size_t idx = nest - 1; idx != size_t(-1); --idx) {
-      auto apOut = allpass[idx].process(
-        out, sampleRate, seconds[idx].process(), innerFeed[idx].process());
-      out = buffer[idx] + outerFeed[idx].getValue() * in[idx];
+      auto apOut
+        = allpass[idx].process(out, sampleRate, seconds[idx], innerFeed[idx]);
+      out = buffer[idx] + outerFeed[idx] * in[idx];
       buffer[idx] = apOut;
     }
 
@@ -148,12 +128,12 @@ public:
   public:                                                                                \
     std::array<Sample, nest> in{};                                                       \
     std::array<Sample, nest> buffer{};                                                   \
-    std::array<ExpSmoother<Sample>, nest> feed;                                          \
+    const Sample *feed = nullptr;                                                        \
     std::array<CHILD<Sample, nest>, nest> allpass;                                       \
                                                                                          \
-    void setup(Sample sampleRate, Sample maxTime)                                        \
+    void setup(Arena &arena, Sample sampleRate, Sample maxTime)                          \
     {                                                                                    \
-      for (auto &ap : allpass) ap.setup(sampleRate, maxTime);                            \
+      for (auto &ap : allpass) ap.setup(arena, sampleRate, maxTime);                     \
     }                                                                                    \
                                                                                          \
     void reset()                                                                         \
@@ -166,14 +146,14 @@ public:
     Sample process(Sample input, Sample sampleRate)                                      \
     {                                                                                    \
       for (size_t idx = 0; idx < nest; ++idx) {                                          \
-        input -= feed[idx].process() * buffer[idx];                                      \
+        input -= feed[idx] * buffer[idx];                                                \
         in[idx] = input;                                                                 \
       }                                                                                  \
                                                                                          \
       Sample out = in.back();                                                            \
       for (size_t idx = nest - 1; idx != size_t(-1); --idx) {                            \
         auto apOut = allpass[idx].process(out, sampleRate);                              \
-        out = buffer[idx] + feed[idx].getValue() * in[idx];                              \
+        out = buffer[idx] + feed[idx] * in[idx];                                         \
         buffer[idx] = apOut;                                                             \
       }                                                                                  \
                                                                                          \
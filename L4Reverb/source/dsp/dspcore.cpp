@@ -9,10 +9,15 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
 
-  for (auto &dly : delay) dly.setup(this->sampleRate, float(Scales::time.getMax()));
+  // All delay lines are sliced from `arena`. Allocation only happens when sample rate
+  // goes up, so `setActive` with the same sample rate doesn't touch the heap.
+  const float maxTime = float(Scales::time.getMax());
+  arena.reserve(2 * nDepth1 * Delay<float>::bufferBytes(this->sampleRate, maxTime));
+  for (auto &dly : delay) dly.setup(arena, this->sampleRate, maxTime);
+  assignSmootherLanes();
 
   reset();
 }
@@ -56,59 +61,48 @@ template<typename T> inline T calcNotePitch(T note)
   uint16_t i3 = 0;                                                                       \
   uint16_t i4 = 0;                                                                       \
                                                                                          \
-  auto &ap4L = delay[0];                                                                 \
-  auto &ap4R = delay[1];                                                                 \
   for (uint8_t d4 = 0; d4 < nDepth; ++d4) {                                              \
-    auto &ap3L = ap4L.allpass[d4];                                                       \
-    auto &ap3R = ap4R.allpass[d4];                                                       \
     for (uint8_t d3 = 0; d3 < nDepth; ++d3) {                                            \
-      auto &ap2L = ap3L.allpass[d3];                                                     \
-      auto &ap2R = ap3R.allpass[d3];                                                     \
       for (uint8_t d2 = 0; d2 < nDepth; ++d2) {                                          \
-        auto &ap1L = ap2L.allpass[d2];                                                   \
-        auto &ap1R = ap2R.allpass[d2];                                                   \
         for (uint8_t d1 = 0; d1 < nDepth; ++d1) {                                        \
           auto d1TimeOffset = calcOffset(timeOffsetDist(timeRng), timeMul);              \
           auto innerFeedOffset = calcOffset(innerOffsetDist(innerRng), innerMul);        \
           auto d1FeedOffset = calcOffset(d1FeedOffsetDist(d1FeedRng), d1FeedMul);        \
                                                                                          \
-          ap1L.seconds[d1].METHOD(                                                       \
-            param.value[ID::time0 + i1]->getFloat() * d1TimeOffset[0]);                  \
-          ap1L.innerFeed[d1].METHOD(                                                     \
-            param.value[ID::innerFeed0 + i1]->getFloat() * innerFeedOffset[0]);          \
-          ap1L.outerFeed[d1].METHOD(                                                     \
-            param.value[ID::d1Feed0 + i1]->getFloat() * d1FeedOffset[0]);                \
-                                                                                         \
-          ap1R.seconds[d1].METHOD(                                                       \
-            param.value[ID::time0 + i1]->getFloat() * d1TimeOffset[1]);                  \
-          ap1R.innerFeed[d1].METHOD(                                                     \
-            param.value[ID::innerFeed0 + i1]->getFloat() * innerFeedOffset[1]);          \
-          ap1R.outerFeed[d1].METHOD(                                                     \
-            param.value[ID::d1Feed0 + i1]->getFloat() * d1FeedOffset[1]);                \
+          auto time = param.value[ID::time0 + i1]->getFloat();                           \
+          auto innerFeed = param.value[ID::innerFeed0 + i1]->getFloat();                 \
+          auto d1Feed = param.value[ID::d1Feed0 + i1]->getFloat();                       \
+          interpSeconds.METHOD##At(i1, time * d1TimeOffset[0]);                          \
+          interpInnerFeed.METHOD##At(i1, innerFeed * innerFeedOffset[0]);                \
+          interpD1Feed.METHOD##At(i1, d1Feed * d1FeedOffset[0]);                         \
+          interpSeconds.METHOD##At(nDepth1 + i1, time * d1TimeOffset[1]);                \
+          interpInnerFeed.METHOD##At(nDepth1 + i1, innerFeed * innerFeedOffset[1]);      \
+          interpD1Feed.METHOD##At(nDepth1 + i1, d1Feed * d1FeedOffset[1]);               \
                                                                                          \
           ++i1;                                                                          \
         }                                                                                \
                                                                                          \
         auto offsetD2Feed = calcOffset(d2FeedOffsetDist(d2FeedRng), d2FeedMul);          \
                                                                                          \
-        ap2L.feed[d2].METHOD(                                                            \
-          param.value[ID::d2Feed0 + i2]->getFloat() * offsetD2Feed[0]);                  \
-        ap2R.feed[d2].METHOD(                                                            \
-          param.value[ID::d2Feed0 + i2]->getFloat() * offsetD2Feed[1]);                  \
+        auto d2Feed = param.value[ID::d2Feed0 + i2]->getFloat();                         \
+        interpD2Feed.METHOD##At(i2, d2Feed * offsetD2Feed[0]);                           \
+        interpD2Feed.METHOD##At(nDepth2 + i2, d2Feed * offsetD2Feed[1]);                 \
         ++i2;                                                                            \
       }                                                                                  \
                                                                                          \
       auto offsetD3Feed = calcOffset(d3FeedOffsetDist(d3FeedRng), d3FeedMul);            \
                                                                                          \
-      ap3L.feed[d3].METHOD(param.value[ID::d3Feed0 + i3]->getFloat() * offsetD3Feed[0]); \
-      ap3R.feed[d3].METHOD(param.value[ID::d3Feed0 + i3]->getFloat() * offsetD3Feed[1]); \
+      auto d3Feed = param.value[ID::d3Feed0 + i3]->getFloat();                           \
+      interpD3Feed.METHOD##At(i3, d3Feed * offsetD3Feed[0]);                             \
+      interpD3Feed.METHOD##At(nDepth3 + i3, d3Feed * offsetD3Feed[1]);                   \
       ++i3;                                                                              \
     }                                                                                    \
                                                                                          \
     auto offsetD4Feed = calcOffset(d4FeedOffsetDist(d4FeedRng), d4FeedMul);              \
                                                                                          \
-    ap4L.feed[d4].METHOD(param.value[ID::d4Feed0 + i4]->getFloat() * offsetD4Feed[0]);   \
-    ap4R.feed[d4].METHOD(param.value[ID::d4Feed0 + i4]->getFloat() * offsetD4Feed[1]);   \
+    auto d4Feed = param.value[ID::d4Feed0 + i4]->getFloat();                             \
+    interpD4Feed.METHOD##At(i4, d4Feed * offsetD4Feed[0]);                               \
+    interpD4Feed.METHOD##At(nDepth4 + i4, d4Feed * offsetD4Feed[1]);                     \
     ++i4;                                                                                \
   }                                                                                      \
                                                                                          \
@@ -149,7 +143,7 @@ void DSPCore::setParameters()
 {
   using ID = ParameterID::ID;
 
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
 
   refreshSeed();
 
@@ -168,23 +162,30 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   for (size_t i = 0; i < length; ++i) {
     processMidiNote(i);
 
-    const auto cross = interpStereoCross.process();
+    interpSeconds.process(smootherContext);
+    interpInnerFeed.process(smootherContext);
+    interpD1Feed.process(smootherContext);
+    interpD2Feed.process(smootherContext);
+    interpD3Feed.process(smootherContext);
+    interpD4Feed.process(smootherContext);
+
+    const auto cross = interpStereoCross.process(smootherContext);
     delayOut[0] = delay[0].process(in0[i] + cross * delayOut[1], sampleRate);
     delayOut[1] = delay[1].process(in1[i] + cross * delayOut[0], sampleRate);
     const auto mid = delayOut[0] + delayOut[1];
     const auto side = delayOut[0] - delayOut[1];
 
-    const auto spread = interpStereoSpread.process();
+    const auto spread = interpStereoSpread.process(smootherContext);
     delayOut[0] = mid - spread * (mid - side);
     delayOut[1] = mid - spread * (mid + side);
 
-    const auto dry = interpDry.process();
-    const auto wet = interpWet.process();
+    const auto dry = interpDry.process(smootherContext);
+    const auto wet = interpWet.process(smootherContext);
     out0[i] = dry * in0[i] + wet * delayOut[0];
     out1[i] = dry * in1[i] + wet * delayOut[1];
   }
@@ -238,36 +239,37 @@ void DSPCore::updateDelayTime()
 
   std::uniform_real_distribution<float> timeOffsetDist(-timeOfs, timeOfs);
 
-  uint16_t i1 = 0;
-  uint16_t i2 = 0;
-  uint16_t i3 = 0;
-  uint16_t i4 = 0;
-
-  auto &ap4L = delay[0];
-  auto &ap4R = delay[1];
-  for (uint8_t d4 = 0; d4 < nDepth; ++d4) {
-    auto &ap3L = ap4L.allpass[d4];
-    auto &ap3R = ap4R.allpass[d4];
-    for (uint8_t d3 = 0; d3 < nDepth; ++d3) {
-      auto &ap2L = ap3L.allpass[d3];
-      auto &ap2R = ap3R.allpass[d3];
-      for (uint8_t d2 = 0; d2 < nDepth; ++d2) {
-        auto &ap1L = ap2L.allpass[d2];
-        auto &ap1R = ap2R.allpass[d2];
-        for (uint8_t d1 = 0; d1 < nDepth; ++d1) {
-          auto d1TimeOffset = calcOffset(timeOffsetDist(timeRng), timeMul);
-
-          ap1L.seconds[d1].push(
-            param.value[ID::time0 + i1]->getFloat() * d1TimeOffset[0]);
-          ap1R.seconds[d1].push(
-            param.value[ID::time0 + i1]->getFloat() * d1TimeOffset[1]);
-
-          ++i1;
+  // Same order of `timeRng` calls as `ASSIGN_ALLPASS_PARAMETER`.
+  for (uint16_t i1 = 0; i1 < nDepth1; ++i1) {
+    auto d1TimeOffset = calcOffset(timeOffsetDist(timeRng), timeMul);
+    auto time = param.value[ID::time0 + i1]->getFloat();
+    interpSeconds.pushAt(i1, time * d1TimeOffset[0]);
+    interpSeconds.pushAt(nDepth1 + i1, time * d1TimeOffset[1]);
+  }
+}
+
+void DSPCore::assignSmootherLanes()
+{
+  size_t i1 = 0;
+  size_t i2 = 0;
+  size_t i3 = 0;
+  size_t i4 = 0;
+  for (auto &ap4 : delay) {
+    ap4.feed = interpD4Feed.value.data() + i4;
+    i4 += ap4.allpass.size();
+    for (auto &ap3 : ap4.allpass) {
+      ap3.feed = interpD3Feed.value.data() + i3;
+      i3 += ap3.allpass.size();
+      for (auto &ap2 : ap3.allpass) {
+        ap2.feed = interpD2Feed.value.data() + i2;
+        i2 += ap2.allpass.size();
+        for (auto &ap1 : ap2.allpass) {
+          ap1.seconds = interpSeconds.value.data() + i1;
+          ap1.innerFeed = interpInnerFeed.value.data() + i1;
+          ap1.outerFeed = interpD1Feed.value.data() + i1;
+          i1 += ap1.allpass.size();
         }
-        ++i2;
       }
-      ++i3;
     }
-    ++i4;
   }
 }
@@ -6,9 +6,9 @@
 #include <algorithm>
 #include <array>
 #include <climits>
-#include <vector>
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/delayline.hpp"
 #include "../../../common/dsp/smoother.hpp"
 
 namespace SomeDSP {
@@ -17,61 +17,26 @@ namespace SomeDSP {
 template<typename Sample> class Delay {
 public:
   Sample w1 = 0;
-  Sample rFraction = 0.0;
-  int wptr = 0;
-  int rptr = 0;
-  int size = 0;
-  std::vector<Sample> buf;
+  DelayLine<Sample> line;
 
   void setup(Sample sampleRate, Sample maxTime)
   {
-    size = int(Sample(2) * sampleRate * maxTime) + 1;
-    if (size < 4) size = 4;
-
-    buf.resize(size);
-
+    line.setup(size_t(Sample(2) * sampleRate * maxTime) + 1);
     reset();
   }
 
   void reset()
   {
     w1 = 0;
-    std::fill(buf.begin(), buf.end(), Sample(0));
+    line.reset();
   }
 
   Sample process(Sample input, Sample sampleRate, Sample seconds)
   {
-    // Set delay time.
-    Sample timeInSample
-      = std::clamp<Sample>(Sample(2) * sampleRate * seconds, Sample(0), Sample(size));
-
-    int timeInt = int(timeInSample);
-    rFraction = timeInSample - Sample(timeInt);
-
-    rptr = wptr - timeInt;
-    if (rptr < 0) rptr += size;
-
-    // Write to buffer.
-    buf[wptr] = input - Sample(0.5) * (input - w1);
-    ++wptr;
-    if (wptr >= size) wptr -= size;
-
-    buf[wptr] = input;
-    ++wptr;
-    if (wptr >= size) wptr -= size;
-
+    line.write(input - Sample(0.5) * (input - w1));
+    line.write(input);
     w1 = input;
-
-    // Read from buffer.
-    const size_t i1 = rptr;
-    ++rptr;
-    if (rptr >= size) rptr -= size;
-
-    const size_t i0 = rptr;
-    ++rptr;
-    if (rptr >= size) rptr -= size;
-
-    return buf[i0] - rFraction * (buf[i0] - buf[i1]);
+    return line.readFractional(Sample(2) * sampleRate * seconds);
   }
 };
 
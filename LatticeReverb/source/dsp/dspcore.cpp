@@ -9,8 +9,8 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
 
   delay.setup(this->sampleRate, float(Scales::time.getMax()));
 
@@ -51,26 +51,26 @@ void DSPCore::reset()
     lowpassLfoTime[1][idx].kp = timeLfoLowpassKp;
     lowpassLfoTime[0][idx].reset(dist(rng));
     lowpassLfoTime[1][idx].reset(dist(rng));
-    interpTime[0][idx].push(std::clamp<float>(
+    interpTime.pushAt(idx, std::clamp<float>(
       timeOffset[0] * timeMul * time + timeLfo * lowpassLfoTime[0][idx].value, 0.0f,
       1.0f));
-    interpTime[1][idx].push(std::clamp<float>(
+    interpTime.pushAt(nestingDepth + idx, std::clamp<float>(
       timeOffset[1] * timeMul * time + timeLfo * lowpassLfoTime[1][idx].value, 0.0f,
       1.0f));
 
     auto outerOffset
       = calcOffset(param.value[ID::outerFeedOffset0 + idx]->getFloat(), outerOffsetMul);
     auto outerFeed = param.value[ID::outerFeed0 + idx]->getFloat();
-    interpOuterFeed[0][idx].reset(outerOffset[0] * outerMul * outerFeed);
-    interpOuterFeed[1][idx].reset(outerOffset[1] * outerMul * outerFeed);
+    interpOuterFeed.resetAt(idx, outerOffset[0] * outerMul * outerFeed);
+    interpOuterFeed.resetAt(nestingDepth + idx, outerOffset[1] * outerMul * outerFeed);
 
     auto innerOffset
       = calcOffset(param.value[ID::innerFeedOffset0 + idx]->getFloat(), innerOffsetMul);
     auto innerFeed = param.value[ID::innerFeed0 + idx]->getFloat();
-    interpInnerFeed[0][idx].reset(innerOffset[0] * innerMul * innerFeed);
-    interpInnerFeed[1][idx].reset(innerOffset[1] * innerMul * innerFeed);
+    interpInnerFeed.resetAt(idx, innerOffset[0] * innerMul * innerFeed);
+    interpInnerFeed.resetAt(nestingDepth + idx, innerOffset[1] * innerMul * innerFeed);
 
-    interpLowpassCutoff[idx].reset(param.value[ID::lowpassCutoff0 + idx]->getFloat());
+    interpLowpassCutoff.resetAt(idx, param.value[ID::lowpassCutoff0 + idx]->getFloat());
   }
   interpStereoCross.reset(param.value[ID::stereoCross]->getFloat());
   interpStereoSpread.reset(param.value[ID::stereoSpread]->getFloat());
@@ -84,7 +84,7 @@ void DSPCore::setParameters()
 {
   using ID = ParameterID::ID;
 
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
 
   auto timeMul = notePitchMultiplier * param.value[ID::timeMultiply]->getFloat();
   auto outerMul = param.value[ID::outerFeedMultiply]->getFloat();
@@ -102,11 +102,11 @@ void DSPCore::setParameters()
     auto timeLfo = param.value[ID::timeLfoAmount0 + idx]->getFloat();
     lowpassLfoTime[0][idx].kp = timeLfoLowpassKp;
     lowpassLfoTime[1][idx].kp = timeLfoLowpassKp;
-    interpTime[0][idx].push(std::clamp<float>(
+    interpTime.pushAt(idx, std::clamp<float>(
       timeOffset[0] * timeMul * time
         + timeLfo * lowpassLfoTime[0][idx].process(dist(rng)),
       0.0f, 1.0f));
-    interpTime[1][idx].push(std::clamp<float>(
+    interpTime.pushAt(nestingDepth + idx, std::clamp<float>(
       timeOffset[1] * timeMul * time
         + timeLfo * lowpassLfoTime[1][idx].process(dist(rng)),
       0.0f, 1.0f));
@@ -114,16 +114,16 @@ void DSPCore::setParameters()
     auto outerOffset
       = calcOffset(param.value[ID::outerFeedOffset0 + idx]->getFloat(), outerOffsetMul);
     auto outerFeed = param.value[ID::outerFeed0 + idx]->getFloat();
-    interpOuterFeed[0][idx].push(outerOffset[0] * outerMul * outerFeed);
-    interpOuterFeed[1][idx].push(outerOffset[1] * outerMul * outerFeed);
+    interpOuterFeed.pushAt(idx, outerOffset[0] * outerMul * outerFeed);
+    interpOuterFeed.pushAt(nestingDepth + idx, outerOffset[1] * outerMul * outerFeed);
 
     auto innerOffset
       = calcOffset(param.value[ID::innerFeedOffset0 + idx]->getFloat(), innerOffsetMul);
     auto innerFeed = param.value[ID::innerFeed0 + idx]->getFloat();
-    interpInnerFeed[0][idx].push(innerOffset[0] * innerMul * innerFeed);
-    interpInnerFeed[1][idx].push(innerOffset[1] * innerMul * innerFeed);
+    interpInnerFeed.pushAt(idx, innerOffset[0] * innerMul * innerFeed);
+    interpInnerFeed.pushAt(nestingDepth + idx, innerOffset[1] * innerMul * innerFeed);
 
-    interpLowpassCutoff[idx].push(param.value[ID::lowpassCutoff0 + idx]->getFloat());
+    interpLowpassCutoff.pushAt(idx, param.value[ID::lowpassCutoff0 + idx]->getFloat());
   }
   interpStereoCross.push(param.value[ID::stereoCross]->getFloat());
   interpStereoSpread.push(param.value[ID::stereoSpread]->getFloat());
@@ -136,36 +136,41 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   for (size_t i = 0; i < length; ++i) {
     processMidiNote(i);
 
+    interpTime.process(smootherContext);
+    interpOuterFeed.process(smootherContext);
+    interpInnerFeed.process(smootherContext);
+    interpLowpassCutoff.process(smootherContext);
     for (size_t idx = 0; idx < nestingDepth; ++idx) {
-      auto lpCut = interpLowpassCutoff[idx].process();
+      auto lpCut = interpLowpassCutoff.value[idx];
 
-      delay.apL.data[idx].seconds = interpTime[0][idx].process();
-      delay.apL.data[idx].outerFeed = interpOuterFeed[0][idx].process();
-      delay.apL.data[idx].innerFeed = interpInnerFeed[0][idx].process();
+      delay.apL.data[idx].seconds = interpTime.value[idx];
+      delay.apL.data[idx].outerFeed = interpOuterFeed.value[idx];
+      delay.apL.data[idx].innerFeed = interpInnerFeed.value[idx];
       delay.apL.data[idx].lowpassKp = lpCut;
 
-      delay.apR.data[idx].seconds = interpTime[1][idx].process();
-      delay.apR.data[idx].outerFeed = interpOuterFeed[1][idx].process();
-      delay.apR.data[idx].innerFeed = interpInnerFeed[1][idx].process();
+      const auto idxR = nestingDepth + idx;
+      delay.apR.data[idx].seconds = interpTime.value[idxR];
+      delay.apR.data[idx].outerFeed = interpOuterFeed.value[idxR];
+      delay.apR.data[idx].innerFeed = interpInnerFeed.value[idxR];
       delay.apR.data[idx].lowpassKp = lpCut;
     }
 
-    auto delayOut
-      = delay.process(in0[i], in1[i], sampleRate, interpStereoCross.process());
+    const auto cross = interpStereoCross.process(smootherContext);
+    auto delayOut = delay.process(in0[i], in1[i], sampleRate, cross);
     const auto mid = delayOut[0] + delayOut[1];
     const auto side = delayOut[0] - delayOut[1];
 
-    const auto spread = interpStereoSpread.process();
+    const auto spread = interpStereoSpread.process(smootherContext);
     delayOut[0] = mid - spread * (mid - side);
     delayOut[1] = mid - spread * (mid + side);
 
-    const auto dry = interpDry.process();
-    const auto wet = interpWet.process();
+    const auto dry = interpDry.process(smootherContext);
+    const auto wet = interpWet.process(smootherContext);
     out0[i] = dry * in0[i] + wet * delayOut[0];
     out1[i] = dry * in1[i] + wet * delayOut[1];
   }
@@ -217,11 +222,11 @@ void DSPCore::updateDelayTime()
     auto timeLfo = param.value[ID::timeLfoAmount0 + idx]->getFloat();
     lowpassLfoTime[0][idx].kp = timeLfoLowpassKp;
     lowpassLfoTime[1][idx].kp = timeLfoLowpassKp;
-    interpTime[0][idx].push(std::clamp<float>(
+    interpTime.pushAt(idx, std::clamp<float>(
       timeOffset[0] * timeMul * time
         + timeLfo * lowpassLfoTime[0][idx].process(dist(rng)),
       0.0f, 1.0f));
-    interpTime[1][idx].push(std::clamp<float>(
+    interpTime.pushAt(nestingDepth + idx, std::clamp<float>(
       timeOffset[1] * timeMul * time
         + timeLfo * lowpassLfoTime[1][idx].process(dist(rng)),
       0.0f, 1.0f));
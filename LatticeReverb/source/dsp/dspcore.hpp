@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/notequeue.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 
@@ -56,28 +57,23 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    midiNotes.dispatch(frame, [&](NoteInfo &nt) {
+      if (nt.isNoteOn)
+        noteOn(nt);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
-    }
+        noteOff(nt.id);
+    });
   }
 
 private:
   void updateDelayTime();
 
-  std::vector<NoteInfo> midiNotes;
+  NoteQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
   float notePitchMultiplier = float(1);
 
@@ -87,10 +83,13 @@ private:
   std::array<std::array<EMAFilter<float>, nestingDepth>, 2> lowpassLfoTime;
 
   StereoLongAllpass<float, nestingDepth> delay;
-  std::array<std::array<ExpSmoother<float>, nestingDepth>, 2> interpTime;
-  std::array<std::array<ExpSmoother<float>, nestingDepth>, 2> interpOuterFeed;
-  std::array<std::array<ExpSmoother<float>, nestingDepth>, 2> interpInnerFeed;
-  std::array<ExpSmoother<float>, nestingDepth> interpLowpassCutoff;
+
+  // Lanes are `[left, right]`.
+  SmootherContext<float> smootherContext;
+  SmootherBank<float, 2 * nestingDepth> interpTime;
+  SmootherBank<float, 2 * nestingDepth> interpOuterFeed;
+  SmootherBank<float, 2 * nestingDepth> interpInnerFeed;
+  SmootherBank<float, nestingDepth> interpLowpassCutoff;
   ExpSmoother<float> interpStereoCross;
   ExpSmoother<float> interpStereoSpread;
   ExpSmoother<float> interpDry;
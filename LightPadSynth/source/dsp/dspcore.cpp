@@ -34,7 +34,8 @@ void Note::noteOn(
   float sampleRate,
   Wavetable &wavetable,
   NoteProcessInfo &info,
-  GlobalParameter &param)
+  GlobalParameter &param,
+  const SmootherContext<float> &context)
 {
   using ID = ParameterID::ID;
 
@@ -70,11 +71,11 @@ void Note::noteOn(
   gainEnvelope.reset(
     sampleRate, param.value[ID::gainA]->getFloat(), param.value[ID::gainD]->getFloat(),
     param.value[ID::gainS]->getFloat(), param.value[ID::gainR]->getFloat(),
-    param.value[ID::gainCurve]->getFloat(), noteFreq);
+    param.value[ID::gainCurve]->getFloat(), noteFreq, context);
   filterEnvelope.reset(
     sampleRate, param.value[ID::filterA]->getFloat(),
     param.value[ID::filterD]->getFloat(), param.value[ID::filterS]->getFloat(),
-    param.value[ID::filterR]->getFloat(), noteFreq);
+    param.value[ID::filterR]->getFloat(), noteFreq, context);
   delayGate.reset(sampleRate, param.value[ID::delayAttack]->getFloat(), noteFreq);
 }
 
@@ -98,26 +99,26 @@ bool Note::isAttacking() { return gainEnvelope.isAttacking(); }
 float Note::getGain() { return gain; }
 
 std::array<float, 2>
-Note::process(float sampleRate, Wavetable &wavetable, NoteProcessInfo &info)
+Note::process(float sampleRate, Wavetable &wavetable, const NoteProcessFrame &frame)
 {
   gain = velocity * gainEnvelope.process();
   if (gainEnvelope.isTerminated()) state = NoteState::rest;
 
   const auto oscOut = osc.process(wavetable.table, wavetable.tableSize);
 
-  const auto cutAmt = info.filterAmount.getValue();
+  const auto cutAmt = frame.filterAmount;
   const auto cutoff = std::clamp(
-    info.filterCutoff.getValue() + info.filterKeyFollow.getValue() * noteFreq
+    frame.filterCutoff + frame.filterKeyFollow * noteFreq
       + mapCutoff(cutAmt * filterEnvelope.process()),
     0.0f, 22000.0f);
   const auto filterOut
-    = filter.process(oscOut, sampleRate, cutoff, info.filterResonance.getValue());
+    = filter.process(oscOut, sampleRate, cutoff, frame.filterResonance);
 
-  delay.setTime(sampleRate, delaySeconds * info.delayDetune.getValue() * info.lfoOut);
+  delay.setTime(sampleRate, delaySeconds * frame.delayDetune * frame.lfoOut);
   const auto delayOut
-    = delay.process(delayGate.process() * filterOut, info.delayFeedback.getValue());
+    = delay.process(delayGate.process() * filterOut, frame.delayFeedback);
 
-  const auto mix = filterOut + info.delayMix.getValue() * (delayOut - filterOut);
+  const auto mix = filterOut + frame.delayMix * (delayOut - filterOut);
 
   const auto gain1 = gain * pan;
   const auto gain0 = gain - gain1;
@@ -139,10 +140,10 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  midiNotes.resize(0);
+  midiNotes.clear();
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.04f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.04f);
 
   for (auto &note : notes) note.setup(this->sampleRate);
 
@@ -177,37 +178,42 @@ void DSPCore::setParameters(float tempo)
 {
   using ID = ParameterID::ID;
 
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
+  const auto &sc = smootherContext;
 
-  interpMasterGain.push(param.value[ID::gain]->getFloat());
+  interpMasterGain.push(param.value[ID::gain]->getFloat(), sc);
 
-  info.masterPitch.push(calcMasterPitch(
-    int32_t(param.value[ID::oscOctave]->getInt()) - 12,
-    param.value[ID::oscSemi]->getInt() - 120, param.value[ID::oscMilli]->getInt() - 1000,
-    param.value[ID::pitchBend]->getFloat()));
+  info.masterPitch.push(
+    calcMasterPitch(
+      int32_t(param.value[ID::oscOctave]->getInt()) - 12,
+      param.value[ID::oscSemi]->getInt() - 120,
+      param.value[ID::oscMilli]->getInt() - 1000, param.value[ID::pitchBend]->getFloat()),
+    sc);
 
   auto equalTemperament = param.value[ID::equalTemperament]->getFloat() + 1;
-  info.equalTemperament.push(equalTemperament);
-  info.pitchA4Hz.push(param.value[ID::pitchA4Hz]->getFloat() + 100);
-
-  info.filterCutoff.push(param.value[ID::filterCutoff]->getFloat());
-  info.filterResonance.push(param.value[ID::filterResonance]->getFloat());
-  info.filterAmount.push(param.value[ID::filterAmount]->getFloat());
-  info.filterKeyFollow.push(param.value[ID::filterKeyFollow]->getFloat());
-
-  info.delayMix.push(param.value[ID::delayMix]->getFloat());
-  info.delayDetune.push(calcDelayPitch(
-    param.value[ID::delayDetuneSemi]->getInt() - 120,
-    param.value[ID::delayDetuneMilli]->getInt() - 1000, equalTemperament));
-  info.delayFeedback.push(param.value[ID::delayFeedback]->getFloat());
+  info.equalTemperament.push(equalTemperament, sc);
+  info.pitchA4Hz.push(param.value[ID::pitchA4Hz]->getFloat() + 100, sc);
+
+  info.filterCutoff.push(param.value[ID::filterCutoff]->getFloat(), sc);
+  info.filterResonance.push(param.value[ID::filterResonance]->getFloat(), sc);
+  info.filterAmount.push(param.value[ID::filterAmount]->getFloat(), sc);
+  info.filterKeyFollow.push(param.value[ID::filterKeyFollow]->getFloat(), sc);
+
+  info.delayMix.push(param.value[ID::delayMix]->getFloat(), sc);
+  info.delayDetune.push(
+    calcDelayPitch(
+      param.value[ID::delayDetuneSemi]->getInt() - 120,
+      param.value[ID::delayDetuneMilli]->getInt() - 1000, equalTemperament),
+    sc);
+  info.delayFeedback.push(param.value[ID::delayFeedback]->getFloat(), sc);
 
   const float beat = float(param.value[ID::lfoTempoNumerator]->getInt() + 1)
     / float(param.value[ID::lfoTempoDenominator]->getInt() + 1);
   info.lfoFrequency.push(
-    param.value[ID::lfoFrequencyMultiplier]->getFloat() * tempo / 240.0f / beat);
-  info.lfoAmount.push(param.value[ID::lfoDelayAmount]->getFloat());
+    param.value[ID::lfoFrequencyMultiplier]->getFloat() * tempo / 240.0f / beat, sc);
+  info.lfoAmount.push(param.value[ID::lfoDelayAmount]->getFloat(), sc);
   info.lfoLowpass.push(
-    EMAFilter<float>::cutoffToP(sampleRate, param.value[ID::lfoLowpass]->getFloat()));
+    EMAFilter<float>::cutoffToP(sampleRate, param.value[ID::lfoLowpass]->getFloat()), sc);
 
   nVoice = 16 * (param.value[ID::nVoice]->getInt() + 1);
   if (nVoice > notes.size()) nVoice = notes.size();
@@ -217,11 +223,11 @@ void DSPCore::setParameters(float tempo)
     note.gainEnvelope.set(
       sampleRate, param.value[ID::gainA]->getFloat(), param.value[ID::gainD]->getFloat(),
       param.value[ID::gainS]->getFloat(), param.value[ID::gainR]->getFloat(),
-      param.value[ID::gainCurve]->getFloat(), note.noteFreq);
+      param.value[ID::gainCurve]->getFloat(), note.noteFreq, sc);
     note.filterEnvelope.set(
       sampleRate, param.value[ID::filterA]->getFloat(),
       param.value[ID::filterD]->getFloat(), param.value[ID::filterS]->getFloat(),
-      param.value[ID::filterR]->getFloat(), note.noteFreq);
+      param.value[ID::filterR]->getFloat(), note.noteFreq, sc);
     note.delayGate.atk.set(sampleRate, param.value[ID::delayAttack]->getFloat());
   }
 
@@ -240,35 +246,53 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
-
-  std::array<float, 2> frame{};
-  for (uint32_t i = 0; i < length; ++i) {
-    processMidiNote(i);
+  smootherContext.setBufferSize(float(length));
 
-    info.process(sampleRate, lfoWavetable);
+  auto onNote = [&](MidiNote &nt) {
+    if (nt.isNoteOn)
+      noteOn(nt.id, nt.pitch, nt.tuning, nt.velocity);
+    else
+      noteOff(nt.id);
+  };
 
-    frame.fill(0.0f);
+  auto prepare = [&](size_t, size_t frames) {
+    for (size_t k = 0; k < frames; ++k) {
+      info.process(sampleRate, lfoWavetable);
+      processFrame[k] = info.frame();
+    }
+  };
 
-    for (auto &note : notes) {
-      if (note.state == NoteState::rest) continue;
-      auto sig = note.process(sampleRate, wavetable, info);
-      frame[0] += sig[0];
-      frame[1] += sig[1];
+  auto renderVoice = [&](Note &note, size_t frames, auto &buffer) {
+    size_t k = 0;
+    for (; k < frames && note.state != NoteState::rest; ++k) {
+      auto sig = note.process(sampleRate, wavetable, processFrame[k]);
+      buffer[0][k] = sig[0];
+      buffer[1][k] = sig[1];
     }
+    return k;
+  };
+
+  auto onBlock = [&](size_t offset, size_t frames, const auto &mix) {
+    std::array<float, 2> frame{};
+    for (size_t j = 0; j < frames; ++j) {
+      frame[0] = mix[0][j];
+      frame[1] = mix[1][j];
+
+      if (isTransitioning) {
+        frame[0] += transitionBuffer[trIndex][0];
+        frame[1] += transitionBuffer[trIndex][1];
+        transitionBuffer[trIndex].fill(0.0f);
+        trIndex = (trIndex + 1) % transitionBuffer.size();
+        if (trIndex == trStop) isTransitioning = false;
+      }
 
-    if (isTransitioning) {
-      frame[0] += transitionBuffer[trIndex][0];
-      frame[1] += transitionBuffer[trIndex][1];
-      transitionBuffer[trIndex].fill(0.0f);
-      trIndex = (trIndex + 1) % transitionBuffer.size();
-      if (trIndex == trStop) isTransitioning = false;
+      const auto masterGain = interpMasterGain.process();
+      out0[offset + j] = masterGain * frame[0];
+      out1[offset + j] = masterGain * frame[1];
     }
+  };
 
-    const auto masterGain = interpMasterGain.process();
-    out0[i] = masterGain * frame[0];
-    out1[i] = masterGain * frame[1];
-  }
+  voiceRenderer.process(length, midiNotes, notes, onNote, prepare, renderVoice, onBlock);
 }
 
 void DSPCore::setUnisonPan(size_t nUnison)
@@ -415,7 +439,7 @@ void DSPCore::noteOn(int32_t identifier, int16_t pitch, float tuning, float velo
   if (nUnison <= 1) {
     notes[noteIndices[0]].noteOn(
       identifier, float(pitch) + tuning, velocity, 0.5f, 0.0f, sampleRate, wavetable,
-      info, param);
+      info, param, smootherContext);
     return;
   }
 
@@ -434,7 +458,7 @@ void DSPCore::noteOn(int32_t identifier, int16_t pitch, float tuning, float velo
     auto phase = unisonPhase * unison / float(nUnison);
     notes[noteIndices[unison]].noteOn(
       identifier, notePitch, distGain(info.rng) * velocity, unisonPan[unison], phase,
-      sampleRate, wavetable, info, param);
+      sampleRate, wavetable, info, param, smootherContext);
   }
 }
 
@@ -447,6 +471,7 @@ void DSPCore::fillTransitionBuffer(size_t noteIndex)
   if (trStop >= transitionBuffer.size()) trStop += transitionBuffer.size();
 
   auto &note = notes[noteIndex];
+  const auto frame = info.frame();
 
   for (size_t bufIdx = 0; bufIdx < transitionBuffer.size(); ++bufIdx) {
     if (note.state == NoteState::rest) {
@@ -455,7 +480,7 @@ void DSPCore::fillTransitionBuffer(size_t noteIndex)
       break;
     }
 
-    auto oscOut = note.process(sampleRate, wavetable, info);
+    auto oscOut = note.process(sampleRate, wavetable, frame);
     auto idx = (trIndex + bufIdx) % transitionBuffer.size();
     auto interp = 1.0f - float(bufIdx) / transitionBuffer.size();
 
@@ -4,7 +4,9 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/notequeue.hpp"
 #include "../../../common/dsp/smoother.hpp"
+#include "../../../common/dsp/voicerenderer.hpp"
 #include "../parameter.hpp"
 #include "delay.hpp"
 #include "envelope.hpp"
@@ -35,6 +37,18 @@ notePitchToFrequency(float notePitch, float equalTemperament, float a4Hz = 440.0
 
 enum class NoteState { active, release, rest };
 
+// Values of `NoteProcessInfo` which change on each frame.
+struct NoteProcessFrame {
+  float filterCutoff = 0;
+  float filterResonance = 0;
+  float filterAmount = 0;
+  float filterKeyFollow = 0;
+  float delayMix = 0;
+  float delayDetune = 0;
+  float delayFeedback = 0;
+  float lfoOut = 0;
+};
+
 struct NoteProcessInfo {
   std::minstd_rand rng{0};
 
@@ -80,6 +94,20 @@ struct NoteProcessInfo {
     if (lfoOut < 0.0f) lfoOut = 0.0f;
   }
 
+  NoteProcessFrame frame()
+  {
+    NoteProcessFrame fr;
+    fr.filterCutoff = filterCutoff.getValue();
+    fr.filterResonance = filterResonance.getValue();
+    fr.filterAmount = filterAmount.getValue();
+    fr.filterKeyFollow = filterKeyFollow.getValue();
+    fr.delayMix = delayMix.getValue();
+    fr.delayDetune = delayDetune.getValue();
+    fr.delayFeedback = delayFeedback.getValue();
+    fr.lfoOut = lfoOut;
+    return fr;
+  }
+
   void reset(GlobalParameter &param, float sampleRate)
   {
     using ID = ParameterID::ID;
@@ -146,7 +174,8 @@ public:
     float sampleRate,
     Wavetable &wavetable,
     NoteProcessInfo &info,
-    GlobalParameter &param);
+    GlobalParameter &param,
+    const SmootherContext<float> &context);
   void release();
   void release(float seconds);
   void rest();
@@ -154,7 +183,7 @@ public:
   bool isAttacking();
   float getGain();
   std::array<float, 2>
-  process(float sampleRate, Wavetable &wavetable, NoteProcessInfo &info);
+  process(float sampleRate, Wavetable &wavetable, const NoteProcessFrame &frame);
 };
 
 class DSPCore {
@@ -171,7 +200,7 @@ public:
   static constexpr size_t maxVoice = 128;
   GlobalParameter param;
 
-  std::vector<MidiNote> midiNotes;
+  NoteQueue<MidiNote> midiNotes;
 
   DSPCore();
 
@@ -201,22 +230,17 @@ public:
     note.pitch = pitch;
     note.tuning = tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(uint32_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(it->id, it->pitch, it->tuning, it->velocity);
+    midiNotes.dispatch(frame, [&](MidiNote &nt) {
+      if (nt.isNoteOn)
+        noteOn(nt.id, nt.pitch, nt.tuning, nt.velocity);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
-    }
+        noteOff(nt.id);
+    });
   }
 
 private:
@@ -240,8 +264,13 @@ private:
   std::array<Note, maxVoice> notes;
 
   NoteProcessInfo info;
+  SmootherContext<float> smootherContext;
   LinearSmoother<float> interpMasterGain;
 
+  static constexpr size_t voiceBlockSize = 64;
+  std::array<NoteProcessFrame, voiceBlockSize> processFrame{};
+  VoiceRenderer<float, 2, voiceBlockSize> voiceRenderer;
+
   std::vector<std::array<float, 2>> transitionBuffer{};
   bool isTransitioning = false;
   size_t trIndex = 0;
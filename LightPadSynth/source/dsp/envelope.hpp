@@ -127,7 +127,8 @@ public:
     Sample sustainLevel,
     Sample releaseTime,
     Sample curve,
-    Sample noteFreq)
+    Sample noteFreq,
+    const SmootherContext<Sample> &context)
   {
     trimNoteFreq(noteFreq);
 
@@ -141,7 +142,7 @@ public:
 
     dec.reset(sampleRate, decayTime);
 
-    sus.push(std::clamp<Sample>(sustainLevel, Sample(0), Sample(1)));
+    sus.push(std::clamp<Sample>(sustainLevel, Sample(0), Sample(1)), context);
 
     rel.reset(sampleRate, adaptTime(releaseTime, noteFreq));
   }
@@ -153,7 +154,8 @@ public:
     Sample sustainLevel,
     Sample releaseTime,
     Sample curve,
-    Sample noteFreq)
+    Sample noteFreq,
+    const SmootherContext<Sample> &context)
   {
     trimNoteFreq(noteFreq);
 
@@ -171,7 +173,7 @@ public:
         // Fall through.
 
       case State::sustain:
-        sus.push(std::clamp<Sample>(sustainLevel, Sample(0), Sample(1)));
+        sus.push(std::clamp<Sample>(sustainLevel, Sample(0), Sample(1)), context);
         // Fall through.
 
       case State::release:
@@ -258,12 +260,13 @@ public:
     Sample decayTime,
     Sample sustainLevel,
     Sample releaseTime,
-    Sample noteFreq)
+    Sample noteFreq,
+    const SmootherContext<Sample> &context)
   {
     state = State::attack;
     value = Sample(1);
     sus.reset(sustainLevel);
-    set(sampleRate, attackTime, decayTime, sustainLevel, releaseTime, noteFreq);
+    set(sampleRate, attackTime, decayTime, sustainLevel, releaseTime, noteFreq, context);
   }
 
   void set(
@@ -272,9 +275,10 @@ public:
     Sample decayTime,
     Sample sustainLevel,
     Sample releaseTime,
-    Sample noteFreq)
+    Sample noteFreq,
+    const SmootherContext<Sample> &context)
   {
-    sus.push(std::clamp<Sample>(sustainLevel, Sample(0), Sample(1)));
+    sus.push(std::clamp<Sample>(sustainLevel, Sample(0), Sample(1)), context);
     trimNoteFreq(noteFreq);
     atk = secondToDelta(sampleRate, adaptTime(attackTime, noteFreq));
     dec = secondToDelta(sampleRate, adaptTime(decayTime, noteFreq));
@@ -33,15 +33,13 @@ size_t DSPCore::getLatency() { return 0; }
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
   lfo.interpType = pv[ID::lfoInterpolation]->getInt();                                   \
   for (size_t idx = 0; idx < nLfoWavetable; ++idx) {                                     \
     lfo.source[idx + 1] = pv[ID::lfoWavetable0 + idx]->getFloat();                       \
   }                                                                                      \
                                                                                          \
-  lfoPhaseConstant.METHOD(pv[ID::lfoPhaseConstant]->getDouble());                        \
-  lfoPhaseOffset.METHOD(pv[ID::lfoPhaseOffset]->getDouble());                            \
   outputGain.METHOD(pv[ID::outputGain]->getDouble());                                    \
   mix.METHOD(pv[ID::mix]->getDouble());                                                  \
   outerFeed.METHOD(pv[ID::outerFeed]->getDouble());                                      \
@@ -60,7 +58,7 @@ void DSPCore::updateUpRate()
   auto fold = oversampling ? upFold : size_t(1);
   upRate = double(sampleRate) * fold;
 
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 
   synchronizer.reset(upRate, defaultTempo, double(1));
   lfo.setup(upRate, double(0.1));
@@ -72,6 +70,8 @@ void DSPCore::reset()
   updateUpRate();
 
   ASSIGN_PARAMETER(reset);
+  lfoPhaseConstant.reset(pv[ID::lfoPhaseConstant]->getDouble());
+  lfoPhaseOffset.reset(pv[ID::lfoPhaseOffset]->getDouble());
 
   midiNotes.clear();
   noteStack.clear();
@@ -107,6 +107,8 @@ void DSPCore::setParameters()
   }
 
   ASSIGN_PARAMETER(push);
+  lfoPhaseConstant.push(pv[ID::lfoPhaseConstant]->getDouble(), smootherContext);
+  lfoPhaseOffset.push(pv[ID::lfoPhaseOffset]->getDouble(), smootherContext);
 }
 
 void DSPCore::processFrame(std::array<double, 2> &frame)
@@ -115,16 +117,16 @@ void DSPCore::processFrame(std::array<double, 2> &frame)
 
   lfoPhaseConstant.process();
   lfoPhaseOffset.process();
-  outputGain.process();
-  mix.process();
-  outerFeed.process();
-  innerFeed.process();
-  lfoToInnerFeed.process();
-  delayTimeSpread.process();
-  delayTimeCenterSamples.process();
-  delayTimeRateLimit.process();
-  lfoToDelayTimeOctave.process();
-  inputToDelayTime.process();
+  outputGain.process(smootherContext);
+  mix.process(smootherContext);
+  outerFeed.process(smootherContext);
+  innerFeed.process(smootherContext);
+  lfoToInnerFeed.process(smootherContext);
+  delayTimeSpread.process(smootherContext);
+  delayTimeCenterSamples.process(smootherContext);
+  delayTimeRateLimit.process(smootherContext);
+  lfoToDelayTimeOctave.process(smootherContext);
+  inputToDelayTime.process(smootherContext);
 
   lfo.offset[0] = lfoPhaseConstant.getValue() + lfoPhaseOffset.getValue();
   lfo.offset[1] = lfoPhaseConstant.getValue() - lfoPhaseOffset.getValue();
@@ -199,7 +201,7 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   // When tempo-sync is off, use defaultTempo BPM.
   bool isTempoSyncing = pv[ID::lfoTempoSync]->getInt();
@@ -24,8 +24,8 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.04f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.04f);
 
   for (auto &shf : shifter) shf.setup(this->sampleRate, maxShiftDelaySeconds);
 
@@ -59,7 +59,7 @@ void DSPCore::setup(double sampleRate)
   }                                                                                      \
   interpShiftGain.back().METHOD(bypassMix);                                              \
                                                                                          \
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
 
 void DSPCore::reset()
 {
@@ -90,7 +90,7 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   // When tempo-sync is off, use 120 BPM.
   bool isTempoSyncing = param.value[ParameterID::lfoTempoSync]->getInt();
@@ -99,12 +99,12 @@ void DSPCore::process(
     !isTempoSyncing || !isPlaying);
 
   for (size_t i = 0; i < length; ++i) {
-    const auto phaseOffset = calcPhaseOffset(interpLfoLrPhaseOffset.process());
+    const auto phaseOffset = calcPhaseOffset(interpLfoLrPhaseOffset.process(smootherContext));
 
-    auto cutoff = interpShiftFeedbackCutoff.process();
-    auto lfoSkew = interpLfoSkew.process();
-    auto lfoDelayAmt = interpLfoToDelay.process();
-    auto lfoCutoffAmt = interpLfoToFeedbackCutoff.process();
+    auto cutoff = interpShiftFeedbackCutoff.process(smootherContext);
+    auto lfoSkew = interpLfoSkew.process(smootherContext);
+    auto lfoDelayAmt = interpLfoToDelay.process(smootherContext);
+    auto lfoCutoffAmt = interpLfoToFeedbackCutoff.process(smootherContext);
     auto lfoPhase = syncer.process();
     for (size_t j = 0; j < lfo.size(); ++j) {
       lfoOut[j] = lfo[j].process(lfoPhase, phaseOffset[j], lfoSkew);
@@ -119,7 +119,7 @@ void DSPCore::process(
       }
     }
 
-    const auto lfoToPitchShift = interpLfoToPitchShift.process();
+    const auto lfoToPitchShift = interpLfoToPitchShift.process(smootherContext);
     if (lfoToPitchShift >= 0.0) {
       lfoHz[0] = 1.0f + lfoToPitchShift * (lfoOut[0] - 1.0f);
       lfoHz[1] = 1.0f + lfoToPitchShift * (lfoOut[1] - 1.0f);
@@ -129,27 +129,27 @@ void DSPCore::process(
     }
 
     for (size_t x = 0; x < nSerial; ++x) {
-      auto delay = interpShiftDelay[x].process();
+      auto delay = interpShiftDelay[x].process(smootherContext);
       shifter[0].seconds[x] = lfoDelay[0] * delay;
       shifter[1].seconds[x] = lfoDelay[1] * delay;
 
-      auto gain = interpShiftGain[x].process();
+      auto gain = interpShiftGain[x].process(smootherContext);
       shifter[0].gain[x] = gain;
       shifter[1].gain[x] = gain;
 
       for (size_t y = 0; y < nParallel; ++y) {
-        auto hz = interpShiftHz[x][y].process();
+        auto hz = interpShiftHz[x][y].process(smootherContext);
         shifter[0].hz[x][y] = lfoHz[0] * hz;
         shifter[1].hz[x][y] = lfoHz[1] * hz;
       }
     }
-    auto bypassGain = interpShiftGain.back().process();
+    auto bypassGain = interpShiftGain.back().process(smootherContext);
     shifter[0].bypassGain = bypassGain;
     shifter[1].bypassGain = bypassGain;
 
-    const auto gain = interpGain.process();
-    const auto fbGain = interpShiftFeedbackGain.process();
-    const auto sectionGain = interpSectionGain.process();
+    const auto gain = interpGain.process(smootherContext);
+    const auto fbGain = interpShiftFeedbackGain.process(smootherContext);
+    const auto sectionGain = interpSectionGain.process(smootherContext);
     out0[i] = gain
       * shifter[0].process(
         sampleRate, in0[i], phaseOffset[0], fbGain, feedbackCutoffHz[0], sectionGain);
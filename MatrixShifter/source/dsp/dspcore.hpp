@@ -40,6 +40,7 @@ private:
   std::array<float, 2> feedbackCutoffHz{};
   std::array<float, 2> lfoHz{};
 
+  SmootherContext<float> smootherContext;
   ExpSmoother<float> interpGain;
   ExpSmoother<float> interpShiftFeedbackGain;
   ExpSmoother<float> interpShiftFeedbackCutoff;
@@ -33,8 +33,8 @@ void DSPCore::setup(double sampleRate)
 
   constexpr auto smoothingTimeSecond = 0.2;
 
-  SmootherCommon<double>::setSampleRate(upRate);
-  SmootherCommon<double>::setTime(smoothingTimeSecond);
+  smootherContext.setSampleRate(upRate);
+  smootherContext.setTime(smoothingTimeSecond);
 
   batterSide.setup(upRate, 1.0);
   snareSide.setup(upRate, 1.0);
@@ -158,21 +158,21 @@ double DSPCore::processSample()
   snareSidePitch.process(pitchSmoothingKp);
   frequencyHz.process(pitchSmoothingKp);
 
-  outputGain.process();
-  fdnMix.process();
-  impactNoiseMix.process();
-  couplingAmount.process();
-  couplingSafetyReduction.process();
-  batterShape.process();
-  batterFeedback.process();
-  batterModulation.process();
-  batterInterpRate.process();
-  batterMinModulation.process();
-  snareShape.process();
-  snareFeedback.process();
-  snareModulation.process();
-  snareInterpRate.process();
-  snareMinModulation.process();
+  outputGain.process(smootherContext);
+  fdnMix.process(smootherContext);
+  impactNoiseMix.process(smootherContext);
+  couplingAmount.process(smootherContext);
+  couplingSafetyReduction.process(smootherContext);
+  batterShape.process(smootherContext);
+  batterFeedback.process(smootherContext);
+  batterModulation.process(smootherContext);
+  batterInterpRate.process(smootherContext);
+  batterMinModulation.process(smootherContext);
+  snareShape.process(smootherContext);
+  snareFeedback.process(smootherContext);
+  snareModulation.process(smootherContext);
+  snareInterpRate.process(smootherContext);
+  snareMinModulation.process(smootherContext);
 
   auto batterModEnv = enableBatterModEnv ? batterModEnvelope.process() : double(1);
   auto snareModEnv = enableSnareModEnv ? snareModEnvelope.process() : double(1);
@@ -195,10 +195,10 @@ double DSPCore::processSample()
   auto batterOut = batterSide.process(
     pulseOut + bufBatter, batterFeedback.getValue(),
     batterModEnv * batterModulation.getValue(), batterInterpRate.getValue(),
-    batterMinModulation.getValue());
+    batterMinModulation.getValue(), smootherContext);
   auto snareOut = snareSide.process(
     bufSnare, snareFeedback.getValue(), snareModEnv * snareModulation.getValue(),
-    snareInterpRate.getValue(), snareMinModulation.getValue());
+    snareInterpRate.getValue(), snareMinModulation.getValue(), smootherContext);
 
   auto cpl = couplingEnvelope * couplingAmount.getValue();
   bufBatter = std::clamp(cpl * snareOut, double(-1000), double(1000));
@@ -220,8 +220,8 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setBufferSize(double(length));
+  smootherContext.setSampleRate(upRate);
 
   bool overSampling = pv[ID::overSampling]->getInt();
 
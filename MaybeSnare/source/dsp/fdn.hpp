@@ -118,11 +118,11 @@ public:
     ic2eq.fill(0);
   }
 
-  void process(std::array<Sample, length> &v0)
+  void process(std::array<Sample, length> &v0, const SmootherContext<Sample> &context)
   {
     for (size_t n = 0; n < length; ++n) {
-      auto gn = g[n].process();
-      auto kn = k[n].process();
+      auto gn = g[n].process(context);
+      auto kn = k[n].process(context);
       auto v1 = (ic1eq[n] + gn * (v0[n] - ic2eq[n])) / (Sample(1) + gn * (gn + kn));
       auto v2 = ic2eq[n] + gn * v1;
       ic1eq[n] = Sample(2) * v1 - ic1eq[n];
@@ -168,11 +168,11 @@ public:
     ic2eq.fill(0);
   }
 
-  void process(std::array<Sample, length> &v0)
+  void process(std::array<Sample, length> &v0, const SmootherContext<Sample> &context)
   {
     for (size_t n = 0; n < length; ++n) {
-      auto gn = g[n].process();
-      auto kn = k[n].process();
+      auto gn = g[n].process(context);
+      auto kn = k[n].process(context);
       auto v1 = (ic1eq[n] + gn * (v0[n] - ic2eq[n])) / (Sample(1) + gn * (gn + kn));
       auto v2 = ic2eq[n] + gn * v1;
       ic1eq[n] = Sample(2) * v1 - ic1eq[n];
@@ -384,7 +384,8 @@ public:
     Sample feedback,
     Sample modulation,
     Sample delayTimeSlewRate,
-    Sample minModulation)
+    Sample minModulation,
+    const SmootherContext<Sample> &context)
   {
     bufIndex ^= 1;
     auto &front = buf[bufIndex];
@@ -398,8 +399,8 @@ public:
       front[idx] = input * inputGain[idx] + feedback * front[idx];
     }
     delay.process(front, modulation, delayTimeSlewRate, minModulation);
-    lowpass.process(front);
-    highpass.process(front);
+    lowpass.process(front, context);
+    highpass.process(front, context);
 
     return std::accumulate(front.begin(), front.end(), Sample(0));
   }
@@ -33,8 +33,8 @@ void DSPCore::setup(double sampleRate)
 
   constexpr auto smoothingTimeSecond = 0.2;
 
-  SmootherCommon<double>::setSampleRate(upRate);
-  SmootherCommon<double>::setTime(smoothingTimeSecond);
+  smootherContext.setSampleRate(upRate);
+  smootherContext.setTime(smoothingTimeSecond);
 
   fdn.setup(upRate, 1.0);
 
@@ -122,12 +122,12 @@ double DSPCore::processSample()
   interpPitch.process(pitchSmoothingKp);
   frequencyHz.process(pitchSmoothingKp);
 
-  outputGain.process();
-  fdnShape.process();
-  fdnFeedback.process();
-  fdnModulation.process();
-  fdnInterpRate.process();
-  fdnMinModulation.process();
+  outputGain.process(smootherContext);
+  fdnShape.process(smootherContext);
+  fdnFeedback.process(smootherContext);
+  fdnModulation.process(smootherContext);
+  fdnInterpRate.process(smootherContext);
+  fdnMinModulation.process(smootherContext);
 
   auto modEnv = enableModEnv ? modulationEnvelope.process() : double(1);
 
@@ -141,7 +141,7 @@ double DSPCore::processSample()
   }
   sig = fdn.process(
     sig, fdnFeedback.getValue(), fdnModulation.getValue(),
-    modEnv * fdnInterpRate.getValue(), fdnMinModulation.getValue());
+    modEnv * fdnInterpRate.getValue(), fdnMinModulation.getValue(), smootherContext);
 
   return sig * outputGain.getValue();
 }
@@ -153,8 +153,8 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setBufferSize(double(length));
+  smootherContext.setSampleRate(upRate);
 
   bool overSampling = pv[ID::overSampling]->getInt();
 
@@ -15,17 +15,61 @@ template<typename T> T lerp(T a, T b, T t) { return a + t * (b - a); }
 
 void DSPCore::setup(double sampleRate)
 {
+  // Discards the running design. It might be for previous sample rate.
+  firDesigner.wait();
+  firDesigner.finish();
+  pendingRefresh = false;
+
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
+
+  isMinimumPhase = param.value[ParameterID::minimumPhase]->getInt();
+  firLength = getFirLength();
+  for (auto &cnv : lowpassConvolver) cnv.setLength(firLength);
+  for (auto &cnv : highpassConvolver) cnv.setLength(isMinimumPhase ? firLength : 0);
+  for (auto &dly : delay) dly.resize(isMinimumPhase ? 0 : firLength / 2 - 1);
+
+  // First design is synchronous to start with correct kernel.
+  designSampleRate = this->sampleRate;
+  designCutoffHz = param.value[ParameterID::cutoffHz]->getFloat();
+  auto lowpass = getFir(false);
+  for (auto &cnv : lowpassConvolver) cnv.setFir(lowpass);
+  if (isMinimumPhase) {
+    auto highpass = getFir(true);
+    for (auto &cnv : highpassConvolver) cnv.setFir(highpass);
+  }
+  isFirRefreshed = param.value[ParameterID::refreshFir]->getInt();
 
   reset();
   startup();
-  prepareRefresh = true;
 }
 
-size_t DSPCore::getLatency() { return fftconvLatency; }
+/**
+Returns the FIR length for current parameters. Latency is computed from this, so the
+result may differ from `firLength` until next `setup`.
+
+Transition band of Nuttall windowed sinc, from -0.001 dB to -120 dB, is 8 bins wide.
+*/
+size_t DSPCore::getFirLength()
+{
+  using ID = ParameterID::ID;
+  const auto &pv = param.value;
+
+  if (!pv[ID::adaptiveFirLength]->getInt()) return maxFirLength;
+
+  const auto target = 8.0 * double(sampleRate) / pv[ID::transitionWidthHz]->getDouble();
+  size_t length = minFirLength;
+  while (length < maxFirLength && double(length) < target) length *= 2;
+  return length;
+}
+
+size_t DSPCore::getLatency()
+{
+  if (param.value[ParameterID::minimumPhase]->getInt()) return 0;
+  return getFirLength() / 2 - 1;
+}
 
 #define ASSIGN_PARAMETER(METHOD)                                                         \
   using ID = ParameterID::ID;                                                            \
@@ -38,7 +82,8 @@ void DSPCore::reset()
 {
   ASSIGN_PARAMETER(reset);
 
-  for (auto &cnv : convolver) cnv.reset();
+  for (auto &cnv : lowpassConvolver) cnv.reset();
+  for (auto &cnv : highpassConvolver) cnv.reset();
   for (auto &dly : delay) dly.reset();
 
   startup();
@@ -50,12 +95,57 @@ void DSPCore::setParameters()
 {
   ASSIGN_PARAMETER(push);
 
-  if (prepareRefresh || (!isFirRefreshed && pv[ID::refreshFir]->getInt())) {
-    auto cutoffHz = pv[ID::cutoffHz]->getFloat();
-    for (auto &cnv : convolver) cnv.refreshFir(sampleRate, cutoffHz, false);
-  }
+  if (!isFirRefreshed && pv[ID::refreshFir]->getInt()) pendingRefresh = true;
   isFirRefreshed = pv[ID::refreshFir]->getInt();
-  prepareRefresh = false;
+
+  updateFir();
+}
+
+std::vector<float> DSPCore::getFir(bool isHighpass)
+{
+  auto fir = getNuttallFir(firLength, designSampleRate, designCutoffHz, isHighpass);
+  if (isMinimumPhase) toMinimumPhase(fir);
+  return fir;
+}
+
+// Runs on worker thread.
+void DSPCore::designFir()
+{
+  auto lowpass = getFir(false);
+  for (auto &cnv : lowpassConvolver) cnv.prepareFir(lowpass);
+  if (!isMinimumPhase) return;
+
+  auto highpass = getFir(true);
+  for (auto &cnv : highpassConvolver) cnv.prepareFir(highpass);
+}
+
+/**
+Swaps the kernel designed on worker thread, and requests next design. A new design is
+requested only after the crossfade is finished, because `prepareFir` writes to the
+buffer of previous kernel.
+*/
+void DSPCore::updateFir()
+{
+  if (firDesigner.isDone()) {
+    const auto fadeSamples = size_t(firCrossfadeSeconds * sampleRate);
+    for (auto &cnv : lowpassConvolver) cnv.swapFir(fadeSamples);
+    if (isMinimumPhase) {
+      for (auto &cnv : highpassConvolver) cnv.swapFir(fadeSamples);
+    }
+    firDesigner.finish();
+  }
+
+  if (!pendingRefresh || !firDesigner.isIdle()) return;
+  for (auto &cnv : lowpassConvolver) {
+    if (cnv.isCrossfading()) return;
+  }
+  for (auto &cnv : highpassConvolver) {
+    if (cnv.isCrossfading()) return;
+  }
+
+  designSampleRate = sampleRate;
+  designCutoffHz = param.value[ParameterID::cutoffHz]->getFloat();
+  if (firDesigner.request()) pendingRefresh = false;
 }
 
 void DSPCore::process(
@@ -63,20 +153,26 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
   for (size_t i = 0; i < length; ++i) {
-    auto lp0 = convolver[0].process(in0[i]);
-    auto lp1 = convolver[1].process(in1[i]);
-
-    auto hp0 = delay[0].process(in0[i]) - lp0;
-    auto hp1 = delay[1].process(in1[i]) - lp1;
-
-    auto hpGain = interpHighpassGain.process();
-    auto lpGain = interpLowpassGain.process();
+    auto lp0 = lowpassConvolver[0].process(in0[i]);
+    auto lp1 = lowpassConvolver[1].process(in1[i]);
+
+    float hp0, hp1;
+    if (isMinimumPhase) {
+      hp0 = highpassConvolver[0].process(in0[i]);
+      hp1 = highpassConvolver[1].process(in1[i]);
+    } else {
+      hp0 = delay[0].process(in0[i]) - lp0;
+      hp1 = delay[1].process(in1[i]) - lp1;
+    }
+
+    auto hpGain = interpHighpassGain.process(smootherContext);
+    auto lpGain = interpLowpassGain.process(smootherContext);
 
     out0[i] = lpGain * lp0 + hpGain * hp0;
     out1[i] = lpGain * lp1 + hpGain * hp1;
@@ -3,21 +3,22 @@
 
 #pragma once
 
+#include "../../../common/dsp/backgroundtask.hpp"
 #include "../../../common/dsp/constants.hpp"
-#include "../../../common/dsp/lightlimiter.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "fftconvolver.hpp"
 
 #include <array>
+#include <vector>
 
 using namespace SomeDSP;
 using namespace Steinberg::Synth;
 
 constexpr size_t firLengthInPow2 = 15;
-constexpr size_t blockSizeInPow2 = 11;
-constexpr size_t nBlock = size_t(1) << (firLengthInPow2 - blockSizeInPow2);
-constexpr size_t fftconvLatency = (size_t(1) << firLengthInPow2) / 2 - 1;
+constexpr size_t maxFirLength = size_t(1) << firLengthInPow2;
+constexpr size_t minFirLength = size_t(1) << 9;
+constexpr float firCrossfadeSeconds = 0.05f;
 
 class DSPCore {
 public:
@@ -32,13 +33,33 @@ public:
     const size_t length, const float *in0, const float *in1, float *out0, float *out1);
 
 private:
+  size_t getFirLength();
+  std::vector<float> getFir(bool isHighpass);
+  void designFir();
+  void updateFir();
+
   float sampleRate = 44100.0f;
-  bool prepareRefresh = false;
   bool isFirRefreshed = false;
+  bool pendingRefresh = false;
+
+  // Latched on `setup`, because latency is changed.
+  bool isMinimumPhase = false;
+  size_t firLength = maxFirLength;
 
+  // Written by audio thread before `firDesigner.request()`.
+  float designSampleRate = 44100.0f;
+  float designCutoffHz = 20.0f;
+
+  SmootherContext<float> smootherContext;
   ExpSmoother<float> interpHighpassGain;
   ExpSmoother<float> interpLowpassGain;
 
-  std::array<SplitConvolver<nBlock, blockSizeInPow2>, 2> convolver;
-  std::array<FixedIntDelay<float, fftconvLatency>, 2> delay;
+  // Highpass is `delay - lowpass` on linear phase. On minimum phase, phase of lowpass
+  // passband isn't flat, so highpass is convolved separately.
+  std::array<UniformPartitionedConvolver<firLengthInPow2>, 2> lowpassConvolver;
+  std::array<UniformPartitionedConvolver<firLengthInPow2>, 2> highpassConvolver;
+  std::array<FixedIntDelayVector, 2> delay;
+
+  // Declared last to stop the worker before `convolver` is destructed.
+  BackgroundTask firDesigner{[this]() { designFir(); }};
 };
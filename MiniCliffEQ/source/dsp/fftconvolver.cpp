@@ -7,6 +7,6 @@
 
 namespace SomeDSP {
 
-std::mutex OverlapSaveConvolver::fftwMutex;
+std::mutex fftwMutex;
 
 } // namespace SomeDSP
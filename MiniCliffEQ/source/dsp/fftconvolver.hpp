@@ -4,6 +4,8 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/fftwplancache.hpp"
+#include "../../../common/dsp/fir.hpp"
 #include "../../../lib/fftw3/fftw3.h"
 
 #include <algorithm>
@@ -58,36 +60,118 @@ getNuttallFir(size_t nTap, float sampleRate, float cutoffHz, bool isHighpass)
   return coefficient;
 }
 
+/**
+Converts `fir` to minimum phase by homomorphic filtering. Magnitude response is kept, and
+energy is moved towards the start of `fir`.
+
+FFT size is `8 * fir.size()` to reduce aliasing of cepstrum. Magnitude is clamped before
+taking log, because stopband may have exact zeros.
+
+Allocates memory and may make FFTW plans, so don't call this on audio thread.
+*/
+inline void toMinimumPhase(std::vector<float> &fir)
+{
+  using Complex = std::complex<float>;
+
+  const size_t size = 8 * fir.size();
+  const size_t spcSize = size / 2 + 1;
+
+  float *sig;
+  Complex *spc;
+  {
+    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+    sig = (float *)fftwf_malloc(sizeof(float) * size);
+    spc = (Complex *)fftwf_malloc(sizeof(Complex) * spcSize);
+  }
+  auto cspc = reinterpret_cast<fftwf_complex *>(spc);
+  auto forwardPlan = FftwPlanCache::acquire(
+    FftwPlanShape::real(FftwPlanShape::r2c, int(size), sig, spc));
+  auto inversePlan = FftwPlanCache::acquire(
+    FftwPlanShape::real(FftwPlanShape::c2r, int(size), spc, sig));
+
+  std::copy(fir.begin(), fir.end(), sig);
+  std::fill(sig + fir.size(), sig + size, float(0));
+  fftwf_execute_dft_r2c(forwardPlan, sig, cspc);
+
+  // Real cepstrum.
+  constexpr float minMagnitude = float(1e-10); // -200 dB.
+  for (size_t k = 0; k < spcSize; ++k) {
+    spc[k] = Complex(std::log(std::max(std::abs(spc[k]), minMagnitude)), float(0));
+  }
+  fftwf_execute_dft_c2r(inversePlan, cspc, sig);
+
+  // Fold anti-causal part to causal part. FFT scaling is also applied here.
+  const float scale = float(1) / float(size);
+  sig[0] *= scale;
+  for (size_t n = 1; n < size / 2; ++n) sig[n] *= float(2) * scale;
+  sig[size / 2] *= scale;
+  std::fill(sig + size / 2 + 1, sig + size, float(0));
+
+  fftwf_execute_dft_r2c(forwardPlan, sig, cspc);
+  for (size_t k = 0; k < spcSize; ++k) spc[k] = std::exp(spc[k]) * scale;
+  fftwf_execute_dft_c2r(inversePlan, cspc, sig);
+
+  std::copy(sig, sig + fir.size(), fir.begin());
+
+  FftwPlanCache::release(forwardPlan);
+  FftwPlanCache::release(inversePlan);
+
+  const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+  fftwf_free(sig);
+  fftwf_free(spc);
+}
+
+/**
+Coefficients are double buffered. `prepareFir` writes to inactive buffer, and `swapFir`
+activates it. While `crossfade < 1`, output is interpolated from the previous
+coefficients.
+*/
 template<typename Sample, size_t nTap> class DirectConvolver {
 private:
-  std::array<Sample, nTap> co{};
-  std::array<Sample, nTap> buf{};
+  std::array<std::array<Sample, nTap>, 2> co{};
+  size_t active = 0;
+  Sample crossfade = Sample(1);
+  FirHistory<Sample, nTap> buf;
 
 public:
   void setFir(std::vector<float> &source)
+  {
+    prepareFir(source);
+    swapFir();
+    crossfade = Sample(1);
+  }
+
+  // Can be called from other thread, if `isCrossfading()` is false.
+  void prepareFir(std::vector<float> &source)
   {
     if (source.size() < nTap) return;
-    std::copy(source.begin(), source.begin() + nTap, co.begin());
+    std::copy(source.begin(), source.begin() + nTap, co[active ^ 1].begin());
+  }
+
+  void swapFir()
+  {
+    active ^= 1;
+    crossfade = Sample(0);
   }
 
-  void reset() { buf.fill({}); }
+  void setCrossfade(Sample amount) { crossfade = amount; }
+  bool isCrossfading() { return crossfade < Sample(1); }
+
+  void reset() { buf.reset(); }
 
   Sample process(Sample input)
   {
-    std::rotate(buf.rbegin(), buf.rbegin() + 1, buf.rend());
-    buf[0] = input;
+    buf.push(input);
+    auto output = firDot<Sample, nTap>(buf.data(), co[active].data());
+    if (crossfade >= Sample(1)) return output;
 
-    Sample output = 0;
-    for (size_t n = 0; n < nTap; ++n) output += buf[n] * co[n];
-    return output;
+    auto previous = firDot<Sample, nTap>(buf.data(), co[active ^ 1].data());
+    return previous + crossfade * (output - previous);
   }
 };
 
 class OverlapSaveConvolver {
 private:
-  // `fftwMutex` is used to lock FFTW3 calls except `fftw*_execute`.
-  static std::mutex fftwMutex;
-
   static constexpr size_t nBuffer = 2;
 
   size_t half = 1;
@@ -100,56 +184,55 @@ private:
   float *flt; // filtered.
   float *coefficient;
 
-  std::array<fftwf_plan, nBuffer> forwardPlan;
+  // Forward plan is shared by `buf` and `coefficient`. They have the same alignment.
+  fftwf_plan forwardPlan;
   fftwf_plan inversePlan;
-  fftwf_plan firPlan;
 
   size_t front = 0;
   std::array<size_t, nBuffer> wptr{};
   size_t rptr = 0;
   size_t offset = 0;
 
+  inline fftwf_complex *cast(std::complex<float> *x)
+  {
+    return reinterpret_cast<fftwf_complex *>(x);
+  }
+
 public:
   void init(size_t nTap, size_t delay = 0)
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
-
     offset = delay;
 
     half = nTap;
     bufSize = 2 * half;
     spcSize = nTap + 1;
 
-    for (size_t idx = 0; idx < nBuffer; ++idx) {
-      buf[idx] = (float *)fftwf_malloc(sizeof(float) * bufSize);
-    }
-    spc = (std::complex<float> *)fftwf_malloc(sizeof(std::complex<float>) * spcSize);
-    flt = (float *)fftwf_malloc(sizeof(float) * bufSize);
+    {
+      const std::lock_guard<std::mutex> fftwLock(fftwMutex);
 
-    coefficient = (float *)fftwf_malloc(sizeof(float) * bufSize);
+      for (size_t idx = 0; idx < nBuffer; ++idx) {
+        buf[idx] = (float *)fftwf_malloc(sizeof(float) * bufSize);
+      }
+      spc = (std::complex<float> *)fftwf_malloc(sizeof(std::complex<float>) * spcSize);
+      flt = (float *)fftwf_malloc(sizeof(float) * bufSize);
+      coefficient = (float *)fftwf_malloc(sizeof(float) * bufSize);
+      fir = (std::complex<float> *)fftwf_malloc(sizeof(std::complex<float>) * spcSize);
+    }
     std::fill(coefficient, coefficient + bufSize, float(0));
-
-    fir = (std::complex<float> *)fftwf_malloc(sizeof(std::complex<float>) * spcSize);
     std::fill(fir, fir + spcSize, std::complex<float>(0, 0));
 
-    for (size_t idx = 0; idx < nBuffer; ++idx) {
-      forwardPlan[idx] = fftwf_plan_dft_r2c_1d(
-        int(bufSize), buf[idx], reinterpret_cast<fftwf_complex *>(spc), FFTW_ESTIMATE);
-    }
-    inversePlan = fftwf_plan_dft_c2r_1d(
-      int(bufSize), reinterpret_cast<fftwf_complex *>(spc), flt, FFTW_ESTIMATE);
-    firPlan = fftwf_plan_dft_r2c_1d(
-      int(bufSize), coefficient, reinterpret_cast<fftwf_complex *>(fir), FFTW_ESTIMATE);
+    forwardPlan = FftwPlanCache::acquire(
+      FftwPlanShape::real(FftwPlanShape::r2c, int(bufSize), buf[0], spc));
+    inversePlan = FftwPlanCache::acquire(
+      FftwPlanShape::real(FftwPlanShape::c2r, int(bufSize), spc, flt));
   }
 
   ~OverlapSaveConvolver()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
-
-    for (auto &fp : forwardPlan) fftwf_destroy_plan(fp);
-    fftwf_destroy_plan(inversePlan);
-    fftwf_destroy_plan(firPlan);
+    FftwPlanCache::release(forwardPlan);
+    FftwPlanCache::release(inversePlan);
 
+    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
     for (auto &bf : buf) fftwf_free(bf);
     fftwf_free(spc);
     fftwf_free(fir);
@@ -164,7 +247,7 @@ public:
     // FFT scaling.
     for (size_t idx = 0; idx < half; ++idx) coefficient[idx] /= float(bufSize);
 
-    fftwf_execute(firPlan);
+    fftwf_execute_dft_r2c(forwardPlan, coefficient, cast(fir));
   }
 
   void reset()
@@ -192,9 +275,9 @@ public:
     }
 
     if (wptr[front] == 0) {
-      fftwf_execute(forwardPlan[front]);
+      fftwf_execute_dft_r2c(forwardPlan, buf[front], cast(spc));
       for (size_t i = 0; i < spcSize; ++i) spc[i] *= fir[i];
-      fftwf_execute(inversePlan);
+      fftwf_execute_dft_c2r(inversePlan, cast(spc), flt);
 
       front ^= 1;
     }
@@ -292,7 +375,12 @@ public:
   std::vector<float> buf{};
   size_t ptr = 0;
 
-  void resize(size_t size) { buf.resize(size); }
+  void resize(size_t size)
+  {
+    buf.resize(size);
+    ptr = 0;
+  }
+
   void reset(float value = 0) { std::fill(buf.begin(), buf.end(), value); }
 
   float process(float input)
@@ -304,6 +392,520 @@ public:
   }
 };
 
+/**
+Overlap-save convolver which spreads FFT work evenly over samples.
+
+FFT of length `2 * half` is decomposed by four-step FFT into a `nRow` by `nCol` matrix.
+Transforms on a batch of columns, a batch of rows, or a chunk of spectral multiplication
+is a task. Tasks of a block are evenly distributed to the next `half` samples, so the
+cost of `process` is almost constant.
+
+- All the transforms are in-place. Spectrum is stored in transposed order, and inverse
+  transform runs the steps in reverse to get back the natural order.
+- Input is complex with zero imaginary part, which is simpler to split than real FFT.
+- Output is delayed by `2 * half` samples.
+- `nTap` must be greater than or equal to 4. FFTW call overhead dominates on short
+  blocks, so it's better to use `OverlapSaveConvolver` there.
+
+When `nPartition > 1`, FIR is split into `nPartition` uniform partitions of `half` taps.
+Input spectra are kept in a frequency domain delay line (FDL), and multiply-accumulated
+with the spectrum of each partition. So there's only 1 forward FFT and 1 inverse FFT per
+block regardless of FIR length.
+
+FIR spectra are double buffered in the same way as `DirectConvolver`. Active buffer is
+latched at the start of each block. If crossfade is not finished at that time, the block
+is also computed with the previous FIR, which adds 1 multiply-accumulate and 1 inverse
+transform. The 2 outputs are interpolated on each sample by the crossfade amount at the
+time of reading. Use `fadeDelay` to start a crossfade after the first such block.
+
+`setPartition` reduces the number of partitions below the one given to `init`, to save
+CPU on shorter FIR. When it's set to 0, `process` outputs 0 without any computation.
+*/
+class TimeSlicedOverlapSaveConvolver {
+private:
+  using Complex = std::complex<float>;
+
+  // Buffers are used for filling the current window, filling the next window and reading
+  // output, and running tasks.
+  static constexpr size_t nBuffer = 3;
+  static constexpr size_t maxTaskPerStep = 8;
+
+  size_t half = 1;
+  size_t fftSize = 2;
+  size_t nRow = 2;
+  size_t nCol = 1;
+  size_t colBatch = 1;
+  size_t rowBatch = 1;
+  size_t nColTask = 1;
+  size_t nRowTask = 2;
+  size_t macRowBatch = 2;
+  size_t nMacTask = 1;
+  size_t nTask = 0;
+  size_t nFadeTask = 0;
+  size_t blockTask = 0;
+
+  size_t maxPartition = 1;
+  size_t nPartition = 1;
+  size_t fdlIndex = 0;
+
+  std::array<Complex *, nBuffer> buf;
+  std::array<Complex *, nBuffer> previous; // Output of previous FIR.
+  std::array<bool, nBuffer> hasPrevious{};
+  Complex *twiddle;
+  std::array<Complex *, 2> fir; // `maxPartition` spectra each.
+  Complex *fdl;                 // `maxPartition` spectra.
+
+  size_t active = 0;
+  size_t blockActive = 0;
+  bool blockFade = false;
+  float crossfade = 1;
+
+  // Index 0 is forward, 1 is backward.
+  std::array<fftwf_plan, 2> colPlan;
+  std::array<fftwf_plan, 2> rowPlan;
+
+  size_t current = 0;
+  size_t ptr = 0;
+  size_t task = 0;
+  size_t taskPhase = 0; // Avoids division in `process`.
+
+  inline fftwf_complex *cast(Complex *x) { return reinterpret_cast<fftwf_complex *>(x); }
+
+  // `std::complex` multiplication has NaN checks which are slow without `-ffast-math`.
+  static inline Complex multiply(Complex a, Complex b)
+  {
+    return {
+      a.real() * b.real() - a.imag() * b.imag(),
+      a.real() * b.imag() + a.imag() * b.real()};
+  }
+
+public:
+  void init(size_t nTap, size_t nPartition = 1)
+  {
+    maxPartition = std::max(nPartition, size_t(1));
+    half = nTap;
+    fftSize = 2 * half;
+
+    size_t log2Size = 0;
+    while ((size_t(1) << log2Size) < fftSize) ++log2Size;
+    nRow = size_t(1) << ((log2Size + 1) / 2);
+    nCol = fftSize / nRow;
+
+    // Batch is at least 2 to keep 16 bytes alignment required by FFTW.
+    colBatch = std::max(nCol / maxTaskPerStep, size_t(2));
+    rowBatch = std::max(nRow / maxTaskPerStep, size_t(2));
+    nColTask = nCol / colBatch;
+    nRowTask = nRow / rowBatch;
+
+    {
+      const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+
+      auto allocate = [&](size_t size) {
+        auto ptr = (Complex *)fftwf_malloc(sizeof(Complex) * size);
+        std::fill(ptr, ptr + size, Complex(0, 0));
+        return ptr;
+      };
+      for (auto &bf : buf) bf = allocate(fftSize);
+      for (auto &bf : previous) bf = allocate(fftSize);
+      twiddle = allocate(fftSize);
+      for (auto &spectrum : fir) spectrum = allocate(maxPartition * fftSize);
+      fdl = allocate(maxPartition * fftSize);
+    }
+
+    for (size_t row = 0; row < nRow; ++row) {
+      for (size_t col = 0; col < nCol; ++col) {
+        twiddle[row * nCol + col] = std::polar(
+          float(1), float(-twopi * double(row * col) / double(fftSize)));
+      }
+    }
+
+    // Columns are strided by `nCol`, and rows are contiguous.
+    const int nr = int(nRow);
+    const int nc = int(nCol);
+    for (size_t idx = 0; idx < 2; ++idx) {
+      const int sign = idx == 0 ? FFTW_FORWARD : FFTW_BACKWARD;
+      colPlan[idx] = FftwPlanCache::acquire(FftwPlanShape::complex(
+        sign, nr, int(colBatch), nc, 1, cast(buf[0]), cast(buf[0])));
+      rowPlan[idx] = FftwPlanCache::acquire(FftwPlanShape::complex(
+        sign, nc, int(rowBatch), 1, nc, cast(buf[0]), cast(buf[0])));
+    }
+
+    setPartition(maxPartition);
+  }
+
+  ~TimeSlicedOverlapSaveConvolver()
+  {
+    for (auto &plan : colPlan) FftwPlanCache::release(plan);
+    for (auto &plan : rowPlan) FftwPlanCache::release(plan);
+
+    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+    for (auto &bf : buf) fftwf_free(bf);
+    for (auto &bf : previous) fftwf_free(bf);
+    fftwf_free(twiddle);
+    for (auto &spectrum : fir) fftwf_free(spectrum);
+    fftwf_free(fdl);
+  }
+
+  // `count` is clamped to `maxPartition`. Internal states are reset.
+  void setPartition(size_t count)
+  {
+    nPartition = std::min(count, maxPartition);
+
+    // Multiply-accumulate costs `nPartition` times more, so it's split into more tasks.
+    macRowBatch = std::max(rowBatch / std::max(nPartition, size_t(1)), size_t(1));
+    nMacTask = nRow / macRowBatch;
+
+    nTask = 2 * nColTask + 2 * nRowTask + nMacTask;
+    nFadeTask = nTask + nColTask + nRowTask + nMacTask;
+
+    reset();
+  }
+
+  void setFir(std::vector<float> &source, size_t start, size_t end)
+  {
+    prepareFir(source, start, end);
+    swapFir();
+    crossfade = 1;
+    blockActive = active;
+    blockFade = false;
+    hasPrevious.fill(false);
+  }
+
+  /**
+  Taps in `[start, end)` are used. Taps beyond `nPartition * half` are ignored.
+
+  Can be called from other thread, if `isCrossfading()` is false. `fftwf_execute_dft` is
+  thread safe.
+  */
+  void prepareFir(std::vector<float> &source, size_t start, size_t end)
+  {
+    Complex *target = fir[active ^ 1];
+    std::fill(target, target + maxPartition * fftSize, Complex(0, 0));
+
+    for (size_t part = 0; part < nPartition; ++part) {
+      Complex *spectrum = target + part * fftSize;
+      const size_t first = start + part * half;
+      const size_t last = std::min(end, first + half);
+
+      // FFT scaling.
+      for (size_t idx = first; idx < last; ++idx) {
+        spectrum[idx - first] = source[idx] / float(fftSize);
+      }
+
+      for (size_t idx = 0; idx < nColTask; ++idx) transformColumn(0, spectrum, idx);
+      for (size_t idx = 0; idx < nRowTask; ++idx) transformRow(0, spectrum, idx);
+    }
+  }
+
+  void swapFir()
+  {
+    active ^= 1;
+    crossfade = 0;
+  }
+
+  void setCrossfade(float amount) { crossfade = amount; }
+
+  bool isCrossfading() { return crossfade < 1 || blockFade || blockActive != active; }
+
+  /**
+  Number of `process` calls after `swapFir` until the output of the first block computed
+  with both FIRs is read. Crossfade amount must stay 0 until then.
+  */
+  size_t fadeDelay()
+  {
+    if (nPartition == 0) return 0;
+    return ptr == 0 ? half : 2 * half - ptr;
+  }
+
+  void reset()
+  {
+    current = 0;
+    ptr = 0;
+    task = 0;
+    taskPhase = 0;
+    fdlIndex = 0;
+    blockTask = nTask;
+    hasPrevious.fill(false);
+
+    for (auto &bf : buf) std::fill(bf, bf + fftSize, Complex(0, 0));
+    std::fill(fdl, fdl + maxPartition * fftSize, Complex(0, 0));
+  }
+
+  float process(float input)
+  {
+    if (ptr == 0) {
+      blockActive = active;
+      blockFade = crossfade < 1;
+      blockTask = blockFade ? nFadeTask : nTask;
+      hasPrevious[(current + 2) % nBuffer] = blockFade;
+    }
+    if (nPartition == 0) return 0;
+
+    const size_t nextIndex = (current + 1) % nBuffer;
+    auto &&next = buf[nextIndex];
+    buf[current][half + ptr] = input;
+    next[ptr] = input;
+
+    // Runs `(ptr + 1) * blockTask / half - task` tasks.
+    taskPhase += blockTask;
+    while (taskPhase >= half) {
+      taskPhase -= half;
+      runTask(task++);
+    }
+
+    auto output = next[half + ptr].real();
+    if (hasPrevious[nextIndex] && crossfade < 1) {
+      auto prev = previous[nextIndex][half + ptr].real();
+      output = prev + crossfade * (output - prev);
+    }
+
+    if (++ptr >= half) {
+      ptr = 0;
+      task = 0;
+      taskPhase = 0;
+      current = (current + 1) % nBuffer;
+      if (++fdlIndex >= nPartition) fdlIndex = 0;
+    }
+    return output;
+  }
+
+private:
+  // Transforms `colBatch` columns. Twiddle factors are multiplied after forward
+  // transform, and before backward transform.
+  inline void transformColumn(size_t direction, Complex *data, size_t index)
+  {
+    const size_t col = index * colBatch;
+    if (direction == 0) {
+      fftwf_execute_dft(colPlan[0], cast(data + col), cast(data + col));
+      applyTwiddle<false>(data, col);
+    } else {
+      applyTwiddle<true>(data, col);
+      fftwf_execute_dft(colPlan[1], cast(data + col), cast(data + col));
+    }
+  }
+
+  template<bool conjugate> inline void applyTwiddle(Complex *data, size_t col)
+  {
+    for (size_t row = 0; row < nRow; ++row) {
+      Complex *x = data + row * nCol + col;
+      const Complex *tw = twiddle + row * nCol + col;
+      for (size_t i = 0; i < colBatch; ++i) {
+        x[i] = multiply(x[i], conjugate ? std::conj(tw[i]) : tw[i]);
+      }
+    }
+  }
+
+  // Pushes a chunk of input spectrum to FDL, and overwrites it with the sum of products
+  // of FDL and FIR spectra.
+  void multiplyAccumulate(Complex *data, size_t index)
+  {
+    const size_t start = index * macRowBatch * nCol;
+    const size_t end = start + macRowBatch * nCol;
+
+    std::copy(data + start, data + end, fdl + fdlIndex * fftSize + start);
+    accumulate(fir[blockActive], data, start, end);
+  }
+
+  // Applies previous FIR to a chunk of FDL, which is already pushed by
+  // `multiplyAccumulate`.
+  void multiplyAccumulatePrevious(Complex *dest, size_t index)
+  {
+    const size_t start = index * macRowBatch * nCol;
+    accumulate(fir[blockActive ^ 1], dest, start, start + macRowBatch * nCol);
+  }
+
+  // Loops are written to be vectorized.
+  void accumulate(const Complex *kernel, Complex *dest, size_t start, size_t end)
+  {
+    const Complex *latest = fdl + fdlIndex * fftSize;
+    for (size_t i = start; i < end; ++i) dest[i] = multiply(latest[i], kernel[i]);
+
+    for (size_t part = 1; part < nPartition; ++part) {
+      const size_t slot = (fdlIndex + nPartition - part) % nPartition;
+      const Complex *x = fdl + slot * fftSize;
+      const Complex *h = kernel + part * fftSize;
+      for (size_t i = start; i < end; ++i) dest[i] += multiply(x[i], h[i]);
+    }
+  }
+
+  // Transforms `rowBatch` rows.
+  inline void transformRow(size_t direction, Complex *data, size_t index)
+  {
+    Complex *x = data + index * rowBatch * nCol;
+    fftwf_execute_dft(rowPlan[direction], cast(x), cast(x));
+  }
+
+  // Tasks after `nTask` only run on a block with `blockFade`.
+  void runTask(size_t index)
+  {
+    const size_t bufIndex = (current + 2) % nBuffer;
+    auto &&data = buf[bufIndex];
+    auto &&prev = previous[bufIndex];
+
+    if (index < nColTask) return transformColumn(0, data, index);
+    index -= nColTask;
+    if (index < nRowTask) return transformRow(0, data, index);
+    index -= nRowTask;
+    if (index < nMacTask) return multiplyAccumulate(data, index);
+    index -= nMacTask;
+    if (index < nRowTask) return transformRow(1, data, index);
+    index -= nRowTask;
+    if (index < nColTask) return transformColumn(1, data, index);
+    index -= nColTask;
+    if (index < nMacTask) return multiplyAccumulatePrevious(prev, index);
+    index -= nMacTask;
+    if (index < nRowTask) return transformRow(1, prev, index);
+    index -= nRowTask;
+    transformColumn(1, prev, index);
+  }
+};
+
+/**
+Uniformly partitioned convolver without latency.
+
+Filter is split into 3 sections.
+
+- `[0, 2 * headBlock)`: `DirectConvolver`.
+- `[2 * headBlock, 2 * block)`: FDL of `headBlock` length partitions.
+- `[2 * block, nTap)`: FDL of `block` length partitions.
+
+Each FDL is processed by a single `TimeSlicedOverlapSaveConvolver`, so only 1 forward FFT
+and 1 inverse FFT are required per block. Each section starts at the latency of the
+section, so the total latency is 0.
+
+Kernel can be replaced while processing. Call `prepareFir` from other thread, then call
+`swapFir` on audio thread. Kernels are crossfaded over `fadeSamples`, with the same
+amount on each sample in all sections. The crossfade starts when both FDL sections have
+computed a block with both kernels, which is up to `2 * block` samples after `swapFir`.
+`prepareFir` must not be called while `isCrossfading()` is true.
+
+`setLength` skips the partitions after the given length, so CPU load scales with the
+length of FIR.
+*/
+template<size_t lengthInPow2, size_t blockSizeInPow2 = 11, size_t headBlockSizeInPow2 = 7>
+class UniformPartitionedConvolver {
+private:
+  static constexpr size_t nTap = size_t(1) << lengthInPow2;
+  static constexpr size_t blockSize = size_t(1) << blockSizeInPow2;
+  static constexpr size_t headBlockSize = size_t(1) << headBlockSizeInPow2;
+  static constexpr size_t nHeadPartition = 2 * blockSize / headBlockSize - 2;
+  static constexpr size_t nPartition = nTap / blockSize - 2;
+
+  DirectConvolver<float, 2 * headBlockSize> directConvolver;
+  TimeSlicedOverlapSaveConvolver headConvolver;
+  TimeSlicedOverlapSaveConvolver fdlConvolver;
+
+  size_t length = nTap;
+  size_t fadeDelay = 0;
+  size_t fadeSamples = 0;
+  size_t fadeCounter = 0;
+
+public:
+  UniformPartitionedConvolver()
+  {
+    static_assert(
+      lengthInPow2 > blockSizeInPow2 + 1,
+      "UniformPartitionedConvolver: lengthInPow2 must be greater than 1 + blockSize.");
+    static_assert(
+      blockSizeInPow2 > headBlockSizeInPow2,
+      "UniformPartitionedConvolver: blockSize must be greater than headBlockSize.");
+
+    headConvolver.init(headBlockSize, nHeadPartition);
+    fdlConvolver.init(blockSize, nPartition);
+    reset();
+  }
+
+  /**
+  Taps after `length` are ignored. `length` is clamped to `nTap`, and 0 disables the
+  convolver. Internal states are reset. Call `setFir` after this.
+  */
+  void setLength(size_t length)
+  {
+    this->length = std::min(length, nTap);
+
+    auto partition = [&](size_t start, size_t end, size_t size) {
+      return (std::clamp(this->length, start, end) - start + size - 1) / size;
+    };
+    headConvolver.setPartition(
+      partition(2 * headBlockSize, 2 * blockSize, headBlockSize));
+    fdlConvolver.setPartition(partition(2 * blockSize, nTap, blockSize));
+
+    reset();
+  }
+
+  void setFir(std::vector<float> &source)
+  {
+    if (source.size() < nTap) source.resize(nTap);
+
+    directConvolver.setFir(source);
+    headConvolver.setFir(source, 2 * headBlockSize, 2 * blockSize);
+    fdlConvolver.setFir(source, 2 * blockSize, nTap);
+    fadeDelay = 0;
+    fadeSamples = 0;
+    fadeCounter = 0;
+  }
+
+  void prepareFir(std::vector<float> &source)
+  {
+    if (source.size() < nTap) source.resize(nTap);
+
+    directConvolver.prepareFir(source);
+    headConvolver.prepareFir(source, 2 * headBlockSize, 2 * blockSize);
+    fdlConvolver.prepareFir(source, 2 * blockSize, nTap);
+  }
+
+  void swapFir(size_t fadeSamples)
+  {
+    directConvolver.swapFir();
+    headConvolver.swapFir();
+    fdlConvolver.swapFir();
+    fadeDelay = std::max(headConvolver.fadeDelay(), fdlConvolver.fadeDelay());
+    this->fadeSamples = fadeSamples;
+    fadeCounter = 0;
+    setCrossfade();
+  }
+
+  bool isCrossfading()
+  {
+    if (length == 0) return false;
+    return directConvolver.isCrossfading() || headConvolver.isCrossfading()
+      || fdlConvolver.isCrossfading();
+  }
+
+  void reset()
+  {
+    directConvolver.reset();
+    headConvolver.reset();
+    fdlConvolver.reset();
+  }
+
+  float process(float input)
+  {
+    if (fadeCounter < fadeDelay + fadeSamples) {
+      ++fadeCounter;
+      setCrossfade();
+    }
+    if (length == 0) return 0;
+
+    return directConvolver.process(input) + headConvolver.process(input)
+      + fdlConvolver.process(input);
+  }
+
+private:
+  void setCrossfade()
+  {
+    float amount = float(0);
+    if (fadeCounter >= fadeDelay + fadeSamples) {
+      amount = float(1);
+    } else if (fadeCounter > fadeDelay) {
+      amount = float(fadeCounter - fadeDelay) / float(fadeSamples);
+    }
+    directConvolver.setCrossfade(amount);
+    headConvolver.setCrossfade(amount);
+    fdlConvolver.setCrossfade(amount);
+  }
+};
+
 /**
 A variation of convolver without latency.
 
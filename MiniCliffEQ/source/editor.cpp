@@ -19,7 +19,7 @@ constexpr float splashWidth = 2 * labelWidth + margin;
 constexpr float splashHeight = 30.0f;
 
 constexpr int_least32_t defaultWidth = int_least32_t(2 * uiMargin + 2 * labelX - margin);
-constexpr int_least32_t defaultHeight = int_least32_t(2 * uiMargin + 7 * labelY);
+constexpr int_least32_t defaultHeight = int_least32_t(2 * uiMargin + 9 * labelY);
 
 namespace Steinberg {
 namespace Vst {
@@ -46,6 +46,13 @@ void Editor::valueChanged(CControl *pControl)
   ParamValue value = pControl->getValueNormalized();
   controller->setParamNormalized(id, value);
   controller->performEdit(id, value);
+
+  switch (id) {
+    case Synth::ParameterID::ID::minimumPhase:
+    case Synth::ParameterID::ID::adaptiveFirLength:
+    case Synth::ParameterID::ID::transitionWidthHz:
+      controller->getComponentHandler()->restartComponent(kLatencyChanged);
+  }
 }
 
 bool Editor::prepareUI()
@@ -58,6 +65,8 @@ bool Editor::prepareUI()
   const auto top1 = top0 + 3 * labelHeight + 2 * margin;
   const auto top2 = top1 + labelY;
   const auto top3 = top2 + labelY;
+  const auto top4 = top3 + labelY;
+  const auto top5 = top4 + labelY;
   const auto left0 = uiMargin;
   const auto left1 = left0 + labelX;
 
@@ -89,6 +98,18 @@ bool Editor::prepareUI()
     lowpassGainKnob->wheelSensitivity = 0.1f / 289.0f;
   }
 
+  addLabel(
+    left0, top4, labelWidth, labelHeight, uiTextSize, "Transition [Hz]", kLeftText);
+  auto transitionKnob = addTextKnob<Style::warning>(
+    left1, top4, labelWidth, labelHeight, uiTextSize, ID::transitionWidthHz,
+    Scales::transitionWidthHz, false, 5);
+  if (transitionKnob) transitionKnob->liveUpdate = false;
+  addCheckbox<Style::warning>(
+    left0, top5, labelWidth, labelHeight, uiTextSize, "Auto Length",
+    ID::adaptiveFirLength);
+  addCheckbox<Style::warning>(
+    left1, top5, labelWidth, labelHeight, uiTextSize, "Min. Phase", ID::minimumPhase);
+
   // Plugin name.
   const auto splashMargin = 2 * margin;
   const auto splashTop = defaultHeight - uiMargin - splashHeight;
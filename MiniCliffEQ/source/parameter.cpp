@@ -17,6 +17,7 @@ LinearScale<double> Scales::defaultScale(0.0, 1.0);
 // Range in [1, 24000] Hz.
 SemitoneScale<double> Scales::cutoffHz(-36.376316562295926, 138.232644862303, false);
 DecibelScale<double> Scales::gain(-144.5, 144.5, true);
+LogScale<double> Scales::transitionWidthHz(1.0, 4000.0, 0.5, 100.0);
 
 } // namespace Synth
 } // namespace Steinberg
@@ -31,6 +31,10 @@ enum ID {
 
   refreshFir,
 
+  minimumPhase,
+  adaptiveFirLength,
+  transitionWidthHz,
+
   ID_ENUM_LENGTH,
   ID_ENUM_GUI_START = ID_ENUM_LENGTH,
 };
@@ -42,6 +46,7 @@ struct Scales {
 
   static SomeDSP::SemitoneScale<double> cutoffHz;
   static SomeDSP::DecibelScale<double> gain;
+  static SomeDSP::LogScale<double> transitionWidthHz;
 };
 
 struct GlobalParameter : public ParameterInterface {
@@ -71,6 +76,14 @@ struct GlobalParameter : public ParameterInterface {
     value[ID::refreshFir] = std::make_unique<UIntValue>(
       0, Scales::boolScale, "refreshFir", Info::kCanAutomate);
 
+    value[ID::minimumPhase] = std::make_unique<UIntValue>(
+      0, Scales::boolScale, "minimumPhase", Info::kCanAutomate);
+    value[ID::adaptiveFirLength] = std::make_unique<UIntValue>(
+      0, Scales::boolScale, "adaptiveFirLength", Info::kCanAutomate);
+    value[ID::transitionWidthHz] = std::make_unique<LogValue>(
+      Scales::transitionWidthHz.invmap(100.0), Scales::transitionWidthHz,
+      "transitionWidthHz", Info::kCanAutomate);
+
     for (size_t id = 0; id < value.size(); ++id) value[id]->setId(Vst::ParamID(id));
   }
 
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+// Checks `UniformPartitionedConvolver` against direct convolution, and checks that
+// `swapFir` crossfades linearly from the previous kernel to the next kernel.
+
+#include "../source/dsp/fftconvolver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace SomeDSP;
+
+constexpr size_t lengthInPow2 = 13;
+constexpr size_t nTap = size_t(1) << lengthInPow2;
+constexpr size_t blockSize = size_t(1) << 11; // Default of `UniformPartitionedConvolver`.
+constexpr float sampleRate = 48000.0f;
+constexpr float tolerance = 1e-5f;
+
+using Convolver = UniformPartitionedConvolver<lengthInPow2>;
+
+std::vector<float> generateInput(size_t nFrame)
+{
+  std::minstd_rand rng{3456789};
+  std::uniform_real_distribution<float> uniform{-1.0f, 1.0f};
+
+  std::vector<float> data(nFrame);
+  for (auto &x : data) x = uniform(rng);
+  return data;
+}
+
+std::vector<float>
+convolve(const std::vector<float> &input, const std::vector<float> &fir)
+{
+  std::vector<float> output(input.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    double sum = 0;
+    for (size_t j = 0; j < fir.size() && j <= i; ++j) {
+      sum += double(fir[j]) * input[i - j];
+    }
+    output[i] = float(sum);
+  }
+  return output;
+}
+
+bool testDirect(const std::vector<float> &input, size_t length)
+{
+  auto fir = getNuttallFir(nTap, sampleRate, 1000.0f, false);
+  std::fill(fir.begin() + std::min(length, nTap), fir.end(), 0.0f);
+  auto expected = convolve(input, fir);
+
+  auto convolver = std::make_unique<Convolver>();
+  convolver->setLength(length);
+  convolver->setFir(fir);
+
+  float maxError = 0;
+  for (size_t i = 0; i < input.size(); ++i) {
+    maxError = std::max(maxError, std::abs(convolver->process(input[i]) - expected[i]));
+  }
+
+  std::cout << "length " << length << ": max error " << maxError << "\n";
+  return maxError <= tolerance;
+}
+
+/**
+Output during crossfade is `(1 - a) * previous + a * next`. `a` is estimated on each
+sample, and the start of ramp is solved from `a` assuming linear ramp over `fadeSamples`.
+All the estimates must point the same start within half a sample.
+*/
+bool testCrossfade(const std::vector<float> &input, size_t fadeSamples)
+{
+  auto firA = getNuttallFir(nTap, sampleRate, 1000.0f, false);
+  auto firB = getNuttallFir(nTap, sampleRate, 1000.0f, true);
+  auto yA = convolve(input, firA);
+  auto yB = convolve(input, firB);
+
+  auto convolver = std::make_unique<Convolver>();
+  convolver->setFir(firA);
+  convolver->prepareFir(firB);
+
+  const size_t swapAt = input.size() / 2 + 123; // Misaligned to block.
+  const size_t fadeEnd = swapAt + 2 * blockSize + fadeSamples;
+  if (fadeEnd >= input.size()) return false;
+
+  float maxError = 0;
+  double minStart = double(input.size());
+  double maxStart = 0;
+  for (size_t i = 0; i < input.size(); ++i) {
+    if (i == swapAt) convolver->swapFir(fadeSamples);
+    const float output = convolver->process(input[i]);
+
+    if (i < swapAt) {
+      maxError = std::max(maxError, std::abs(output - yA[i]));
+    } else if (i >= fadeEnd) {
+      maxError = std::max(maxError, std::abs(output - yB[i]));
+    } else {
+      const float diff = yB[i] - yA[i];
+      if (std::abs(diff) < 0.05f) continue;
+      const double amount = (output - yA[i]) / diff;
+      if (amount < -1e-3 || amount > 1 + 1e-3) {
+        maxError = std::max(maxError, float(std::abs(amount)));
+      } else if (amount > 1e-3 && amount < 1 - 1e-3) {
+        const double start = double(i) - amount * double(fadeSamples);
+        minStart = std::min(minStart, start);
+        maxStart = std::max(maxStart, start);
+      }
+    }
+  }
+
+  const double delay = minStart - double(swapAt);
+  std::cout << "fadeSamples " << fadeSamples << ": max error " << maxError
+            << ", ramp starts " << delay << " samples after swap, start deviation "
+            << maxStart - minStart << "\n";
+  return maxError <= tolerance && delay >= 0 && delay <= double(2 * blockSize)
+    && maxStart - minStart < 0.5;
+}
+
+int main()
+{
+  auto input = generateInput(3 * nTap);
+
+  bool isPassed = true;
+  for (size_t length : {nTap, size_t(5000), size_t(1000), size_t(200), size_t(0)}) {
+    isPassed &= testDirect(input, length);
+  }
+  for (size_t fadeSamples : {64, 300, 2400}) {
+    isPassed &= testCrossfade(input, fadeSamples);
+  }
+  return isPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
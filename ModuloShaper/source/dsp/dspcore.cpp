@@ -19,8 +19,8 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
 
   startup();
 }
@@ -29,7 +29,7 @@ void DSPCore::setup(double sampleRate)
   using ID = ParameterID::ID;                                                            \
   auto &pv = param.value;                                                                \
                                                                                          \
-  SmootherCommon<float>::setTime(pv[ID::smoothness]->getFloat());                        \
+  smootherContext.setTime(pv[ID::smoothness]->getFloat());                               \
                                                                                          \
   interpInputGain.METHOD(pv[ID::inputGain]->getFloat());                                 \
   interpClipGain.METHOD(pv[ID::clipGain]->getFloat());                                   \
@@ -88,19 +88,19 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   param.value[ParameterID::guiInputGain]->setFromFloat(
     std::max(maxAbs(length, in0), maxAbs(length, in1)));
 
   std::array<float, 2> frame{};
   for (size_t i = 0; i < length; ++i) {
-    auto inGain = interpInputGain.process();
-    auto clipGain = interpClipGain.process();
-    auto outGain = interpOutputGain.process();
-    auto add = interpAdd.process();
-    auto mul = interpMul.process();
-    auto cutoff = interpCutoff.process();
+    auto inGain = interpInputGain.process(smootherContext);
+    auto clipGain = interpClipGain.process(smootherContext);
+    auto outGain = interpOutputGain.process(smootherContext);
+    auto add = interpAdd.process(smootherContext);
+    auto mul = interpMul.process(smootherContext);
+    auto cutoff = interpCutoff.process(smootherContext);
 
     if (mul > 1.0f) clipGain /= mul;
 
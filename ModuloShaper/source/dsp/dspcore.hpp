@@ -39,6 +39,7 @@ private:
   size_t shaperType = 0; /* 0: naive, 1: oversample, 2: P-BLEP4, 3: P-BLEP8 */
   bool activateLowpass = true;
   bool activateLimiter = true;
+  SmootherContext<float> smootherContext;
   ExpSmoother<float> interpInputGain;
   ExpSmoother<float> interpClipGain;
   ExpSmoother<float> interpOutputGain;
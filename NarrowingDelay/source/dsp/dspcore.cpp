@@ -40,10 +40,8 @@ size_t DSPCore::getLatency() { return 0; }
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
-  lfoPhaseOffset.METHOD(pv[ID::lfoPhaseOffset]->getDouble());                            \
-  lfoPhaseConstant.METHOD(pv[ID::lfoPhaseConstant]->getDouble());                        \
   lfoShapeClip.METHOD(pv[ID::lfoShapeClip]->getDouble());                                \
   lfoShapeSkew.METHOD(pv[ID::lfoShapeSkew]->getDouble());                                \
   dryGain.METHOD(pv[ID::dryGain]->getDouble());                                          \
@@ -68,7 +66,7 @@ void DSPCore::updateUpRate()
   constexpr std::array<size_t, 3> fold{1, 2, 8};
   upRate = double(sampleRate) * fold[oversampling];
 
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 
   synchronizer.reset(upRate, defaultTempo, double(1));
 }
@@ -79,6 +77,8 @@ void DSPCore::reset()
   updateUpRate();
 
   ASSIGN_PARAMETER(reset);
+  lfoPhaseOffset.reset(pv[ID::lfoPhaseOffset]->getDouble());
+  lfoPhaseConstant.reset(pv[ID::lfoPhaseConstant]->getDouble());
 
   midiNotes.clear();
   noteStack.clear();
@@ -108,6 +108,8 @@ void DSPCore::setParameters()
   }
 
   ASSIGN_PARAMETER(push);
+  lfoPhaseOffset.push(pv[ID::lfoPhaseOffset]->getDouble(), smootherContext);
+  lfoPhaseConstant.push(pv[ID::lfoPhaseConstant]->getDouble(), smootherContext);
 }
 
 std::array<double, 2> DSPCore::processFrame(double in0, double in1)
@@ -117,18 +119,18 @@ std::array<double, 2> DSPCore::processFrame(double in0, double in1)
   lfoPhaseConstant.process();
   lfoPhaseOffset.process();
 
-  lfoShapeClip.process();
-  lfoShapeSkew.process();
-  outputGain.process();
-  dryGain.process();
-  wetGain.process();
-  feedback.process();
-  delayTimeSamples.process();
-  shiftPitch.process();
-  shiftFreq.process();
-  lfoToPrimaryDelayTime.process();
-  lfoToPrimaryShiftPitch.process();
-  lfoToPrimaryShiftHz.process();
+  lfoShapeClip.process(smootherContext);
+  lfoShapeSkew.process(smootherContext);
+  outputGain.process(smootherContext);
+  dryGain.process(smootherContext);
+  wetGain.process(smootherContext);
+  feedback.process(smootherContext);
+  delayTimeSamples.process(smootherContext);
+  shiftPitch.process(smootherContext);
+  shiftFreq.process(smootherContext);
+  lfoToPrimaryDelayTime.process(smootherContext);
+  lfoToPrimaryShiftPitch.process(smootherContext);
+  lfoToPrimaryShiftHz.process(smootherContext);
 
   // LFO.
   auto lfoPhase = synchronizer.process() + lfoPhaseConstant.getValue();
@@ -141,9 +143,13 @@ std::array<double, 2> DSPCore::processFrame(double in0, double in1)
 
   // Primary feedback shifter.
   auto fb0 = feedbackLowpass[0].lowpass(
-    feedbackHighpass[0].highpass(in0 - feedback.getValue() * feedbackBuffer[0]));
+    feedbackHighpass[0].highpass(
+      in0 - feedback.getValue() * feedbackBuffer[0], smootherContext),
+    smootherContext);
   auto fb1 = feedbackLowpass[1].lowpass(
-    feedbackHighpass[1].highpass(in1 - feedback.getValue() * feedbackBuffer[1]));
+    feedbackHighpass[1].highpass(
+      in1 - feedback.getValue() * feedbackBuffer[1], smootherContext),
+    smootherContext);
 
   auto modHz0
     = notePitch.getValue() * std::exp2(lfoOut0 * lfoToPrimaryShiftHz.getValue());
@@ -183,7 +189,7 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   // When tempo-sync is off, use defaultTempo BPM.
   bool isTempoSyncing = pv[ID::lfoTempoSync]->getInt();
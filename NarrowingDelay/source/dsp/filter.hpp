@@ -116,10 +116,10 @@ public:
     ic2eq = 0;
   }
 
-  Sample lowpass(Sample v0)
+  Sample lowpass(Sample v0, const SmootherContext<Sample> &context)
   {
-    auto gn = g.process();
-    auto kn = k.process();
+    auto gn = g.process(context);
+    auto kn = k.process(context);
     auto v1 = (ic1eq + gn * (v0 - ic2eq)) / (Sample(1) + gn * (gn + kn));
     auto v2 = ic2eq + gn * v1;
     ic1eq = Sample(2) * v1 - ic1eq;
@@ -127,10 +127,10 @@ public:
     return v2;
   }
 
-  Sample highpass(Sample v0)
+  Sample highpass(Sample v0, const SmootherContext<Sample> &context)
   {
-    auto gn = g.process();
-    auto kn = k.process();
+    auto gn = g.process(context);
+    auto kn = k.process(context);
     auto v1 = (ic1eq + gn * (v0 - ic2eq)) / (Sample(1) + gn * (gn + kn));
     auto v2 = ic2eq + gn * v1;
     ic1eq = Sample(2) * v1 - ic1eq;
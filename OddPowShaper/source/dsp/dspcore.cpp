@@ -19,8 +19,8 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
 
   startup();
 }
@@ -30,7 +30,7 @@ void DSPCore::reset()
   using ID = ParameterID::ID;
   auto &pv = param.value;
 
-  SmootherCommon<float>::setTime(pv[ID::smoothness]->getFloat());
+  smootherContext.setTime(pv[ID::smoothness]->getFloat());
 
   interpDrive.reset(pv[ID::drive]->getFloat() * pv[ID::boost]->getFloat());
   interpOutputGain.reset(pv[ID::outputGain]->getFloat());
@@ -54,7 +54,7 @@ void DSPCore::setParameters()
   using ID = ParameterID::ID;
   auto &pv = param.value;
 
-  SmootherCommon<float>::setTime(pv[ID::smoothness]->getFloat());
+  smootherContext.setTime(pv[ID::smoothness]->getFloat());
 
   interpDrive.push(pv[ID::drive]->getFloat() * pv[ID::boost]->getFloat());
   interpOutputGain.push(pv[ID::outputGain]->getFloat());
@@ -79,15 +79,15 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   param.value[ParameterID::guiInputGain]->setFromFloat(
     std::max(maxAbs(length, in0), maxAbs(length, in1)));
 
   std::array<float, 2> frame{};
   for (uint32_t i = 0; i < length; ++i) {
-    auto drive = interpDrive.process();
-    auto outGain = interpOutputGain.process();
+    auto drive = interpDrive.process(smootherContext);
+    auto outGain = interpOutputGain.process(smootherContext);
 
     frame[0] = in0[i];
     frame[1] = in1[i];
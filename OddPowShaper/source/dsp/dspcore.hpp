@@ -36,6 +36,7 @@ private:
 
   bool oversample = true;
   bool activateLimiter = true;
+  SmootherContext<float> smootherContext;
   ExpSmoother<float> interpDrive;
   ExpSmoother<float> interpOutputGain;
 };
@@ -32,7 +32,7 @@ size_t DSPCore::getLatency() { return 0; }
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
   lfo.interpType = pv[ID::lfoInterpolation]->getInt();                                   \
   for (size_t idx = 0; idx < nLfoWavetable; ++idx) {                                     \
@@ -41,8 +41,6 @@ size_t DSPCore::getLatency() { return 0; }
                                                                                          \
   outputGain.METHOD(pv[ID::outputGain]->getDouble());                                    \
   mix.METHOD(pv[ID::mix]->getDouble());                                                  \
-  lfoPhaseOffset.METHOD(pv[ID::lfoPhaseOffset]->getDouble());                            \
-  lfoPhaseConstant.METHOD(pv[ID::lfoPhaseConstant]->getDouble());                        \
   cutoffSpread.METHOD(pv[ID::cutoffSpread]->getDouble());                                \
   cutoffMinHz.METHOD(pv[ID::cutoffMinHz]->getDouble());                                  \
   cutoffMaxHz.METHOD(pv[ID::cutoffMaxHz]->getDouble());                                  \
@@ -59,7 +57,7 @@ void DSPCore::updateUpRate()
   auto fold = oversampling ? upFold : size_t(1);
   upRate = double(sampleRate) * fold;
 
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 
   synchronizer.reset(upRate, defaultTempo, double(1));
   lfo.setup(upRate, double(0.1));
@@ -71,6 +69,8 @@ void DSPCore::reset()
   updateUpRate();
 
   ASSIGN_PARAMETER(reset);
+  lfoPhaseOffset.reset(pv[ID::lfoPhaseOffset]->getDouble());
+  lfoPhaseConstant.reset(pv[ID::lfoPhaseConstant]->getDouble());
 
   midiNotes.clear();
   noteStack.clear();
@@ -110,6 +110,8 @@ void DSPCore::setParameters()
   }
 
   ASSIGN_PARAMETER(push);
+  lfoPhaseOffset.push(pv[ID::lfoPhaseOffset]->getDouble(), smootherContext);
+  lfoPhaseConstant.push(pv[ID::lfoPhaseConstant]->getDouble(), smootherContext);
 }
 
 void DSPCore::processFrame(std::array<double, 2> &frame)
@@ -122,16 +124,16 @@ void DSPCore::processFrame(std::array<double, 2> &frame)
   lfoPhaseConstant.process();
   lfoPhaseOffset.process();
 
-  outputGain.process();
-  mix.process();
-  cutoffSpread.process();
-  auto cutMinHz = cutoffMinHz.process();
-  auto cutMaxHz = cutoffMaxHz.process();
-  feedback.process();
-  delayTimeSamples.process();
-  lfoToDelay.process();
-  inputToFeedbackGain.process();
-  inputToDelayTime.process();
+  outputGain.process(smootherContext);
+  mix.process(smootherContext);
+  cutoffSpread.process(smootherContext);
+  auto cutMinHz = cutoffMinHz.process(smootherContext);
+  auto cutMaxHz = cutoffMaxHz.process(smootherContext);
+  feedback.process(smootherContext);
+  delayTimeSamples.process(smootherContext);
+  lfoToDelay.process(smootherContext);
+  inputToFeedbackGain.process(smootherContext);
+  inputToDelayTime.process(smootherContext);
 
   lfo.offset[0] = lfoPhaseConstant.getValue() + lfoPhaseOffset.getValue();
   lfo.offset[1] = lfoPhaseConstant.getValue() - lfoPhaseOffset.getValue();
@@ -144,7 +146,7 @@ void DSPCore::processFrame(std::array<double, 2> &frame)
   auto apCut1 = (centerHz + rangeHz * lfo.output[1]) / upRate;
 
   std::array<double, 2> dt{};
-  auto delayTimeBase = delayTimeSamples.process() * notePitchToDelayTimeRelease.v2;
+  auto delayTimeBase = delayTimeSamples.process(smootherContext) * notePitchToDelayTimeRelease.v2;
   auto baseTime0
     = delayTimeBase * lerp(double(1), std::abs(frame[0]), inputToDelayTime.getValue());
   auto baseTime1
@@ -223,7 +225,7 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   // When tempo-sync is off, use defaultTempo BPM.
   bool isTempoSyncing = pv[ID::lfoTempoSync]->getInt();
@@ -24,8 +24,8 @@ void DSPCore::setup(double sampleRate)
   this->sampleRate = float(sampleRate);
   auto maxRate = float(sampleRate) * OverSampler::fold;
 
-  SmootherCommon<float>::setSampleRate(maxRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(maxRate);
+  smootherContext.setTime(0.2f);
 
   gate.setup(sampleRate, 0.001f);
 
@@ -126,15 +126,15 @@ inline void convertToLeftRight(float &mid, float &side)
 
 std::array<float, 2> DSPCore::processInternal(float ch0, float ch1)
 {
-  auto combRate = interpCombInterpRate.process();
-  auto combCutoffKp = interpCombInterpCutoffKp.process();
-  auto feedback = interpFeedback.process();
-  auto feedbackHighpassKp = interpFeedbackHighpassCutoffKp.process();
-  auto stereoCross = interpStereoCross.process();
-  auto toDelayTime = interpFeedbackToDelayTime.process();
-  auto gateReleaseKp = interpGateReleaseKp.process();
-  auto dry = interpDry.process();
-  auto wet = interpWet.process();
+  auto combRate = interpCombInterpRate.process(smootherContext);
+  auto combCutoffKp = interpCombInterpCutoffKp.process(smootherContext);
+  auto feedback = interpFeedback.process(smootherContext);
+  auto feedbackHighpassKp = interpFeedbackHighpassCutoffKp.process(smootherContext);
+  auto stereoCross = interpStereoCross.process(smootherContext);
+  auto toDelayTime = interpFeedbackToDelayTime.process(smootherContext);
+  auto gateReleaseKp = interpGateReleaseKp.process(smootherContext);
+  auto dry = interpDry.process(smootherContext);
+  auto wet = interpWet.process(smootherContext);
 
   auto gateOut = gate.process(std::max(std::fabs(ch0), std::fabs(ch1)), gateReleaseKp);
 
@@ -168,8 +168,8 @@ void DSPCore::process(
   float upfold = overSampling ? OverSampler::fold : float(1);
   float upRate = upfold * sampleRate;
 
-  SmootherCommon<float>::setBufferSize(float(length));
-  SmootherCommon<float>::setSampleRate(upRate);
+  smootherContext.setBufferSize(float(length));
+  smootherContext.setSampleRate(upRate);
 
   bool enableMidSide = pv[ID::channelType]->getInt();
 
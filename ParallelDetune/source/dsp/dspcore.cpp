@@ -31,7 +31,7 @@ void DSPCore::setup(double sampleRate)
 
   for (auto &ps : pitchShifter) ps.setup(size_t(upRate * maxDelayTime));
 
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 
   synchronizer.reset(upRate, defaultTempo, double(1));
   lfo.setup(upRate, double(0.1));
@@ -46,15 +46,13 @@ size_t DSPCore::getLatency() { return 0; }
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
   lfo.interpType = pv[ID::lfoInterpolation]->getInt();                                   \
   for (size_t idx = 0; idx < nLfoWavetable; ++idx) {                                     \
     lfo.source[idx + 1] = pv[ID::lfoWavetable0 + idx]->getFloat();                       \
   }                                                                                      \
                                                                                          \
-  lfoPhaseOffset.METHOD(pv[ID::lfoPhaseOffset]->getDouble());                            \
-  lfoPhaseConstant.METHOD(pv[ID::lfoPhaseConstant]->getDouble());                        \
   dryGain.METHOD(pv[ID::dryGain]->getDouble());                                          \
   wetGain.METHOD(pv[ID::wetGain]->getDouble() / nShifter);                               \
   panSpread.METHOD(pv[ID::panSpread]->getDouble());                                      \
@@ -90,6 +88,8 @@ size_t DSPCore::getLatency() { return 0; }
 void DSPCore::reset()
 {
   ASSIGN_PARAMETER(reset);
+  lfoPhaseOffset.reset(pv[ID::lfoPhaseOffset]->getDouble());
+  lfoPhaseConstant.reset(pv[ID::lfoPhaseConstant]->getDouble());
 
   midiNotes.clear();
   noteStack.clear();
@@ -113,7 +113,12 @@ void DSPCore::reset()
 
 void DSPCore::startup() { synchronizer.reset(upRate, tempo, getTempoSyncInterval()); }
 
-void DSPCore::setParameters() { ASSIGN_PARAMETER(push); }
+void DSPCore::setParameters()
+{
+  ASSIGN_PARAMETER(push);
+  lfoPhaseOffset.push(pv[ID::lfoPhaseOffset]->getDouble(), smootherContext);
+  lfoPhaseConstant.push(pv[ID::lfoPhaseConstant]->getDouble(), smootherContext);
+}
 
 std::array<double, 2> DSPCore::processFrame(double in0, double in1)
 {
@@ -122,23 +127,23 @@ std::array<double, 2> DSPCore::processFrame(double in0, double in1)
   lfoPhaseConstant.process();
   lfoPhaseOffset.process();
 
-  outputGain.process();
-  dryGain.process();
-  wetGain.process();
-  panSpread.process();
-  lfoToPan.process();
-  tremoloMix.process();
-  tremoloLean.process();
-  feed.process();
-  lfoToDelayTime.process();
-  lfoToShiftPitch.process();
+  outputGain.process(smootherContext);
+  dryGain.process(smootherContext);
+  wetGain.process(smootherContext);
+  panSpread.process(smootherContext);
+  lfoToPan.process(smootherContext);
+  tremoloMix.process(smootherContext);
+  tremoloLean.process(smootherContext);
+  feed.process(smootherContext);
+  lfoToDelayTime.process(smootherContext);
+  lfoToShiftPitch.process(smootherContext);
 
-  shiftPitch.process();
-  delayTimeSamples.process();
-  shifterGain.process();
+  shiftPitch.process(smootherContext);
+  delayTimeSamples.process(smootherContext);
+  shifterGain.process(smootherContext);
 
-  highpassG.process();
-  lowpassG.process();
+  highpassG.process(smootherContext);
+  lowpassG.process(smootherContext);
 
   // LFO.
   lfo.offset[0] = lfoPhaseConstant.getValue() + lfoPhaseOffset.getValue();
@@ -225,7 +230,7 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   // When tempo-sync is off, use defaultTempo BPM.
   bool isTempoSyncing = pv[ID::lfoTempoSync]->getInt();
@@ -39,8 +39,8 @@ void DSPCore::setup(double sampleRate)
 
   phaseSyncCutoffKp = float(EMAFilter<double>::cutoffToP(sampleRate, 0.1));
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate * OverSampler::fold);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate * OverSampler::fold);
+  smootherContext.setTime(0.2f);
 
   synchronizer.reset(this->sampleRate * OverSampler::fold, defaultTempo, 1.0f);
   lfo.setup(this->sampleRate * OverSampler::fold, 0.02f * OverSampler::fold);
@@ -59,7 +59,7 @@ size_t DSPCore::getLatency() { return 0; }
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<float>::setTime(pv[ID::smoothingTime]->getFloat());                     \
+  smootherContext.setTime(pv[ID::smoothingTime]->getFloat());                            \
                                                                                          \
   lfo.interpType = pv[ID::lfoInterpolation]->getInt();                                   \
   for (size_t idx = 0; idx < nLfoWavetable; ++idx) {                                     \
@@ -150,7 +150,7 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   // When tempo-sync is off, use defaultTempo BPM.
   bool isTempoSyncing = pv[ID::lfoTempoSync]->getInt();
@@ -170,21 +170,21 @@ void DSPCore::process(
     overSampler[0].push(sig0);
     overSampler[1].push(sig1);
     for (size_t idx = 0; idx < OverSampler::fold; ++idx) {
-      auto pitchMain = interpPitchMain.process();
-      auto pitchUnison = interpPitchUnison.process();
-      auto lfoStereoOffset = interpLfoStereoOffset.process();
-      auto lfoUnisonOffset = interpLfoUnisonOffset.process();
-      auto lfoToPitch = interpLfoToPitch.process();
-      auto lfoToUnison = interpLfoToUnison.process();
-      auto delayTime = interpDelayTime.process();
-      auto stereoLean = interpStereoLean.process();
-      auto feedback = interpFeedback.process();
-      auto highpassKp = interpHighpassCutoffKp.process();
-      auto pitchCross = interpPitchCross.process();
-      auto stereoCross = interpStereoCross.process();
-      auto unisonMix = interpUnisonMix.process();
-      auto dry = interpDry.process();
-      auto wet = interpWet.process();
+      auto pitchMain = interpPitchMain.process(smootherContext);
+      auto pitchUnison = interpPitchUnison.process(smootherContext);
+      auto lfoStereoOffset = interpLfoStereoOffset.process(smootherContext);
+      auto lfoUnisonOffset = interpLfoUnisonOffset.process(smootherContext);
+      auto lfoToPitch = interpLfoToPitch.process(smootherContext);
+      auto lfoToUnison = interpLfoToUnison.process(smootherContext);
+      auto delayTime = interpDelayTime.process(smootherContext);
+      auto stereoLean = interpStereoLean.process(smootherContext);
+      auto feedback = interpFeedback.process(smootherContext);
+      auto highpassKp = interpHighpassCutoffKp.process(smootherContext);
+      auto pitchCross = interpPitchCross.process(smootherContext);
+      auto stereoCross = interpStereoCross.process(smootherContext);
+      auto unisonMix = interpUnisonMix.process(smootherContext);
+      auto dry = interpDry.process(smootherContext);
+      auto wet = interpWet.process(smootherContext);
 
       auto crossMainTemp0 = lerp(shifterMainOut[0], shifterUnisonOut[0], pitchCross);
       auto crossMainTemp1 = lerp(shifterMainOut[1], shifterUnisonOut[1], pitchCross);
@@ -47,7 +47,7 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = double(sampleRate);
 
-  SmootherCommon<double>::setSampleRate(sampleRate);
+  smootherContext.setSampleRate(sampleRate);
 
   size_t bufferSize = size_t(sampleRate * maxLimiterAttackSeconds) + 1;
   for (auto &x : delay) x.resize(bufferSize);
@@ -66,7 +66,7 @@ size_t DSPCore::getLatency()
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
   outputGain.METHOD(pv[ID::outputGain]->getDouble());                                    \
   sideMix.METHOD(pv[ID::sideMix]->getDouble());                                          \
@@ -114,11 +114,11 @@ void DSPCore::setParameters() { ASSIGN_PARAMETER(push); }
 
 std::array<double, 2> DSPCore::processFrame(const std::array<double, 4> &frame)
 {
-  outputGain.process();
-  sideMix.process();
-  ringSubtractMix.process();
-  inputGain.process();
-  sideGain.process();
+  outputGain.process(smootherContext);
+  sideMix.process(smootherContext);
+  ringSubtractMix.process(smootherContext);
+  inputGain.process(smootherContext);
+  sideGain.process(smootherContext);
 
   auto in0 = frame[0] * inputGain.getValue();
   auto in1 = frame[1] * inputGain.getValue();
@@ -138,7 +138,7 @@ std::array<double, 2> DSPCore::processFrame(const std::array<double, 4> &frame)
   auto sig0 = lerp(ring0, sub0, ringSubtractMix.getValue()) + side0 * sideMix.getValue();
   auto sig1 = lerp(ring1, sub1, ringSubtractMix.getValue()) + side1 * sideMix.getValue();
 
-  return {outputGain.process() * sig0, outputGain.process() * sig1};
+  return {outputGain.process(smootherContext) * sig0, outputGain.process(smootherContext) * sig1};
 }
 
 void DSPCore::process(
@@ -155,7 +155,7 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   for (size_t i = 0; i < length; ++i) {
     auto frame = processFrame({in0[i], in1[i], in2[i], in3[i]});
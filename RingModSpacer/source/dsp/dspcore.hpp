@@ -37,6 +37,7 @@ private:
 
   double sampleRate = 44100;
 
+  SmootherContext<double> smootherContext;
   ExpSmoother<double> outputGain;
   ExpSmoother<double> sideMix;
   ExpSmoother<double> ringSubtractMix;
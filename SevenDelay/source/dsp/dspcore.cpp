@@ -35,7 +35,7 @@ template<typename T> inline T calcNotePitch(T note)
 
 void DSPCore::setup(double sampleRate)
 {
-  SmootherCommon<double>::setSampleRate(double(sampleRate));
+  smootherContext.setSampleRate(double(sampleRate));
 
   for (size_t i = 0; i < delay.size(); ++i)
     delay[i].setup(double(sampleRate), double(1), maxDelayTime);
@@ -73,46 +73,50 @@ void DSPCore::startup()
 
 void DSPCore::setParameters()
 {
-  SmootherCommon<double>::setTime(param.value[ParameterID::smoothness]->getDouble());
+  using ID = ParameterID::ID;
+  const auto &pv = param.value;
+  const auto &sc = smootherContext;
+
+  smootherContext.setTime(pv[ID::smoothness]->getDouble());
 
   // This won't work if sync is on and tempo < 15. Up to 8 sec or 8/16 beat.
   // 15.0 comes from (60 sec per minute) * (4 beat) / (16 beat).
-  auto time = param.value[ParameterID::time]->getDouble() * notePitchMultiplier;
-  if (param.value[ParameterID::tempoSync]->getInt()) {
+  auto time = pv[ID::time]->getDouble() * notePitchMultiplier;
+  if (pv[ID::tempoSync]->getInt()) {
     if (time < double(1))
       time *= double(15) / double(tempo);
     else
       time = std::floor(double(2) * time) * double(7.5) / double(tempo);
   }
 
-  auto offset = param.value[ParameterID::offset]->getDouble();
-  interpTime[0].push(offset < double(0) ? time * (double(1) + offset) : time);
-  interpTime[1].push(offset > double(0) ? time * (double(1) - offset) : time);
+  auto offset = pv[ID::offset]->getDouble();
+  interpTime[0].push(offset < double(0) ? time * (double(1) + offset) : time, sc);
+  interpTime[1].push(offset > double(0) ? time * (double(1) - offset) : time, sc);
 
-  interpWetMix.push(param.value[ParameterID::wetMix]->getDouble());
-  interpDryMix.push(param.value[ParameterID::dryMix]->getDouble());
+  interpWetMix.push(pv[ID::wetMix]->getDouble(), sc);
+  interpDryMix.push(pv[ID::dryMix]->getDouble(), sc);
   interpFeedback.push(
-    param.value[ParameterID::negativeFeedback]->getInt()
-      ? -param.value[ParameterID::feedback]->getDouble()
-      : param.value[ParameterID::feedback]->getDouble());
-  interpLfoTimeAmount.push(param.value[ParameterID::lfoTimeAmount]->getDouble());
-  interpLfoToneAmount.push(param.value[ParameterID::lfoToneAmount]->getDouble());
-  interpLfoFrequency.push(param.value[ParameterID::lfoFrequency]->getDouble());
-  interpLfoShape.push(param.value[ParameterID::lfoShape]->getDouble());
-
-  interpPanIn.push(param.value[ParameterID::inPan]->getDouble());
-  interpSpreadIn.push(param.value[ParameterID::inSpread]->getDouble());
-  interpPanOut.push(param.value[ParameterID::outPan]->getDouble());
-  interpSpreadOut.push(param.value[ParameterID::outSpread]->getDouble());
-
-  interpToneCutoff.push(param.value[ParameterID::toneCutoff]->getDouble());
-  interpToneQ.push(param.value[ParameterID::toneQ]->getDouble());
+    pv[ID::negativeFeedback]->getInt() ? -pv[ID::feedback]->getDouble()
+                                       : pv[ID::feedback]->getDouble(),
+    sc);
+  interpLfoTimeAmount.push(pv[ID::lfoTimeAmount]->getDouble(), sc);
+  interpLfoToneAmount.push(pv[ID::lfoToneAmount]->getDouble(), sc);
+  interpLfoFrequency.push(pv[ID::lfoFrequency]->getDouble(), sc);
+  interpLfoShape.push(pv[ID::lfoShape]->getDouble(), sc);
+
+  interpPanIn.push(pv[ID::inPan]->getDouble(), sc);
+  interpSpreadIn.push(pv[ID::inSpread]->getDouble(), sc);
+  interpPanOut.push(pv[ID::outPan]->getDouble(), sc);
+  interpSpreadOut.push(pv[ID::outSpread]->getDouble(), sc);
+
+  interpToneCutoff.push(pv[ID::toneCutoff]->getDouble(), sc);
+  interpToneQ.push(pv[ID::toneQ]->getDouble(), sc);
   interpToneMix.push(
-    double(Scales::toneMix.map(param.value[ParameterID::toneCutoff]->getNormalized())));
+    double(Scales::toneMix.map(pv[ID::toneCutoff]->getNormalized())), sc);
 
-  interpDCKill.push(param.value[ParameterID::dckill]->getDouble());
-  interpDCKillMix.push(double(
-    Scales::dckillMix.reverseMap(param.value[ParameterID::dckill]->getNormalized())));
+  interpDCKill.push(pv[ID::dckill]->getDouble(), sc);
+  interpDCKillMix.push(
+    double(Scales::dckillMix.reverseMap(pv[ID::dckill]->getNormalized())), sc);
 }
 
 void DSPCore::process(
@@ -120,7 +124,7 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   const bool lfoHold = !param.value[ParameterID::lfoHold]->getInt();
   for (size_t i = 0; i < length; ++i) {
@@ -215,6 +219,7 @@ void DSPCore::updateDelayTime()
   }
 
   auto offset = param.value[ParameterID::offset]->getFloat();
-  interpTime[0].push(offset < double(0) ? time * (double(1) + offset) : time);
-  interpTime[1].push(offset > double(0) ? time * (double(1) - offset) : time);
+  const auto &sc = smootherContext;
+  interpTime[0].push(offset < double(0) ? time * (double(1) + offset) : time, sc);
+  interpTime[1].push(offset > double(0) ? time * (double(1) - offset) : time, sc);
 }
@@ -70,20 +70,14 @@ tresult PLUGIN_API PlugProcessor::setActive(TBool state)
 
 tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
 {
-  // Read inputs parameter changes.
-  if (data.inputParameterChanges) {
-    int32 parameterCount = data.inputParameterChanges->getParameterCount();
-    for (int32 index = 0; index < parameterCount; index++) {
-      auto queue = data.inputParameterChanges->getParameterData(index);
-      if (!queue) continue;
-      Vst::ParamValue value;
-      int32 sampleOffset;
-      if (queue->getPoint(queue->getPointCount() - 1, sampleOffset, value) != kResultTrue)
-        continue;
-      size_t id = queue->getParameterId();
-      if (id < dsp.param.value.size()) dsp.param.value[id]->setFromNormalized(value);
-    }
-  }
+  // Read inputs parameter changes. Points after the first frame are applied in
+  // `automation.splitBlock`.
+  automation.fetch(data.inputParameterChanges);
+  auto setParameter = [&](Vst::ParamID id, Vst::ParamValue value) {
+    if (id < dsp.param.value.size()) dsp.param.value[id]->setFromNormalized(value);
+  };
+  automation.dispatch(0, setParameter);
+  noteEvents.fetch(data.inputEvents);
 
   if (data.processContext != nullptr) {
     uint64_t state = data.processContext->state;
@@ -99,64 +93,49 @@ tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
     lastState = state;
   }
 
-  dsp.setParameters();
+  if (
+    data.numInputs == 0 || data.numOutputs == 0 || data.numSamples <= 0
+    || data.inputs[0].numChannels < 2 || data.outputs[0].numChannels < 2
+    || data.symbolicSampleSize == Vst::kSample64)
+  {
+    automation.dispatch(ParameterAutomation::endOffset, setParameter);
+    dsp.setParameters();
+    return kResultOk;
+  }
 
-  if (data.numInputs == 0) return kResultOk;
-  if (data.numOutputs == 0) return kResultOk;
-  if (data.numSamples <= 0) return kResultOk;
-  if (data.inputs[0].numChannels < 2) return kResultOk;
-  if (data.outputs[0].numChannels < 2) return kResultOk;
-  if (data.symbolicSampleSize == Vst::kSample64) return kResultOk;
+  dsp.setParameters();
 
-  if (data.inputEvents != nullptr) handleEvent(data);
-
-  auto isBypassing = dsp.param.value[ParameterID::bypass]->getInt();
-  if (isBypassing) {
-    if (!wasBypassing) dsp.reset();
-    processBypass(data);
-  } else {
-    float *in0 = data.inputs[0].channelBuffers32[0];
-    float *in1 = data.inputs[0].channelBuffers32[1];
-    float *out0 = data.outputs[0].channelBuffers32[0];
-    float *out1 = data.outputs[0].channelBuffers32[1];
-    dsp.process((size_t)data.numSamples, in0, in1, out0, out1);
-  }
-  wasBypassing = isBypassing;
+  float *in0 = data.inputs[0].channelBuffers32[0];
+  float *in1 = data.inputs[0].channelBuffers32[1];
+  float *out0 = data.outputs[0].channelBuffers32[0];
+  float *out1 = data.outputs[0].channelBuffers32[1];
+  automation.splitBlock(
+    data.numSamples, setParameter, [&](size_t begin, size_t end) {
+      if (begin > 0) dsp.setParameters();
+      noteEvents.dispatch(begin, end, size_t(data.numSamples), [&](const auto &nt) {
+        dsp.pushMidiNote(nt.isNoteOn, nt.frame, nt.id, nt.pitch, nt.tuning, nt.velocity);
+      });
+
+      auto isBypassing = dsp.param.value[ParameterID::bypass]->getInt();
+      if (isBypassing) {
+        if (!wasBypassing) dsp.reset();
+        processBypass(data, begin, end);
+      } else {
+        dsp.process(end - begin, in0 + begin, in1 + begin, out0 + begin, out1 + begin);
+      }
+      wasBypassing = isBypassing;
+    });
 
   return kResultOk;
 }
 
-void PlugProcessor::processBypass(Vst::ProcessData &data)
+void PlugProcessor::processBypass(Vst::ProcessData &data, size_t begin, size_t end)
 {
   float **in = data.inputs[0].channelBuffers32;
   float **out = data.outputs[0].channelBuffers32;
   for (int32_t ch = 0; ch < data.inputs[0].numChannels; ch++) {
-    if (in[ch] != out[ch]) memcpy(out[ch], in[ch], data.numSamples * sizeof(float));
-  }
-}
-
-void PlugProcessor::handleEvent(Vst::ProcessData &data)
-{
-  for (int32 index = 0; index < data.inputEvents->getEventCount(); ++index) {
-    Vst::Event event;
-    if (data.inputEvents->getEvent(index, event) != kResultOk) continue;
-    switch (event.type) {
-      case Vst::Event::kNoteOnEvent: {
-        dsp.pushMidiNote(
-          true, event.sampleOffset,
-          event.noteOn.noteId == -1 ? event.noteOn.pitch : event.noteOn.noteId,
-          event.noteOn.pitch, event.noteOn.tuning, event.noteOn.velocity);
-      } break;
-
-      case Vst::Event::kNoteOffEvent: {
-        dsp.pushMidiNote(
-          false, event.sampleOffset,
-          event.noteOff.noteId == -1 ? event.noteOff.pitch : event.noteOff.noteId, 0, 0,
-          0);
-      } break;
-
-        // Add other event type here.
-    }
+    if (in[ch] != out[ch])
+      memcpy(out[ch] + begin, in[ch] + begin, (end - begin) * sizeof(float));
   }
 }
 
@@ -10,6 +10,8 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/noteeventlist.hpp"
+#include "../../common/parameterautomation.hpp"
 #include "dsp/dspcore.hpp"
 
 namespace Steinberg {
@@ -39,14 +41,14 @@ public:
     return (Vst::IAudioProcessor *)new PlugProcessor();
   }
 
-  void processBypass(Vst::ProcessData &data);
+  void processBypass(Vst::ProcessData &data, size_t begin, size_t end);
 
 protected:
-  void handleEvent(Vst::ProcessData &data);
-
   uint32_t lastState = 0;
   uint32_t wasBypassing = 0;
   float tempo = 120.0f;
+  ParameterAutomation automation;
+  NoteEventList noteEvents;
   DSPCore dsp;
 };
 
@@ -19,8 +19,8 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
 
   startup();
 }
@@ -30,7 +30,7 @@ void DSPCore::setup(double sampleRate)
                                                                                          \
   using ID = ParameterID::ID;                                                            \
                                                                                          \
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());               \
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());                      \
                                                                                          \
   interpInputGain.METHOD(param.value[ID::inputGain]->getFloat());                        \
   interpOutputGain.METHOD(param.value[ID::outputGain]->getFloat());                      \
@@ -62,18 +62,18 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   param.value[ParameterID::guiInputGain]->setFromFloat(
     std::max(maxAbs(length, in0), maxAbs(length, in1)));
 
   for (uint32_t i = 0; i < length; ++i) {
-    auto inGain = interpInputGain.process();
-    auto outGain = interpOutputGain.process();
-    auto clip = interpClip.process();
-    auto order = interpOrder.process();
-    auto ratio = interpRatio.process();
-    auto slope = interpSlope.process();
+    auto inGain = interpInputGain.process(smootherContext);
+    auto outGain = interpOutputGain.process(smootherContext);
+    auto clip = interpClip.process(smootherContext);
+    auto order = interpOrder.process(smootherContext);
+    auto ratio = interpRatio.process(smootherContext);
+    auto slope = interpSlope.process(smootherContext);
 
     shaper[0].set(clip, order, ratio, slope);
     shaper[1].set(clip, order, ratio, slope);
@@ -33,6 +33,7 @@ private:
   std::array<SoftClipper<float>, 2> shaper;
 
   bool oversample = true;
+  SmootherContext<float> smootherContext;
   ExpSmoother<float> interpInputGain;
   ExpSmoother<float> interpOutputGain;
   ExpSmoother<float> interpClip;
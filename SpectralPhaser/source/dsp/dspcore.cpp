@@ -15,7 +15,7 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = Sample(sampleRate);
 
-  SmootherCommon<Sample>::setSampleRate(sampleRate);
+  smootherContext.setSampleRate(sampleRate);
 
   lfoSyncRate = EMAFilter<double>::secondToP(sampleRate, Sample(0.013));
 
@@ -29,7 +29,7 @@ size_t DSPCore::getLatency() { return spcParam.reportLatency ? spcParam.frmSize
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<Sample>::setTime(pv[ID::parameterSmoothingSecond]->getFloat());         \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getFloat());                 \
                                                                                          \
   spcParam.sideChain = pv[ID::sideChainSwitch]->getInt();                                \
   spcParam.reportLatency = pv[ID::reportLatency]->getInt();                              \
@@ -47,8 +47,6 @@ size_t DSPCore::getLatency() { return spcParam.reportLatency ? spcParam.frmSize
   lfoWaveform = static_cast<LfoWaveform>(pv[ID::lfoWaveform]->getInt());                 \
   lfoWaveMod.METHOD(pv[ID::lfoWaveMod]->getFloat());                                     \
   lfoRate.METHOD(pv[ID::lfoRate]->getFloat() / sampleRate);                              \
-  lfoStereoPhaseOffset.METHOD(pv[ID::lfoStereoPhaseOffset]->getFloat());                 \
-  lfoInitialPhase.METHOD(pv[ID::lfoInitialPhase]->getFloat());                           \
                                                                                          \
   feedback.METHOD(pv[ID::feedback]->getFloat());                                         \
   const auto spcShift = Sample(0.5) * pv[ID::spectralShift]->getFloat();                 \
@@ -57,7 +55,6 @@ size_t DSPCore::getLatency() { return spcParam.reportLatency ? spcParam.frmSize
   constexpr Sample twopi = Sample(2) * std::numbers::pi_v<Sample>;                       \
   maskMix.METHOD(pv[ID::maskMix]->getFloat());                                           \
   maskPhase.METHOD(pv[ID::maskPhase]->getFloat());                                       \
-  maskFreq.METHOD(pv[ID::maskFreq]->getFloat() / spcParam.frmSize);                      \
   maskChirp.METHOD(pv[ID::maskChirp]->getFloat());                                       \
   maskThreshold.METHOD(pv[ID::maskThreshold]->getFloat());                               \
   maskRotation.METHOD(pv[ID::maskRotation]->getFloat() * twopi);                         \
@@ -75,6 +72,9 @@ size_t DSPCore::getLatency() { return spcParam.reportLatency ? spcParam.frmSize
 void DSPCore::reset()
 {
   ASSIGN_PARAMETER(reset);
+  lfoStereoPhaseOffset.reset(pv[ID::lfoStereoPhaseOffset]->getFloat());
+  lfoInitialPhase.reset(pv[ID::lfoInitialPhase]->getFloat());
+  maskFreq.reset(pv[ID::maskFreq]->getFloat() / spcParam.frmSize);
 
   lfoTargetFreq = getTempoSyncFrequency();
   lfo.reset(lfoInitialPhase.getValue(), lfoTargetFreq);
@@ -85,7 +85,13 @@ void DSPCore::reset()
 
 void DSPCore::startup() {}
 
-void DSPCore::setParameters() { ASSIGN_PARAMETER(push); }
+void DSPCore::setParameters()
+{
+  ASSIGN_PARAMETER(push);
+  lfoStereoPhaseOffset.push(pv[ID::lfoStereoPhaseOffset]->getFloat(), smootherContext);
+  lfoInitialPhase.push(pv[ID::lfoInitialPhase]->getFloat(), smootherContext);
+  maskFreq.push(pv[ID::maskFreq]->getFloat() / spcParam.frmSize, smootherContext);
+}
 
 // Output range is in [0, 1].
 inline Sample phaseToWave(Sample phase, Sample mod, LfoWaveform waveform)
@@ -121,26 +127,26 @@ DSPCore::processFrame(int frameIndex, Sample in0, Sample in1, Sample side0, Samp
   auto modPhase1 = modPhase0 + lfoStereoPhaseOffset.process();
   modPhase1 -= std::floor(modPhase1);
 
-  lfoWaveMod.process();
+  lfoWaveMod.process(smootherContext);
   auto mod0 = phaseToWave(modPhase0, lfoWaveMod.getValue(), lfoWaveform);
   auto mod1 = phaseToWave(modPhase1, lfoWaveMod.getValue(), lfoWaveform);
 
-  spcParam.dryWetMix = dryWetMix.process();
-  spcParam.feedback = feedback.process();
-  spectralShift.process();
-  maskMix.process();
-  maskPhase.process();
+  spcParam.dryWetMix = dryWetMix.process(smootherContext);
+  spcParam.feedback = feedback.process(smootherContext);
+  spectralShift.process(smootherContext);
+  maskMix.process(smootherContext);
+  maskPhase.process(smootherContext);
   maskFreq.process();
-  maskChirp.process();
-  maskThreshold.process();
-  maskRotation.process();
-  lfoToSpectralShift.process();
-  lfoToMaskMix.process();
-  lfoToMaskPhase.process();
-  lfoToMaskFreq.process();
-  lfoToMaskChirp.process();
-  lfoToMaskThreshold.process();
-  lfoToMaskRotation.process();
+  maskChirp.process(smootherContext);
+  maskThreshold.process(smootherContext);
+  maskRotation.process(smootherContext);
+  lfoToSpectralShift.process(smootherContext);
+  lfoToMaskMix.process(smootherContext);
+  lfoToMaskPhase.process(smootherContext);
+  lfoToMaskFreq.process(smootherContext);
+  lfoToMaskChirp.process(smootherContext);
+  lfoToMaskThreshold.process(smootherContext);
+  lfoToMaskRotation.process(smootherContext);
 
   const auto modulateParam = [&](Sample unipoler) {
     const auto bipoler = unipoler - Sample(0.5);
@@ -173,7 +179,7 @@ DSPCore::processFrame(int frameIndex, Sample in0, Sample in1, Sample side0, Samp
   modulateParam(mod1);
   auto sig1 = spc[1].process(in1, side1, spcParam);
 
-  outputGain.process();
+  outputGain.process(smootherContext);
   return {
     outputGain.getValue() * sig0,
     outputGain.getValue() * sig1,
@@ -194,7 +200,7 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<Sample>::setBufferSize(Sample(length));
+  smootherContext.setBufferSize(Sample(length));
   lfoTargetFreq = getTempoSyncFrequency();
 
   for (int i = 0; i < length; ++i) {
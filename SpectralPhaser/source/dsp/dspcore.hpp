@@ -48,6 +48,7 @@ private:
   TransformType previousTransform = TransformType::fft;
   LfoWaveform lfoWaveform = LfoWaveform::sine;
 
+  SmootherContext<Sample> smootherContext;
   ExpSmoother<Sample> lfoWaveMod;
   ExpSmoother<Sample> lfoRate;
   RotarySmoother<Sample> lfoStereoPhaseOffset;
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "../../../common/dsp/fftwplancache.hpp"
 #include "../../../lib/fftw3/fftw3.h"
 #include "../parameter.hpp"
 #include "spectralmask.hpp"
@@ -18,10 +19,6 @@
 
 namespace SomeDSP {
 
-// `fftwMutex` is used to lock FFTW3 calls except `fftw*_execute`. In other words, FFTW3
-// isn't thread safe except `fftw*_execute` call.
-extern std::mutex fftwMutex;
-
 // Fast Walsh-Hadamard transform. In-place.
 template<typename T> void fwht(int N, T *seq, bool inverse = false)
 {
@@ -143,16 +140,20 @@ template<int maxFrameSizeLog2> struct SideChainMask {
 
   SideChainMask()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+    {
+      const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+
+      bufW = (float *)fftwf_malloc(sizeof(float) * maxFrameSize);
+      bufMask = (float *)fftwf_malloc(sizeof(float) * maxFrameSize);
+      spcMask = (std::complex<float> *)fftwf_malloc(
+        sizeof(std::complex<float>) * maxSpectrumSize);
+    }
 
-    bufW = (float *)fftwf_malloc(sizeof(float) * maxFrameSize);
-    bufMask = (float *)fftwf_malloc(sizeof(float) * maxFrameSize);
-    spcMask = (std::complex<float> *)fftwf_malloc(
-      sizeof(std::complex<float>) * maxSpectrumSize);
+    // `FftwPlanCache` locks `fftwMutex`.
     for (int idx = 0; idx < nPlan; ++idx) {
-      const auto spc_ = reinterpret_cast<fftwf_complex *>(spcMask);
       const int length = int(1) << (idx + 2);
-      forwardPlan[idx] = fftwf_plan_dft_r2c_1d(length, bufW, spc_, FFTW_ESTIMATE);
+      forwardPlan[idx] = FftwPlanCache::acquire(
+        FftwPlanShape::real(FftwPlanShape::r2c, length, bufW, spcMask));
     }
 
     reset();
@@ -160,9 +161,9 @@ template<int maxFrameSizeLog2> struct SideChainMask {
 
   ~SideChainMask()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+    for (auto &x : forwardPlan) FftwPlanCache::release(x);
 
-    for (auto &x : forwardPlan) fftwf_destroy_plan(x);
+    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
     if (spcMask) fftwf_free(spcMask);
     if (bufMask) fftwf_free(bufMask);
     if (bufW) fftwf_free(bufW);
@@ -176,7 +177,11 @@ template<int maxFrameSizeLog2> struct SideChainMask {
   }
 
   void push(float input, const int bufIndex) { bufW[bufIndex] = input; }
-  void processFft(const int planIndex) { fftwf_execute(forwardPlan[planIndex]); }
+  void processFft(const int planIndex)
+  {
+    fftwf_execute_dft_r2c(
+      forwardPlan[planIndex], bufW, reinterpret_cast<fftwf_complex *>(spcMask));
+  }
   void processFwht(const int size) { fwht(size, bufW, bufMask, false); }
   void processHaar(const int size) { haarTransformForward(size, bufW, bufMask); }
 };
@@ -206,21 +211,25 @@ public:
 
   SpectralDelay()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+    {
+      const std::lock_guard<std::mutex> fftwLock(fftwMutex);
 
-    bufW = (float *)fftwf_malloc(sizeof(float) * maxFrameSize);
-    bufR = (float *)fftwf_malloc(sizeof(float) * maxFrameSize);
-    bufTmp = (float *)fftwf_malloc(sizeof(float) * maxFrameSize);
+      bufW = (float *)fftwf_malloc(sizeof(float) * maxFrameSize);
+      bufR = (float *)fftwf_malloc(sizeof(float) * maxFrameSize);
+      bufTmp = (float *)fftwf_malloc(sizeof(float) * maxFrameSize);
 
-    constexpr int spcAllocSize = sizeof(std::complex<float>) * maxSpectrumSize;
-    spcSrc = (std::complex<float> *)fftwf_malloc(spcAllocSize);
-    spcTmp = (std::complex<float> *)fftwf_malloc(spcAllocSize);
+      constexpr int spcAllocSize = sizeof(std::complex<float>) * maxSpectrumSize;
+      spcSrc = (std::complex<float> *)fftwf_malloc(spcAllocSize);
+      spcTmp = (std::complex<float> *)fftwf_malloc(spcAllocSize);
+    }
 
+    // `FftwPlanCache` locks `fftwMutex`.
     for (int idx = 0; idx < nPlan; ++idx) {
-      const auto spc_ = reinterpret_cast<fftwf_complex *>(spcSrc);
       const int length = int(1) << (idx + 2);
-      forwardPlan[idx] = fftwf_plan_dft_r2c_1d(length, bufW, spc_, FFTW_ESTIMATE);
-      inversePlan[idx] = fftwf_plan_dft_c2r_1d(length, spc_, bufR, FFTW_ESTIMATE);
+      forwardPlan[idx] = FftwPlanCache::acquire(
+        FftwPlanShape::real(FftwPlanShape::r2c, length, bufW, spcSrc));
+      inversePlan[idx] = FftwPlanCache::acquire(
+        FftwPlanShape::real(FftwPlanShape::c2r, length, spcSrc, bufR));
     }
 
     reset();
@@ -228,10 +237,10 @@ public:
 
   ~SpectralDelay()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+    for (auto &x : inversePlan) FftwPlanCache::release(x);
+    for (auto &x : forwardPlan) FftwPlanCache::release(x);
 
-    for (auto &x : inversePlan) fftwf_destroy_plan(x);
-    for (auto &x : forwardPlan) fftwf_destroy_plan(x);
+    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
 
     if (spcTmp) fftwf_free(spcTmp);
     if (spcSrc) fftwf_free(spcSrc);
@@ -262,7 +271,8 @@ public:
     bufIndex = 0;
 
     const auto planIndex = prm.frameSizeLog2 - planIndexOffset;
-    fftwf_execute(forwardPlan[planIndex]);
+    fftwf_execute_dft_r2c(
+      forwardPlan[planIndex], bufW, reinterpret_cast<fftwf_complex *>(spcSrc));
 
     const auto spectrumSize = prm.frmSize / 2 + 1;
 
@@ -287,7 +297,8 @@ public:
         = spcTmp[idx] * std::polar(std::abs(maskValue), prm.maskRotation * mask[idx]);
     }
 
-    fftwf_execute(inversePlan[planIndex]);
+    fftwf_execute_dft_c2r(
+      inversePlan[planIndex], reinterpret_cast<fftwf_complex *>(spcSrc), bufR);
     return output;
   }
 
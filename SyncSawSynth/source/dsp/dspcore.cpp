@@ -5,6 +5,8 @@
 
 #include "dspcore.hpp"
 
+#include <numeric>
+
 inline float clamp(float value, float min, float max)
 {
   return (value < min) ? min : (value > max) ? max : value;
@@ -33,7 +35,8 @@ void Note<Sample>::setup(
   Sample normalizedKey,
   Sample frequency,
   Sample velocity,
-  Steinberg::Synth::GlobalParameter &param)
+  Steinberg::Synth::GlobalParameter &param,
+  const SmootherContext<Sample> &context)
 {
   state = NoteState::active;
   id = noteId;
@@ -95,7 +98,7 @@ void Note<Sample>::setup(
     param.value[ParameterID::gainA]->getFloat(),
     param.value[ParameterID::gainD]->getFloat(),
     param.value[ParameterID::gainS]->getFloat(),
-    param.value[ParameterID::gainR]->getFloat());
+    param.value[ParameterID::gainR]->getFloat(), context);
   filterEnvelope.reset(
     param.value[ParameterID::filterA]->getFloat(),
     param.value[ParameterID::filterD]->getFloat(),
@@ -256,16 +259,20 @@ template<typename Sample> Sample Note<Sample>::process(NoteProcessInfo<Sample> &
   return gain * filter.process(info.osc1Gain * outSaw1 + info.osc2Gain * outSaw2);
 }
 
-DSPCore::DSPCore() { midiNotes.reserve(128); }
+DSPCore::DSPCore()
+{
+  midiNotes.reserve(128);
+  std::iota(noteSlots.begin(), noteSlots.end(), 0);
+}
 
 void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  midiNotes.resize(0);
+  midiNotes.clear();
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
 
   for (auto &note : notes) {
     for (auto &nt : note) nt = std::make_unique<Note<float>>(this->sampleRate);
@@ -393,7 +400,8 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
+  const auto &sc = smootherContext;
 
   bool unison = param.value[ParameterID::unison]->getFloat();
   for (auto &note : notes) {
@@ -402,14 +410,14 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
       param.value[ParameterID::gainA]->getFloat(),
       param.value[ParameterID::gainD]->getFloat(),
       param.value[ParameterID::gainS]->getFloat(),
-      param.value[ParameterID::gainR]->getFloat());
+      param.value[ParameterID::gainR]->getFloat(), sc);
     if (unison) {
       if (note[1]->state == NoteState::rest) continue;
       note[1]->gainEnvelope.set(
         param.value[ParameterID::gainA]->getFloat(),
         param.value[ParameterID::gainD]->getFloat(),
         param.value[ParameterID::gainS]->getFloat(),
-        param.value[ParameterID::gainR]->getFloat());
+        param.value[ParameterID::gainR]->getFloat(), sc);
     }
   }
 
@@ -417,66 +425,90 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
   noteInfo.osc1PTROrder = param.value[ParameterID::osc1PTROrder]->getInt();
   noteInfo.osc2SyncType = param.value[ParameterID::osc2SyncType]->getInt();
   noteInfo.osc2PTROrder = param.value[ParameterID::osc2PTROrder]->getInt();
-  for (size_t i = 0; i < length; ++i) {
-    processMidiNote(i);
-
-    noteInfo.osc1Gain = interpOsc1Gain.process();
-    noteInfo.osc1Pitch = interpOsc1Pitch.process();
-    noteInfo.osc1Sync = interpOsc1Sync.process();
-    noteInfo.osc2Gain = interpOsc2Gain.process();
-    noteInfo.osc2Pitch = interpOsc2Pitch.process();
-    noteInfo.osc2Sync = interpOsc2Sync.process();
-    noteInfo.fmOsc1ToSync1 = interpFMOsc1ToSync1.process();
-    noteInfo.fmOsc1ToFreq2 = interpFMOsc1ToFreq2.process();
-    noteInfo.fmOsc2ToSync1 = interpFMOsc2ToSync1.process();
-    noteInfo.modEnvelopeToFreq1 = interpModEnvelopeToFreq1.process();
-    noteInfo.modEnvelopeToSync1 = interpModEnvelopeToSync1.process();
-    noteInfo.modEnvelopeToFreq2 = interpModEnvelopeToFreq2.process();
-    noteInfo.modEnvelopeToSync2 = interpModEnvelopeToSync2.process();
-
-    lfoPhase += 2.0f * float(pi) * interpModLFOFrequency.process() / sampleRate;
-    if (lfoPhase >= float(pi)) lfoPhase -= float(pi);
-    lfoValue = sinf(lfoPhase);
-    // lfoValue = (lfoValue + 1.0f) * 0.5f;
-    const float noiseSig = clamp(noise.process(), -1.0f, 1.0f) / 16.0f;
-    noteInfo.modLFO = clamp(
-      lfoValue + interpModLFONoiseMix.process() * (noiseSig - lfoValue), -1.0f, 1.0f);
-
-    noteInfo.modLFOToFreq1 = interpModLFOToFreq1.process();
-    noteInfo.modLFOToSync1 = interpModLFOToSync1.process();
-    noteInfo.modLFOToFreq2 = interpModLFOToFreq2.process();
-    noteInfo.modLFOToSync2 = interpModLFOToSync2.process();
-    noteInfo.gainEnvelopeCurve = interpGainEnvelopeCurve.process();
-    noteInfo.filterCutoff = interpFilterCutoff.process();
-    noteInfo.filterResonance = interpFilterResonance.process();
-    noteInfo.filterFeedback = interpFilterFeedback.process();
-    noteInfo.filterSaturation = interpFilterSaturation.process();
-    noteInfo.filterCutoffAmount = interpFilterCutoffAmount.process();
-    noteInfo.filterResonanceAmount = interpFilterResonanceAmount.process();
-    noteInfo.filterKeyToCutoff = interpFilterKeyToCutoff.process();
-    noteInfo.filterKeyToFeedback = interpFilterKeyToFeedback.process();
-
-    float sample = 0.0f;
-    for (auto &note : notes) {
-      if (note[0]->state == NoteState::rest) continue;
-      sample += note[0]->process(noteInfo);
-      if (unison) {
-        if (note[1]->state == NoteState::rest) continue;
-        sample += note[1]->process(noteInfo);
-      }
+
+  auto onNote = [&](MidiNote &nt) {
+    if (nt.isNoteOn)
+      noteOn(nt.id, nt.pitch, nt.tuning, nt.velocity);
+    else
+      noteOff(nt.id);
+  };
+
+  auto prepare = [&](size_t, size_t frames) {
+    for (size_t k = 0; k < frames; ++k) {
+      noteInfo.osc1Gain = interpOsc1Gain.process(sc);
+      noteInfo.osc1Pitch = interpOsc1Pitch.process(sc);
+      noteInfo.osc1Sync = interpOsc1Sync.process(sc);
+      noteInfo.osc2Gain = interpOsc2Gain.process(sc);
+      noteInfo.osc2Pitch = interpOsc2Pitch.process(sc);
+      noteInfo.osc2Sync = interpOsc2Sync.process(sc);
+      noteInfo.fmOsc1ToSync1 = interpFMOsc1ToSync1.process(sc);
+      noteInfo.fmOsc1ToFreq2 = interpFMOsc1ToFreq2.process(sc);
+      noteInfo.fmOsc2ToSync1 = interpFMOsc2ToSync1.process(sc);
+      noteInfo.modEnvelopeToFreq1 = interpModEnvelopeToFreq1.process(sc);
+      noteInfo.modEnvelopeToSync1 = interpModEnvelopeToSync1.process(sc);
+      noteInfo.modEnvelopeToFreq2 = interpModEnvelopeToFreq2.process(sc);
+      noteInfo.modEnvelopeToSync2 = interpModEnvelopeToSync2.process(sc);
+
+      lfoPhase += 2.0f * float(pi) * interpModLFOFrequency.process(sc) / sampleRate;
+      if (lfoPhase >= float(pi)) lfoPhase -= float(pi);
+      lfoValue = sinf(lfoPhase);
+      // lfoValue = (lfoValue + 1.0f) * 0.5f;
+      const float noiseSig = clamp(noise.process(), -1.0f, 1.0f) / 16.0f;
+      noteInfo.modLFO = clamp(
+        lfoValue + interpModLFONoiseMix.process(sc) * (noiseSig - lfoValue), -1.0f, 1.0f);
+
+      noteInfo.modLFOToFreq1 = interpModLFOToFreq1.process(sc);
+      noteInfo.modLFOToSync1 = interpModLFOToSync1.process(sc);
+      noteInfo.modLFOToFreq2 = interpModLFOToFreq2.process(sc);
+      noteInfo.modLFOToSync2 = interpModLFOToSync2.process(sc);
+      noteInfo.gainEnvelopeCurve = interpGainEnvelopeCurve.process(sc);
+      noteInfo.filterCutoff = interpFilterCutoff.process(sc);
+      noteInfo.filterResonance = interpFilterResonance.process(sc);
+      noteInfo.filterFeedback = interpFilterFeedback.process(sc);
+      noteInfo.filterSaturation = interpFilterSaturation.process(sc);
+      noteInfo.filterCutoffAmount = interpFilterCutoffAmount.process(sc);
+      noteInfo.filterResonanceAmount = interpFilterResonanceAmount.process(sc);
+      noteInfo.filterKeyToCutoff = interpFilterKeyToCutoff.process(sc);
+      noteInfo.filterKeyToFeedback = interpFilterKeyToFeedback.process(sc);
+
+      processInfo[k] = noteInfo;
+    }
+  };
+
+  // `notes[i][1]` is skipped on the frames where `notes[i][0]` is resting, and unison
+  // notes are summed separately. It keeps the order of additions in sample-major loop.
+  size_t pairFrames = 0;
+  auto renderVoice = [&](size_t slot, size_t frames, auto &buffer) {
+    auto &note = *notes[slot / 2][slot % 2];
+    if (slot % 2 != 0) frames = unison ? pairFrames : 0;
+
+    size_t k = 0;
+    for (; k < frames && note.state != NoteState::rest; ++k) {
+      buffer[0][k] = note.process(processInfo[k]);
     }
+    if (slot % 2 == 0) pairFrames = k;
+    return k;
+  };
+
+  auto onBlock = [&](size_t offset, size_t frames, const auto &mix) {
+    for (size_t j = 0; j < frames; ++j) {
+      float sample = mix[0][j];
+
+      if (isTransitioning) {
+        sample += transitionBuffer[trIndex];
+        transitionBuffer[trIndex] = 0.0f;
+        trIndex = (trIndex + 1) % transitionBuffer.size();
+        if (trIndex == trStop) isTransitioning = false;
+      }
 
-    if (isTransitioning) {
-      sample += transitionBuffer[trIndex];
-      transitionBuffer[trIndex] = 0.0f;
-      trIndex = (trIndex + 1) % transitionBuffer.size();
-      if (trIndex == trStop) isTransitioning = false;
+      const float masterGain = interpMasterGain.process(sc);
+      out0[offset + j] = masterGain * sample;
+      out1[offset + j] = masterGain * sample;
     }
+  };
 
-    const float masterGain = interpMasterGain.process();
-    out0[i] = masterGain * sample;
-    out1[i] = masterGain * sample;
-  }
+  voiceRenderer.process(
+    length, midiNotes, noteSlots, onNote, prepare, renderVoice, onBlock);
 }
 
 void DSPCore::noteOn(int32_t noteId, int16_t pitch, float tuning, float velocity)
@@ -554,9 +586,10 @@ void DSPCore::noteOn(int32_t noteId, int16_t pitch, float tuning, float velocity
 
   auto normalizedKey = float(pitch) / 127.0f;
   auto frequency = midiNoteToFrequency(pitch, tuning);
-  notes[i][0]->setup(noteId, normalizedKey, frequency, velocity, param);
+  const auto &sc = smootherContext;
+  notes[i][0]->setup(noteId, normalizedKey, frequency, velocity, param, sc);
   if (param.value[ParameterID::unison]->getFloat()) {
-    notes[i][1]->setup(noteId, normalizedKey, frequency, velocity, param);
+    notes[i][1]->setup(noteId, normalizedKey, frequency, velocity, param, sc);
     notes[i][1]->saw1.addPhase(0.1777f);
     notes[i][1]->saw2.addPhase(0.6883f);
   } else {
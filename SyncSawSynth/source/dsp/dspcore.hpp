@@ -4,7 +4,9 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/notequeue.hpp"
 #include "../../../common/dsp/smoother.hpp"
+#include "../../../common/dsp/voicerenderer.hpp"
 #include "../parameter.hpp"
 #include "envelope.hpp"
 #include "iir.hpp"
@@ -96,7 +98,8 @@ public:
     Sample normalizedKey,
     Sample frequency,
     Sample velocity,
-    GlobalParameter &param);
+    GlobalParameter &param,
+    const SmootherContext<Sample> &context);
   void release();
   void rest();
   void reset();
@@ -128,7 +131,7 @@ public:
     float velocity;
   };
 
-  std::vector<MidiNote> midiNotes;
+  NoteQueue<MidiNote> midiNotes;
 
   void pushMidiNote(
     bool isNoteOn,
@@ -145,22 +148,17 @@ public:
     note.pitch = pitch;
     note.tuning = tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(it->id, it->pitch, it->tuning, it->velocity);
+    midiNotes.dispatch(frame, [&](MidiNote &nt) {
+      if (nt.isNoteOn)
+        noteOn(nt.id, nt.pitch, nt.tuning, nt.velocity);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
-    }
+        noteOff(nt.id);
+    });
   }
 
 private:
@@ -172,6 +170,13 @@ private:
 
   NoteProcessInfo<float> noteInfo;
 
+  // `noteInfo` of each frame in a sub-block. Slot `2 * i + j` is `notes[i][j]`.
+  static constexpr size_t voiceBlockSize = 64;
+  std::array<NoteProcessInfo<float>, voiceBlockSize> processInfo{};
+  std::array<size_t, 2 * maxVoice> noteSlots{};
+  VoiceRenderer<float, 1, voiceBlockSize> voiceRenderer;
+
+  SmootherContext<float> smootherContext;
   ExpSmoother<float> interpMasterGain;
   ExpSmoother<float> interpOsc1Gain;
   ExpSmoother<float> interpOsc1Pitch;
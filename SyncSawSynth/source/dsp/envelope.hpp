@@ -32,7 +32,10 @@ public:
     Sample threshold = Sample(1e-5))
     : sampleRate(sampleRate)
   {
-    reset(attackTime, decayTime, sustainLevel, releaseTime, declickTime, threshold);
+    // Default context has no smoothing time, so sustain starts on `sustainLevel`.
+    reset(
+      attackTime, decayTime, sustainLevel, releaseTime, SmootherContext<Sample>{},
+      declickTime, threshold);
   }
 
   void reset(
@@ -40,13 +43,15 @@ public:
     Sample decayTime,
     Sample sustainLevel,
     Sample releaseTime,
+    const SmootherContext<Sample> &context,
     Sample declickTime = Sample(0.001),
     Sample threshold = Sample(1e-5))
   {
     state = State::attack;
     value = threshold;
     sustain.reset(sustainLevel);
-    set(attackTime, decayTime, sustainLevel, releaseTime, declickTime, threshold);
+    set(
+      attackTime, decayTime, sustainLevel, releaseTime, context, declickTime, threshold);
   }
 
   // This method is slow.
@@ -55,6 +60,7 @@ public:
     Sample decayTime,
     Sample sustainLevel,
     Sample releaseTime,
+    const SmootherContext<Sample> &context,
     Sample declickTime = Sample(0.001),
     Sample threshold = Sample(1e-5))
   {
@@ -67,7 +73,7 @@ public:
     this->decayTime = (decayTime < sampleLength) ? sampleLength : decayTime;
 
     sustainLevel = std::max<Sample>(0.0, std::min<Sample>(sustainLevel, Sample(1.0)));
-    sustain.push(sustainLevel);
+    sustain.push(sustainLevel, context);
 
     declickLength = int32_t(declickTime * sampleRate);
 
@@ -120,7 +120,8 @@ bool Note::isAttacking() { return gainEnvelope.isAttacking(); }
 
 float Note::getGain() { return velocity * gainEnvelope.value(); }
 
-std::array<float, 2> Note::process(float sampleRate, NoteProcessInfo &info)
+std::array<float, 2> Note::process(
+  float sampleRate, NoteProcessInfo &info, const SmootherContext<float> &context)
 {
   if (state == NoteState::rest) return {0.0f, 0.0f};
 
@@ -136,7 +137,7 @@ std::array<float, 2> Note::process(float sampleRate, NoteProcessInfo &info)
     modulation[ModID::env0 + i0]
       = envelope[i0].process(info.envelopeSustainAmplitude[i0].getValue());
     modulation[ModID::lfo0 + i0] = lfo[i0].process(
-      lfoPitch[i0].process() * info.lfoPhaseDelta[i0].getValue(),
+      lfoPitch[i0].process(context) * info.lfoPhaseDelta[i0].getValue(),
       info.lfoLowpassKp[i0].getValue(), info.lfoWavetable[i0].value);
     modulation[ModID::ext0 + i0] = info.externalInput[i0].getValue();
   }
@@ -243,7 +244,7 @@ void DSPCore::processSample(std::array<float, 2> &frame)
 
   for (auto &note : notes) {
     if (note.state == NoteState::rest) continue;
-    auto sig = note.process(upRate, info);
+    auto sig = note.process(upRate, info, smootherContext);
     frame[0] += sig[0];
     frame[1] += sig[1];
   }
@@ -256,13 +257,13 @@ void DSPCore::processSample(std::array<float, 2> &frame)
     if (trIndex == trStop) isTransitioning = false;
   }
 
-  const auto dcHighpassKp = dcHighpassCutoffKp.process();
+  const auto dcHighpassKp = dcHighpassCutoffKp.process(smootherContext);
   if (dcHighpassEnable) {
     frame[0] = dcHighpass[0].process(frame[0], dcHighpassKp);
     frame[1] = dcHighpass[1].process(frame[1], dcHighpassKp);
   }
 
-  const auto masterGain = interpMasterGain.process();
+  const auto masterGain = interpMasterGain.process(smootherContext);
   frame[0] *= masterGain;
   frame[1] *= masterGain;
 }
@@ -272,7 +273,7 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
   using ID = ParameterID::ID;
   auto &pv = param.value;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   size_t oversampling = pv[ID::oversampling]->getInt();
 
@@ -280,7 +281,7 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
   for (uint_fast32_t i = 0; i < length; ++i) {
     processMidiNote(i);
 
-    info.process();
+    info.process(smootherContext);
 
     if (oversampling == 2) { // 16x.
       for (size_t j = 0; j < downSampler[0].fold; ++j) {
@@ -366,7 +367,7 @@ inline void DSPCore::fillTransitionBuffer(size_t noteIndex)
   if (trStop >= transitionBuffer.size()) trStop += transitionBuffer.size();
 
   for (size_t bufIdx = 0; bufIdx < transitionBuffer.size(); ++bufIdx) {
-    auto oscOut = note.process(upRate, info);
+    auto oscOut = note.process(upRate, info, smootherContext);
     auto idx = (trIndex + bufIdx) % transitionBuffer.size();
     auto interp = 1.0f - float(bufIdx) / transitionBuffer.size();
 
@@ -386,8 +387,8 @@ inline void DSPCore::updateSampleRate(bool reset)
   auto oversampling = std::min<size_t>(pv[ID::oversampling]->getInt(), fold.size() - 1);
   upRate = float(fold[oversampling] * sampleRate);
 
-  SmootherCommon<float>::setSampleRate(upRate);
-  SmootherCommon<float>::setTime(pv[ID::parameterSmoothingSecond]->getFloat());
+  smootherContext.setSampleRate(upRate);
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getFloat());
 
   if (!reset && previousRate == upRate) return;
 
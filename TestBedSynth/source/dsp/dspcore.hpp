@@ -5,6 +5,7 @@
 
 #include "../../../common/dsp/constants.hpp"
 #include "../../../common/dsp/multirate.hpp"
+#include "../../../common/dsp/notequeue.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "lfo.hpp"
@@ -164,34 +165,34 @@ struct NoteProcessInfo {
     NOTE_PROCESS_INFO_SMOOTHER(push);
   }
 
-  void process()
+  void process(const SmootherContext<float> &context)
   {
     for (auto &x : tableParam) {
-      x.oscPitch.process();
-      x.sumMix.process();
-      x.feedbackLowpassKp.process();
-      x.sumToImmediatePm.process();
-      x.sumToAccumulatePm.process();
-      x.sumToFm.process();
-      x.sumToAm.process();
-
-      x.pitch.process();
-      x.immedaitePm.process();
-      x.accumulatePm.process();
-      x.fm.process();
+      x.oscPitch.process(context);
+      x.sumMix.process(context);
+      x.feedbackLowpassKp.process(context);
+      x.sumToImmediatePm.process(context);
+      x.sumToAccumulatePm.process(context);
+      x.sumToFm.process(context);
+      x.sumToAm.process(context);
+
+      x.pitch.process(context);
+      x.immedaitePm.process(context);
+      x.accumulatePm.process(context);
+      x.fm.process(context);
     }
 
-    for (auto &x : envelopeSustainAmplitude) x.process();
-    for (auto &x : lfoPhaseDelta) x.process();
-    for (auto &x : lfoLowpassKp) x.process();
-    for (auto &x : externalInput) x.process();
-    for (auto &x : lfoWavetable) x.process();
-    for (auto &x : oscWavetable) x.process();
-    for (auto &x : oscWaveModGain) x.process();
-
-    gainSustainAmplitude.process();
-    oscMix.process();
-    mainPitch.process();
+    for (auto &x : envelopeSustainAmplitude) x.process(context);
+    for (auto &x : lfoPhaseDelta) x.process(context);
+    for (auto &x : lfoLowpassKp) x.process(context);
+    for (auto &x : externalInput) x.process(context);
+    for (auto &x : lfoWavetable) x.process(context);
+    for (auto &x : oscWavetable) x.process(context);
+    for (auto &x : oscWaveModGain) x.process(context);
+
+    gainSustainAmplitude.process(context);
+    oscMix.process(context);
+    mainPitch.process(context);
   }
 };
 
@@ -233,7 +234,8 @@ public:
   void rest();
   bool isAttacking();
   float getGain();
-  std::array<float, 2> process(float sampleRate, NoteProcessInfo &info);
+  std::array<float, 2> process(
+    float sampleRate, NoteProcessInfo &info, const SmootherContext<float> &context);
 };
 
 class DSPCore {
@@ -262,7 +264,7 @@ public:
   void noteOn(int_fast32_t noteId, int_fast16_t pitch, float tuning, float velocity);
   void noteOff(int_fast32_t noteId);
 
-  std::vector<MidiNote> midiNotes;
+  NoteQueue<MidiNote> midiNotes;
 
   void pushMidiNote(
     bool isNoteOn,
@@ -279,22 +281,17 @@ public:
     note.pitch = pitch;
     note.tuning = tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(it->id, it->pitch, it->tuning, it->velocity);
+    midiNotes.dispatch(frame, [&](MidiNote &nt) {
+      if (nt.isNoteOn)
+        noteOn(nt.id, nt.pitch, nt.tuning, nt.velocity);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
-    }
+        noteOff(nt.id);
+    });
   }
 
 private:
@@ -317,6 +314,7 @@ private:
   std::vector<float> unisonPan;
   std::array<Note, maxVoice> notes;
 
+  SmootherContext<float> smootherContext;
   NoteProcessInfo info;
   bool dcHighpassEnable = false;
   ExpSmoother<float> interpMasterGain;
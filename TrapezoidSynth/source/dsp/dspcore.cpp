@@ -22,60 +22,68 @@ inline float paramToPitch(float semi, float cent, float bend)
 }
 
 #define ASSIGN_NOTE_PARAMETER(METHOD)                                                    \
-  interpOctave.METHOD(getOctave(param));                                                 \
+  METHOD(interpOctave, getOctave(param));                                                \
   interpOsc1Pitch.setTime(param.value[ParameterID::pitchSlide]->getFloat());             \
-  interpOsc1Pitch.METHOD(getOsc1Pitch(param));                                           \
+  METHOD(interpOsc1Pitch, getOsc1Pitch(param));                                          \
   interpOsc2Pitch.setTime(                                                               \
     param.value[ParameterID::pitchSlide]->getFloat()                                     \
     * param.value[ParameterID::pitchSlideOffset]->getFloat());                           \
-  interpOsc2Pitch.METHOD(getOsc2Pitch(param));                                           \
+  METHOD(interpOsc2Pitch, getOsc2Pitch(param));                                          \
                                                                                          \
-  interpOsc1Slope.METHOD(param.value[ParameterID::osc1Slope]->getFloat());               \
-  interpOsc1PulseWidth.METHOD(param.value[ParameterID::osc1PulseWidth]->getFloat());     \
-  interpOsc2Slope.METHOD(param.value[ParameterID::osc2Slope]->getFloat());               \
-  interpOsc2PulseWidth.METHOD(param.value[ParameterID::osc2PulseWidth]->getFloat());     \
-  interpOscMix.METHOD(param.value[ParameterID::oscMix]->getFloat());                     \
-  interpPitchDrift.METHOD(param.value[ParameterID::osc1PitchDrift]->getFloat());         \
-  interpPhaseMod.METHOD(param.value[ParameterID::pmOsc2ToOsc1]->getFloat());             \
-  interpFeedback.METHOD(param.value[ParameterID::osc1Feedback]->getFloat());             \
-  interpFilterCutoff.METHOD(param.value[ParameterID::filterCutoff]->getFloat());         \
-  interpFilterFeedback.METHOD(param.value[ParameterID::filterFeedback]->getFloat());     \
-  interpFilterSaturation.METHOD(param.value[ParameterID::filterSaturation]->getFloat()); \
-  interpFilterEnvToCutoff.METHOD(                                                        \
-    param.value[ParameterID::filterEnvToCutoff]->getFloat());                            \
-  interpFilterKeyToCutoff.METHOD(                                                        \
-    param.value[ParameterID::filterKeyToCutoff]->getFloat());                            \
-  interpOscMixToFilterCutoff.METHOD(                                                     \
+  METHOD(interpOsc1Slope, param.value[ParameterID::osc1Slope]->getFloat());              \
+  METHOD(interpOsc1PulseWidth, param.value[ParameterID::osc1PulseWidth]->getFloat());    \
+  METHOD(interpOsc2Slope, param.value[ParameterID::osc2Slope]->getFloat());              \
+  METHOD(interpOsc2PulseWidth, param.value[ParameterID::osc2PulseWidth]->getFloat());    \
+  METHOD(interpOscMix, param.value[ParameterID::oscMix]->getFloat());                    \
+  METHOD(interpPitchDrift, param.value[ParameterID::osc1PitchDrift]->getFloat());        \
+  METHOD(interpPhaseMod, param.value[ParameterID::pmOsc2ToOsc1]->getFloat());            \
+  METHOD(interpFeedback, param.value[ParameterID::osc1Feedback]->getFloat());            \
+  METHOD(interpFilterCutoff, param.value[ParameterID::filterCutoff]->getFloat());        \
+  METHOD(interpFilterFeedback, param.value[ParameterID::filterFeedback]->getFloat());    \
+  METHOD(                                                                                \
+    interpFilterSaturation, param.value[ParameterID::filterSaturation]->getFloat());     \
+  METHOD(                                                                                \
+    interpFilterEnvToCutoff, param.value[ParameterID::filterEnvToCutoff]->getFloat());   \
+  METHOD(                                                                                \
+    interpFilterKeyToCutoff, param.value[ParameterID::filterKeyToCutoff]->getFloat());   \
+  METHOD(                                                                                \
+    interpOscMixToFilterCutoff,                                                          \
     param.value[ParameterID::oscMixToFilterCutoff]->getFloat());                         \
-  interpMod1EnvToPhaseMod.METHOD(                                                        \
-    param.value[ParameterID::modEnv1ToPhaseMod]->getFloat());                            \
-  interpMod2EnvToFeedback.METHOD(                                                        \
-    param.value[ParameterID::modEnv2ToFeedback]->getFloat());                            \
-  interpMod2EnvToLFOFrequency.METHOD(                                                    \
+  METHOD(                                                                                \
+    interpMod1EnvToPhaseMod, param.value[ParameterID::modEnv1ToPhaseMod]->getFloat());   \
+  METHOD(                                                                                \
+    interpMod2EnvToFeedback, param.value[ParameterID::modEnv2ToFeedback]->getFloat());   \
+  METHOD(                                                                                \
+    interpMod2EnvToLFOFrequency,                                                         \
     param.value[ParameterID::modEnv2ToLFOFrequency]->getFloat());                        \
-  interpModEnv2ToOsc2Slope.METHOD(                                                       \
-    param.value[ParameterID::modEnv2ToOsc2Slope]->getFloat());                           \
-  interpMod2EnvToShifter1.METHOD(                                                        \
-    param.value[ParameterID::modEnv2ToShifter1]->getFloat());                            \
-  interpLFOShape.METHOD(param.value[ParameterID::lfoShape]->getFloat());                 \
-  interpLFOToPitch.METHOD(param.value[ParameterID::lfoToPitch]->getFloat());             \
-  interpLFOToSlope.METHOD(param.value[ParameterID::lfoToSlope]->getFloat());             \
-  interpLFOToPulseWidth.METHOD(param.value[ParameterID::lfoToPulseWidth]->getFloat());   \
-  interpLFOToCutoff.METHOD(param.value[ParameterID::lfoToCutoff]->getFloat());           \
+  METHOD(                                                                                \
+    interpModEnv2ToOsc2Slope, param.value[ParameterID::modEnv2ToOsc2Slope]->getFloat()); \
+  METHOD(                                                                                \
+    interpMod2EnvToShifter1, param.value[ParameterID::modEnv2ToShifter1]->getFloat());   \
+  METHOD(interpLFOShape, param.value[ParameterID::lfoShape]->getFloat());                \
+  METHOD(interpLFOToPitch, param.value[ParameterID::lfoToPitch]->getFloat());            \
+  METHOD(interpLFOToSlope, param.value[ParameterID::lfoToSlope]->getFloat());            \
+  METHOD(interpLFOToPulseWidth, param.value[ParameterID::lfoToPulseWidth]->getFloat());  \
+  METHOD(interpLFOToCutoff, param.value[ParameterID::lfoToCutoff]->getFloat());          \
                                                                                          \
   /* shiftHz = freq * shifterPitch - freq. */                                            \
-  interpShifter1Pitch.METHOD(                                                            \
+  METHOD(                                                                                \
+    interpShifter1Pitch,                                                                 \
     paramToPitch(                                                                        \
       param.value[ParameterID::shifter1Semi]->getFloat(),                                \
       param.value[ParameterID::shifter1Cent]->getFloat(), 0.5f)                          \
-    - Sample(1));                                                                        \
-  interpShifter1Gain.METHOD(param.value[ParameterID::shifter1Gain]->getFloat());         \
-  interpShifter2Pitch.METHOD(                                                            \
+      - Sample(1));                                                                      \
+  METHOD(interpShifter1Gain, param.value[ParameterID::shifter1Gain]->getFloat());        \
+  METHOD(                                                                                \
+    interpShifter2Pitch,                                                                 \
     paramToPitch(                                                                        \
       param.value[ParameterID::shifter2Semi]->getFloat(),                                \
       param.value[ParameterID::shifter2Cent]->getFloat(), 0.5f)                          \
-    - Sample(1));                                                                        \
-  interpShifter2Gain.METHOD(param.value[ParameterID::shifter2Gain]->getFloat());
+      - Sample(1));                                                                      \
+  METHOD(interpShifter2Gain, param.value[ParameterID::shifter2Gain]->getFloat());
+
+#define RESET_NOTE_PARAMETER(SMOOTHER, VALUE) SMOOTHER.reset(VALUE)
+#define PUSH_NOTE_PARAMETER(SMOOTHER, VALUE) SMOOTHER.push(VALUE, context)
 
 template<typename Sample> void TpzMono<Sample>::setup(Sample sampleRate)
 {
@@ -107,7 +115,7 @@ template<typename Sample> void TpzMono<Sample>::reset(GlobalParameter &param)
   noteFreq = 0;
   normalizedKey = 0;
 
-  ASSIGN_NOTE_PARAMETER(reset);
+  ASSIGN_NOTE_PARAMETER(RESET_NOTE_PARAMETER);
 
   interpLFOFrequency.reset(1.0f);
 
@@ -125,15 +133,16 @@ template<typename Sample> void TpzMono<Sample>::startup()
 }
 
 template<typename Sample>
-void TpzMono<Sample>::setParameters(Sample tempo, GlobalParameter &param)
+void TpzMono<Sample>::setParameters(
+  Sample tempo, GlobalParameter &param, const SmootherContext<Sample> &context)
 {
-  ASSIGN_NOTE_PARAMETER(push);
+  ASSIGN_NOTE_PARAMETER(PUSH_NOTE_PARAMETER);
 
   float lfoFreq = param.value[ParameterID::lfoFrequency]->getFloat();
   if (param.value[ParameterID::lfoTempoSync]->getInt()) {
     lfoFreq = lfoFreq * tempo / 240.0f;
   }
-  interpLFOFrequency.push(lfoFreq);
+  interpLFOFrequency.push(lfoFreq, context);
 
   filter.setOrder(param.value[ParameterID::filterOrder]->getInt());
 
@@ -340,10 +349,10 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  midiNotes.resize(0);
+  midiNotes.clear();
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.01f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.01f);
 
   noteStack.reserve(128);
   noteStack.resize(0);
@@ -367,18 +376,19 @@ void DSPCore::startup() { tpz1.startup(); }
 
 void DSPCore::setParameters(double tempo)
 {
-  SmootherCommon<float>::setTime(param.value[ParameterID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ParameterID::smoothness]->getFloat());
 
-  interpMasterGain.push(velocity * param.value[ParameterID::gain]->getFloat());
+  interpMasterGain.push(
+    velocity * param.value[ParameterID::gain]->getFloat(), smootherContext);
 
-  tpz1.setParameters(float(tempo), param);
+  tpz1.setParameters(float(tempo), param, smootherContext);
 }
 
 void DSPCore::process(const size_t length, float *out0, float *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   float sample = 1.0;
   for (uint32_t i = 0; i < length; ++i) {
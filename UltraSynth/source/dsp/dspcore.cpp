@@ -35,8 +35,8 @@ void DSPCore::setup(double sampleRate)
 
   baseRateKp = EMAFilter<double>::secondToP(sampleRate, smoothingTimeSecond);
 
-  SmootherCommon<double>::setSampleRate(upRate);
-  SmootherCommon<double>::setTime(smoothingTimeSecond);
+  smootherContext.setSampleRate(upRate);
+  smootherContext.setTime(smoothingTimeSecond);
 
   reset();
   startup();
@@ -147,8 +147,8 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setBufferSize(double(length));
+  smootherContext.setSampleRate(upRate);
 
   // When tempo-sync is off, use defaultTempo BPM.
   bool isTempoSyncing = pv[ID::lfoTempoSync]->getInt();
@@ -188,28 +188,28 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
 
         auto pitch
           = (double(1) + lfoToPitch * lfoB) * interpPitch.process(pitchSmoothingKp);
-        auto freq = interpFrequencyHz.process();
-        auto osc1Freq = freq * pitch * interpOsc1FrequencyOffsetPitch.process();
-        auto osc2Freq = freq * pitch * interpOsc2FrequencyOffsetPitch.process();
+        auto freq = interpFrequencyHz.process(smootherContext);
+        auto osc1Freq = freq * pitch * interpOsc1FrequencyOffsetPitch.process(smootherContext);
+        auto osc2Freq = freq * pitch * interpOsc2FrequencyOffsetPitch.process(smootherContext);
 
         auto ws1 = std::clamp<double>(
-          interpOsc1WaveShape.process() + lfoToOsc1WaveShape * lfoB, eps, 1 - eps);
+          interpOsc1WaveShape.process(smootherContext) + lfoToOsc1WaveShape * lfoB, eps, 1 - eps);
         auto ws2 = std::clamp<double>(
-          interpOsc2WaveShape.process() + lfoToOsc2WaveShape * lfoB, eps, 1 - eps);
-
-        auto spMix1 = interpOsc1SawPulse.process();
-        auto spMix2 = interpOsc2SawPulse.process();
-        auto pmLpToO1 = interpPhaseModFromLowpassToOsc1.process();
-        auto pmP1ToP2 = interpPmPhase1ToPhase2.process();
-        auto pmP2ToP1 = interpPmPhase2ToPhase1.process();
-        auto pmO1ToP2 = interpPmOsc1ToPhase2.process();
-        auto pmO2ToP1 = interpPmOsc2ToPhase1.process();
-        auto oscMix = interpOscMix.process();
-        auto gTarget = interpSvfG.process();
-        auto kTarget = interpSvfK.process();
-        auto rectMix = interpRectificationMix.process();
-        auto satMix = interpSaturationMix.process();
-        auto sustain = interpSustain.process();
+          interpOsc2WaveShape.process(smootherContext) + lfoToOsc2WaveShape * lfoB, eps, 1 - eps);
+
+        auto spMix1 = interpOsc1SawPulse.process(smootherContext);
+        auto spMix2 = interpOsc2SawPulse.process(smootherContext);
+        auto pmLpToO1 = interpPhaseModFromLowpassToOsc1.process(smootherContext);
+        auto pmP1ToP2 = interpPmPhase1ToPhase2.process(smootherContext);
+        auto pmP2ToP1 = interpPmPhase2ToPhase1.process(smootherContext);
+        auto pmO1ToP2 = interpPmOsc1ToPhase2.process(smootherContext);
+        auto pmO2ToP1 = interpPmOsc2ToPhase1.process(smootherContext);
+        auto oscMix = interpOscMix.process(smootherContext);
+        auto gTarget = interpSvfG.process(smootherContext);
+        auto kTarget = interpSvfK.process(smootherContext);
+        auto rectMix = interpRectificationMix.process(smootherContext);
+        auto satMix = interpSaturationMix.process(smootherContext);
+        auto sustain = interpSustain.process(smootherContext);
 
         // Osc1.
         phase1
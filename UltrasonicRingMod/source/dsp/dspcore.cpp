@@ -16,7 +16,7 @@ void DSPCore::setup(double sampleRate)
   this->sampleRate = double(sampleRate);
   upRate = double(sampleRate) * upFold;
 
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 
   reset();
   startup();
@@ -28,7 +28,7 @@ size_t DSPCore::getLatency() { return 0; }
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
   pitchSmoothingKp = double(                                                             \
     EMAFilter<double>::secondToP(upRate, pv[ID::noteSlideTimeSecond]->getDouble()));     \
@@ -71,7 +71,7 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   for (size_t i = 0; i < length; ++i) {
     processMidiNote(i);
@@ -81,15 +81,15 @@ void DSPCore::process(
 
     for (size_t j = 0; j < 2; ++j) {                // Halfband downsampler.
       for (size_t k = 0; k < firstStateFold; ++k) { // Stage 1 downsampler.
-        auto preClipGain = interpPreClipGain.process();
-        auto outputGain = interpOutputGain.process();
-        auto mix = interpMix.process();
-        auto freq = interpPitch.process(pitchSmoothingKp) * interpFrequencyHz.process();
-        auto dc = interpDCOffset.process();
-        auto fbGain = interpFeedbackGain.process();
-        auto modScale = interpModFrequencyScaling.process();
-        auto modWrap = interpModWrapMix.process();
-        auto hardclip = interpHardclipMix.process();
+        auto preClipGain = interpPreClipGain.process(smootherContext);
+        auto outputGain = interpOutputGain.process(smootherContext);
+        auto mix = interpMix.process(smootherContext);
+        auto freq = interpPitch.process(pitchSmoothingKp) * interpFrequencyHz.process(smootherContext);
+        auto dc = interpDCOffset.process(smootherContext);
+        auto fbGain = interpFeedbackGain.process(smootherContext);
+        auto modScale = interpModFrequencyScaling.process(smootherContext);
+        auto modWrap = interpModWrapMix.process(smootherContext);
+        auto hardclip = interpHardclipMix.process(smootherContext);
 
         phase += freq / upRate;
         phase -= std::floor(phase);
@@ -22,7 +22,7 @@ void DSPCore::setSystem()
   excitor.set(
     param.value[ParameterID::pickCombTime]->getFloat(),
     param.value[ParameterID::pickCombFeedback]->getFloat(),
-    param.value[ParameterID::randomAmount]->getFloat());
+    param.value[ParameterID::randomAmount]->getFloat(), smootherContext);
 
   cymbal.set(
     1 + param.value[ParameterID::nCymbal]->getInt(),
@@ -36,7 +36,7 @@ void DSPCore::setSystem()
     param.value[ParameterID::decay]->getFloat(),
     param.value[ParameterID::bandpassQ]->getFloat(),
     static_cast<CrossoverType>(param.value[ParameterID::cutoffMap]->getInt()),
-    param.value[ParameterID::randomAmount]->getFloat());
+    param.value[ParameterID::randomAmount]->getFloat(), smootherContext);
 }
 
 DSPCore::DSPCore() { midiNotes.reserve(128); }
@@ -45,10 +45,10 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  midiNotes.resize(0);
+  midiNotes.clear();
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(param.value[ParameterID::smoothness]->getFloat());
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(param.value[ParameterID::smoothness]->getFloat());
 
   noteStack.reserve(128);
   noteStack.resize(0);
@@ -57,7 +57,7 @@ void DSPCore::setup(double sampleRate)
   velvetNoise.sampleRate = this->sampleRate;
 
   excitor.setup(this->sampleRate);
-  cymbal.setup(this->sampleRate);
+  cymbal.setup(this->sampleRate, smootherContext);
   setSystem();
 
   startup();
@@ -84,9 +84,9 @@ void DSPCore::startup() { rnd.seed = param.value[ParameterID::seed]->getInt(); }
 
 void DSPCore::setParameters()
 {
-  SmootherCommon<float>::setTime(param.value[ParameterID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ParameterID::smoothness]->getFloat());
 
-  interpMasterGain.push(param.value[ParameterID::gain]->getFloat());
+  interpMasterGain.push(param.value[ParameterID::gain]->getFloat(), smootherContext);
 
   if (trigger) {
     trigger = false;
@@ -103,12 +103,12 @@ void DSPCore::setParameters()
   if (param.value[ParameterID::oscType]->getInt() >= 2 && !noteStack.empty()) {
     const auto freq = noteStack.back().frequency
       * paramToPitch(param.value[ParameterID::pitchBend]->getFloat());
-    interpPitch.push(freq);
+    interpPitch.push(freq, smootherContext);
     velvetNoise.setDensity(freq);
   } else {
     pulsar.setFrequency(0);
     velvetNoise.setDensity(0);
-    interpPitch.push(0.0f);
+    interpPitch.push(0.0f, smootherContext);
   }
 }
 
@@ -117,7 +117,7 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   const bool excitation = param.value[ParameterID::excitation]->getInt();
   const bool collision = param.value[ParameterID::collision]->getInt();
@@ -67,18 +67,22 @@ public:
 // Karplus-Strong algorithm. Min 10hz.
 template<typename Sample> class KSString {
 public:
-  void setup(Sample sampleRate, Sample frequency, Sample decay)
+  void setup(
+    Sample sampleRate,
+    Sample frequency,
+    Sample decay,
+    const SmootherContext<Sample> &context)
   {
     delay.setup(sampleRate, Sample(1.0) / frequency, Sample(0.1));
-    set(frequency, decay);
+    set(frequency, decay, context);
   }
 
-  void set(Sample frequency, Sample decay)
+  void set(Sample frequency, Sample decay, const SmootherContext<Sample> &context)
   {
     this->decay
       = frequency < Sample(1e-5) ? Sample(1.0) : std::pow(Sample(0.5), decay / frequency);
 
-    interpDelayTime.push(Sample(1.0) / frequency);
+    interpDelayTime.push(Sample(1.0) / frequency, context);
   }
 
   void reset()
@@ -208,10 +212,10 @@ public:
   std::array<Sample, maxStack> bandpassRnd{};
   std::array<BiquadBandpass<Sample>, maxStack> bandpass;
 
-  void setup(Sample sampleRate)
+  void setup(Sample sampleRate, const SmootherContext<Sample> &context)
   {
     wave1d.setup(sampleRate, maxStack, Sample(0.5), Sample(0.5), Sample(0.1));
-    for (auto &str : string) str.setup(sampleRate, Sample(100.0), Sample(0.5));
+    for (auto &str : string) str.setup(sampleRate, Sample(100.0), Sample(0.5), context);
     for (auto &bp : bandpass) bp.setup(sampleRate);
     stringRnd.fill(1);
     bandpassRnd.fill(1);
@@ -233,7 +237,8 @@ public:
     Sample decay,
     Sample bandpassQ,
     CrossoverType crossoverType,
-    Sample randomAmount)
+    Sample randomAmount,
+    const SmootherContext<Sample> &context)
   {
     this->stack = stack < maxStack ? stack : maxStack;
 
@@ -243,7 +248,8 @@ public:
     Sample high = 20;
     for (size_t i = 0; i < this->stack; ++i) {
       string[i].set(
-        (Sample(1.0) - randomAmount * stringRnd[i]) * maxFrequency + minFrequency, decay);
+        (Sample(1.0) - randomAmount * stringRnd[i]) * maxFrequency + minFrequency, decay,
+        context);
 
       high = getCrossoverFrequency(
         Sample(20), Sample(20000), Sample(i + 1), Sample(this->stack), crossoverType);
@@ -291,9 +297,9 @@ public:
   Sample distance = 100;
   std::array<WaveString<Sample, maxStack>, maxCymbal> string;
 
-  void setup(Sample sampleRate)
+  void setup(Sample sampleRate, const SmootherContext<Sample> &context)
   {
-    for (auto &str : string) str.setup(sampleRate);
+    for (auto &str : string) str.setup(sampleRate, context);
   }
 
   void trigger(Random<Sample> &rnd)
@@ -313,7 +319,8 @@ public:
     Sample decay,
     Sample bandpassQ,
     CrossoverType crossoverType,
-    Sample randomAmount)
+    Sample randomAmount,
+    const SmootherContext<Sample> &context)
   {
     this->nCymbal = std::min(nCymbal, maxCymbal);
     this->distance = distance;
@@ -321,7 +328,7 @@ public:
     for (size_t i = 0; i < nCymbal; ++i) {
       string[i].set(
         stack, minFrequency, maxFrequency, damping, pulsePosition, pulseWidth, decay,
-        bandpassQ, crossoverType, randomAmount);
+        bandpassQ, crossoverType, randomAmount, context);
     }
   }
 
@@ -364,11 +371,16 @@ public:
   // random is in [0, 1].
   void trigger(Sample random) { this->random = random; }
 
-  void set(Sample timeSec, Sample gain, Sample feedback, Sample randomAmount)
+  void set(
+    Sample timeSec,
+    Sample gain,
+    Sample feedback,
+    Sample randomAmount,
+    const SmootherContext<Sample> &context)
   {
     this->gain = gain;
     this->feedback = feedback;
-    interpDelayTime.push(timeSec * (Sample(1.0) - randomAmount * random));
+    interpDelayTime.push(timeSec * (Sample(1.0) - randomAmount * random), context);
   }
 
   void reset()
@@ -415,9 +427,14 @@ public:
     for (auto &cmb : comb) cmb.trigger(rnd.process());
   }
 
-  void set(Sample pickCombTime, Sample pickCombFB, Sample randomAmount)
+  void set(
+    Sample pickCombTime,
+    Sample pickCombFB,
+    Sample randomAmount,
+    const SmootherContext<Sample> &context)
   {
-    for (auto &cmb : comb) cmb.set(pickCombTime, -Sample(1.0), pickCombFB, randomAmount);
+    for (auto &cmb : comb)
+      cmb.set(pickCombTime, -Sample(1.0), pickCombFB, randomAmount, context);
   }
 
   Sample process(Sample input)
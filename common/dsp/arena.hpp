@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace SomeDSP {
+
+/**
+Bump allocator which hands out aligned slices of a single block of memory.
+
+Usage is 2 passes. First, sum up `Arena::bytes<T>(count)` of all slices and call
+`reserve`. Then call `allocate` in the same order on each setup. `reserve` only
+allocates when the capacity grows, so repeated setup with the same sample rate doesn't
+touch the heap.
+
+Slices are invalidated by `reserve`. Memory isn't initialized, and destructors of
+allocated objects are never called, so `T` should be trivial.
+*/
+class Arena {
+public:
+  static constexpr size_t alignment = 64; // Cache line size.
+
+  template<typename T> static constexpr size_t bytes(size_t count)
+  {
+    static_assert(alignof(T) <= alignment);
+    return (count * sizeof(T) + alignment - 1) & ~(alignment - 1);
+  }
+
+  void reserve(size_t size)
+  {
+    if (size > capacity) {
+      block = std::make_unique<std::byte[]>(size + alignment - 1);
+      capacity = size;
+    }
+
+    auto address = reinterpret_cast<uintptr_t>(block.get());
+    head = block.get() + (((address + alignment - 1) & ~(alignment - 1)) - address);
+    used = 0;
+  }
+
+  // Reuses the same memory from the start. Previously allocated slices are overwritten.
+  void rewind() { used = 0; }
+
+  // Returns `nullptr` when out of capacity.
+  template<typename T> T *allocate(size_t count)
+  {
+    const size_t size = bytes<T>(count);
+    if (head == nullptr || used + size > capacity) return nullptr;
+    auto ptr = reinterpret_cast<T *>(head + used);
+    used += size;
+    return ptr;
+  }
+
+  size_t getCapacity() const { return capacity; }
+  size_t getUsed() const { return used; }
+
+private:
+  std::unique_ptr<std::byte[]> block;
+  std::byte *head = nullptr;
+  size_t capacity = 0;
+  size_t used = 0;
+};
+
+} // namespace SomeDSP
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace SomeDSP {
+
+/**
+Runs a job on a worker thread, one request at a time.
+
+Audio thread calls `request()`, polls `isDone()`, then calls `finish()` after taking the
+result. State changes are lock-free on audio thread side. Worker is woken up by
+`notify_one` without holding lock, and a missed notification is picked up by timeout.
+
+Job must not touch the data used by audio thread until `finish()` is called.
+*/
+class BackgroundTask {
+private:
+  enum State : int { idle, requested, done };
+
+  std::atomic<int> state{idle};
+  std::atomic<bool> isQuitting{false};
+  std::function<void()> job;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::thread worker;
+
+public:
+  BackgroundTask(std::function<void()> job) : job(job)
+  {
+    worker = std::thread(&BackgroundTask::run, this);
+  }
+
+  ~BackgroundTask()
+  {
+    isQuitting.store(true, std::memory_order_release);
+    condition.notify_one();
+    worker.join();
+  }
+
+  BackgroundTask(const BackgroundTask &) = delete;
+  BackgroundTask &operator=(const BackgroundTask &) = delete;
+
+  bool isIdle() { return state.load(std::memory_order_acquire) == idle; }
+  bool isDone() { return state.load(std::memory_order_acquire) == done; }
+
+  // Returns false if previous request is not finished.
+  bool request()
+  {
+    int expected = idle;
+    if (!state.compare_exchange_strong(expected, requested, std::memory_order_acq_rel))
+      return false;
+    condition.notify_one();
+    return true;
+  }
+
+  void finish()
+  {
+    int expected = done;
+    state.compare_exchange_strong(expected, idle, std::memory_order_acq_rel);
+  }
+
+  // Blocks until the running job is done. Don't call this on audio thread.
+  void wait()
+  {
+    while (state.load(std::memory_order_acquire) == requested) std::this_thread::yield();
+  }
+
+private:
+  void run()
+  {
+    using namespace std::chrono_literals;
+
+    while (!isQuitting.load(std::memory_order_acquire)) {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait_for(lock, 50ms, [&]() {
+          return isQuitting.load(std::memory_order_acquire)
+            || state.load(std::memory_order_acquire) == requested;
+        });
+      }
+      if (state.load(std::memory_order_acquire) != requested) continue;
+
+      job();
+      state.store(done, std::memory_order_release);
+    }
+  }
+};
+
+} // namespace SomeDSP
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "peakhold.hpp"
 #include "smoother.hpp"
 
 #include <algorithm>
@@ -211,12 +212,17 @@ public:
   }
 };
 
-template<typename Sample, bool fastSmoothing = true> class BasicLimiter {
+// `PeakHoldType` is either `PeakHold<Sample>` or `VanHerkPeakHold<Sample>`.
+template<
+  typename Sample,
+  bool fastSmoothing = true,
+  typename PeakHoldType = PeakHold<Sample>>
+class BasicLimiter {
 private:
   size_t attackFrames = 0;
   Sample thresholdAmp = Sample(1); // thresholdAmp > 0.
 
-  PeakHold<Sample> peakhold;
+  PeakHoldType peakhold;
   DoubleAverageFilter<double, fastSmoothing> smoother;
   DoubleEMAFilter<Sample> releaseFilter;
   IntDelay<Sample> lookaheadDelay;
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "arena.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace SomeDSP {
+
+/**
+Delay line with linear interpolation.
+
+- Buffer size is power of two, and pointers are wrapped by bit mask.
+- `buf[0]` is a guard sample which mirrors the last sample of the ring. Interpolation
+  reads 2 adjacent samples without checking the boundary.
+- Writes and reads are separated. Delay time is measured from the last written sample,
+  so reading time 0 after `write(x)` returns `x`.
+- A block can be written by `writeBlock`, then read by `readBlockFractional`. This is
+  only possible when the input of the block doesn't depend on the output of the block.
+- Buffer is either owned, or a slice of `Arena` when `setup` receives one. Size the arena
+  with `bufferBytes`.
+- Before `setup`, reads return 0 from a shared zero buffer. Don't write before `setup`.
+*/
+template<typename Sample> class DelayLine {
+private:
+  static constexpr size_t guard = 1;
+
+  // Ring of 2 samples plus guard. Only read, so it can be shared by all instances.
+  static inline Sample zeroBuffer[guard + 2]{};
+
+  size_t mask = 1;
+  size_t wptr = 0;
+  Sample maxTime = 0;
+  std::vector<Sample> owned;
+  Sample *buf = zeroBuffer;
+
+  static size_t ringSize(size_t maxFrames, size_t maxBlockSize)
+  {
+    size_t size = 2;
+    while (size < maxFrames + maxBlockSize + 1) size *= 2;
+    return size;
+  }
+
+public:
+  DelayLine() = default;
+  DelayLine(const DelayLine &) = delete;
+  DelayLine &operator=(const DelayLine &) = delete;
+
+  static size_t bufferBytes(size_t maxFrames, size_t maxBlockSize = 1)
+  {
+    return Arena::bytes<Sample>(guard + ringSize(maxFrames, maxBlockSize));
+  }
+
+  /**
+  `maxFrames` is the maximum delay time in samples. Longer time is clamped.
+  `maxBlockSize` is the maximum `length` passed to `readBlockFractional`.
+  */
+  void setup(size_t maxFrames, size_t maxBlockSize = 1)
+  {
+    const size_t size = ringSize(maxFrames, maxBlockSize);
+    mask = size - 1;
+    maxTime = Sample(maxFrames);
+    owned.resize(guard + size);
+    buf = owned.data();
+
+    reset();
+  }
+
+  /**
+  Falls back to owned buffer when `arena` is out of capacity. It allocates, so it's a bug
+  of the caller which sized `arena`.
+  */
+  void setup(Arena &arena, size_t maxFrames, size_t maxBlockSize = 1)
+  {
+    const size_t size = ringSize(maxFrames, maxBlockSize);
+    auto slice = arena.allocate<Sample>(guard + size);
+    assert(slice != nullptr && "DelayLine: Arena is smaller than `bufferBytes`.");
+    if (slice == nullptr) return setup(maxFrames, maxBlockSize);
+
+    mask = size - 1;
+    maxTime = Sample(maxFrames);
+    owned.clear();
+    owned.shrink_to_fit();
+    buf = slice;
+
+    reset();
+  }
+
+  void reset()
+  {
+    wptr = 0;
+    if (buf == zeroBuffer) return;
+    std::fill(buf, buf + guard + mask + 1, Sample(0));
+  }
+
+  void write(Sample input)
+  {
+    buf[guard + wptr] = input;
+    buf[wptr == mask ? 0 : guard + wptr] = input; // Branchless update of guard.
+    wptr = (wptr + 1) & mask;
+  }
+
+  void writeBlock(const size_t length, const Sample *input)
+  {
+    const size_t size = mask + 1;
+    size_t len = length;
+    if (len > size) {
+      input += len - size;
+      len = size;
+    }
+
+    const size_t first = std::min(len, size - wptr);
+    std::copy(input, input + first, buf + guard + wptr);
+    std::copy(input + first, input + len, buf + guard);
+    wptr = (wptr + len) & mask;
+    buf[0] = buf[guard + mask];
+  }
+
+  Sample readFractional(Sample timeInSample) const
+  {
+    return readAt(wptr - 1, timeInSample);
+  }
+
+  // `output[i]` is aligned to the `i`-th sample of the last written `length` samples.
+  void readBlockFractional(
+    const size_t length, const Sample *timeInSample, Sample *output) const
+  {
+    const size_t start = wptr - length;
+    for (size_t i = 0; i < length; ++i) output[i] = readAt(start + i, timeInSample[i]);
+  }
+
+private:
+  inline Sample readAt(size_t newest, Sample timeInSample) const
+  {
+    Sample clamped = std::clamp(timeInSample, Sample(0), maxTime);
+    int timeInt = int(clamped); // Conversion to `int` is faster than to `size_t`.
+    Sample rFraction = clamped - Sample(timeInt);
+
+    const Sample *x = buf + guard + ((newest - size_t(timeInt)) & mask);
+    return x[0] + rFraction * (x[-1] - x[0]);
+  }
+};
+
+} // namespace SomeDSP
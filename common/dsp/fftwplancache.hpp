@@ -0,0 +1,219 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "../../lib/fftw3/fftw3.h"
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace SomeDSP {
+
+// `fftwMutex` is used to lock FFTW3 calls except `fftw*_execute`. In other words, FFTW3
+// isn't thread safe except `fftw*_execute` call. Defined in a source file of each plugin.
+extern std::mutex fftwMutex;
+
+/**
+Shape of 1D FFTW plan. Plans of the same shape are interchangeable by new-array execute
+functions, `fftwf_execute_dft*`, because FFTW requires only the same size, stride,
+in-place-ness and SIMD alignment for them.
+
+Real transforms only support a single contiguous transform.
+*/
+struct FftwPlanShape {
+  enum Kind : int { r2c, c2r, forward, backward };
+
+  int kind = r2c;
+  int size = 1;
+  int howMany = 1;
+  int stride = 1;
+  int distance = 0;
+  bool inPlace = false;
+  int inAlignment = 0;
+  int outAlignment = 0;
+
+  static int alignmentOf(const void *ptr)
+  {
+    return fftwf_alignment_of(reinterpret_cast<float *>(const_cast<void *>(ptr)));
+  }
+
+  static FftwPlanShape real(Kind kind, int size, const void *in, const void *out)
+  {
+    FftwPlanShape shape;
+    shape.kind = kind;
+    shape.size = size;
+    shape.inPlace = in == out;
+    shape.inAlignment = alignmentOf(in);
+    shape.outAlignment = alignmentOf(out);
+    return shape;
+  }
+
+  static FftwPlanShape complex(
+    int sign,
+    int size,
+    int howMany,
+    int stride,
+    int distance,
+    const fftwf_complex *in,
+    const fftwf_complex *out)
+  {
+    FftwPlanShape shape;
+    shape.kind = sign == FFTW_FORWARD ? forward : backward;
+    shape.size = size;
+    shape.howMany = howMany;
+    shape.stride = stride;
+    shape.distance = distance;
+    shape.inPlace = in == out;
+    shape.inAlignment = alignmentOf(in);
+    shape.outAlignment = alignmentOf(out);
+    return shape;
+  }
+
+  auto tie() const
+  {
+    return std::tie(
+      kind, size, howMany, stride, distance, inPlace, inAlignment, outAlignment);
+  }
+
+  bool operator<(const FftwPlanShape &rhs) const { return tie() < rhs.tie(); }
+};
+
+/**
+Reference counted cache of FFTW plans, shared in a plugin binary.
+
+`acquire` returns a plan for `shape`. The plan is made on internal scratch buffers, so
+it must be executed by `fftwf_execute_dft_r2c`, `fftwf_execute_dft_c2r` or
+`fftwf_execute_dft` with user arrays. Call `release` for each `acquire`.
+
+A plan is first made from wisdom with `FFTW_MEASURE` or better rigor. When there's no
+wisdom for the shape, `FFTW_ESTIMATE` is used. Measuring is too slow to run on plugin
+load, so wisdom should be generated offline, for example:
+
+```
+fftwf-wisdom -m -o wisdomf rof32768 rib32768 cif1024
+```
+
+System wisdom (`/etc/fftw/wisdomf` on Unix) is imported on first use. `importWisdom`
+adds wisdom from a file. Wisdom only affects plans made after import.
+*/
+class FftwPlanCache {
+private:
+  struct Entry {
+    fftwf_plan plan = nullptr;
+    size_t count = 0;
+  };
+
+  std::map<FftwPlanShape, Entry> entries;
+
+  // Always constructed while `fftwMutex` is locked.
+  FftwPlanCache() { fftwf_import_system_wisdom(); }
+
+  ~FftwPlanCache()
+  {
+    for (auto &[shape, entry] : entries) fftwf_destroy_plan(entry.plan);
+  }
+
+  static FftwPlanCache &instance()
+  {
+    static FftwPlanCache cache;
+    return cache;
+  }
+
+public:
+  FftwPlanCache(const FftwPlanCache &) = delete;
+  FftwPlanCache &operator=(const FftwPlanCache &) = delete;
+
+  static fftwf_plan acquire(const FftwPlanShape &shape)
+  {
+    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+
+    auto &entry = instance().entries[shape];
+    if (entry.plan == nullptr) {
+      entry.plan = plan(shape, FFTW_WISDOM_ONLY | FFTW_MEASURE);
+      if (entry.plan == nullptr) entry.plan = plan(shape, FFTW_ESTIMATE);
+    }
+    ++entry.count;
+    return entry.plan;
+  }
+
+  static void release(fftwf_plan target)
+  {
+    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+
+    auto &entries = instance().entries;
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+      if (it->second.plan != target) continue;
+      if (--it->second.count == 0) {
+        fftwf_destroy_plan(it->second.plan);
+        entries.erase(it);
+      }
+      return;
+    }
+  }
+
+  static bool importWisdom(const char *path)
+  {
+    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+    instance();
+    return fftwf_import_wisdom_from_filename(path) != 0;
+  }
+
+  static bool exportWisdom(const char *path)
+  {
+    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+    return fftwf_export_wisdom_to_filename(path) != 0;
+  }
+
+private:
+  // Measuring overwrites arrays, so scratch buffers with the same alignment are used.
+  static fftwf_plan plan(const FftwPlanShape &shape, unsigned flags)
+  {
+    size_t inSize; // In bytes.
+    size_t outSize;
+    if (shape.kind == FftwPlanShape::r2c || shape.kind == FftwPlanShape::c2r) {
+      const size_t realSize = sizeof(float) * size_t(shape.size);
+      const size_t complexSize = sizeof(fftwf_complex) * size_t(shape.size / 2 + 1);
+      const bool isForward = shape.kind == FftwPlanShape::r2c;
+      inSize = shape.inPlace ? complexSize : isForward ? realSize : complexSize;
+      outSize = shape.inPlace ? complexSize : isForward ? complexSize : realSize;
+    } else {
+      const size_t span = size_t(shape.howMany - 1) * size_t(shape.distance)
+        + size_t(shape.size - 1) * size_t(shape.stride) + 1;
+      inSize = sizeof(fftwf_complex) * span;
+      outSize = inSize;
+    }
+
+    auto inBuf = (char *)fftwf_malloc(inSize + size_t(shape.inAlignment));
+    auto outBuf = shape.inPlace
+      ? inBuf
+      : (char *)fftwf_malloc(outSize + size_t(shape.outAlignment));
+    auto in = inBuf + shape.inAlignment;
+    auto out = outBuf + shape.outAlignment;
+
+    fftwf_plan result = nullptr;
+    switch (shape.kind) {
+      case FftwPlanShape::r2c:
+        result = fftwf_plan_dft_r2c_1d(
+          shape.size, (float *)in, (fftwf_complex *)out, flags);
+        break;
+      case FftwPlanShape::c2r:
+        result = fftwf_plan_dft_c2r_1d(
+          shape.size, (fftwf_complex *)in, (float *)out, flags);
+        break;
+      default:
+        result = fftwf_plan_many_dft(
+          1, &shape.size, shape.howMany, (fftwf_complex *)in, nullptr, shape.stride,
+          shape.distance, (fftwf_complex *)out, nullptr, shape.stride, shape.distance,
+          shape.kind == FftwPlanShape::forward ? FFTW_FORWARD : FFTW_BACKWARD, flags);
+        break;
+    }
+
+    if (!shape.inPlace) fftwf_free(outBuf);
+    fftwf_free(inBuf);
+    return result;
+  }
+};
+
+} // namespace SomeDSP
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace SomeDSP {
+
+/**
+Input history of FIR filter.
+
+Buffer is double length, and each input is written twice at `ptr` and `ptr + length`.
+`data()` points to `length` contiguous samples in newest first order, so no shifting is
+required on `push`.
+*/
+template<typename Sample, size_t length> class FirHistory {
+private:
+  std::array<Sample, 2 * length> buf{};
+  size_t ptr = 0;
+
+public:
+  void reset()
+  {
+    buf.fill(Sample(0));
+    ptr = 0;
+  }
+
+  void push(Sample input)
+  {
+    ptr = (ptr == 0 ? length : ptr) - 1;
+    buf[ptr] = input;
+    buf[ptr + length] = input;
+  }
+
+  const Sample *data() const { return buf.data() + ptr; }
+  Sample operator[](size_t index) const { return buf[ptr + index]; }
+};
+
+/**
+Returns `sum(x[n] * h[n])` for `n` in `[0, length)`.
+
+Sum is split into independent lanes which compiler can map to SIMD registers (SSE, AVX or
+NEON) without `-ffast-math`. Result may differ from a sequential sum in the last bits.
+*/
+template<typename Sample, size_t length>
+inline Sample firDot(const Sample *x, const Sample *h)
+{
+  constexpr size_t nLane = 32 / sizeof(Sample);
+  constexpr size_t body = length - length % nLane;
+
+  std::array<Sample, nLane> acc{};
+  for (size_t n = 0; n < body; n += nLane) {
+    for (size_t k = 0; k < nLane; ++k) acc[k] += x[n + k] * h[n + k];
+  }
+
+  for (size_t half = nLane / 2; half > 0; half /= 2) {
+    for (size_t k = 0; k < half; ++k) acc[k] += acc[k + half];
+  }
+
+  Sample sum = acc[0];
+  for (size_t n = body; n < length; ++n) sum += x[n] * h[n];
+  return sum;
+}
+
+/**
+Transposes polyphase FIR coefficients from `[phase][tap]` to `[tap][phase]`.
+Used with `firPolyPhase`.
+*/
+template<typename Sample, size_t nPhase, size_t nTap>
+constexpr std::array<std::array<Sample, nPhase>, nTap>
+transposeFir(const std::array<std::array<Sample, nTap>, nPhase> &coefficient)
+{
+  std::array<std::array<Sample, nPhase>, nTap> transposed{};
+  for (size_t i = 0; i < nPhase; ++i) {
+    for (size_t n = 0; n < nTap; ++n) transposed[n][i] = coefficient[i][n];
+  }
+  return transposed;
+}
+
+/**
+Adds `sum(x[n] * coefficient[i][n])` to `output[i]` for each phase `i`. `transposed` is
+the output of `transposeFir`.
+
+Inner loop is independent for each phase, so compiler can vectorize it without
+reordering the sum. Result is the same as the sequential sum on each phase.
+*/
+template<typename Sample, size_t nPhase, size_t nTap>
+inline void firPolyPhase(
+  const Sample *x,
+  const std::array<std::array<Sample, nPhase>, nTap> &transposed,
+  Sample *output)
+{
+  for (size_t n = 0; n < nTap; ++n) {
+    const auto &co = transposed[n];
+    const auto xn = x[n];
+    for (size_t i = 0; i < nPhase; ++i) output[i] += xn * co[i];
+  }
+}
+
+} // namespace SomeDSP
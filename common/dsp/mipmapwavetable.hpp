@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "arena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace SomeDSP {
+
+/**
+Band-limited wavetable which stores all mip levels in a single aligned block.
+
+- Level `i` starts at `data + i * stride`. `stride` is a multiple of cache line.
+- Each level has 1 guard sample at the end, `level[length] == level[0]`, so linear
+  interpolation reads 2 adjacent samples without wrapping.
+- `octave` is a fractional index of level in `[0, nLevel - 1]`. 2 adjacent levels are
+  blended, so the last level is usually left silent.
+
+`processBatch` evaluates many lookups in one loop without branches. Lanes are
+independent, so it can be used for all voices at a time, or for a block of samples.
+*/
+template<typename Sample> class MipmapWavetable {
+private:
+  static constexpr size_t guard = 1;
+  static constexpr size_t chunkSize = 16;
+
+  Arena storage;
+  Sample *data = nullptr;
+  size_t nLevel = 0;
+  size_t length = 0;
+  size_t stride = 0;
+  Sample maxOctave = Sample(0);
+
+public:
+  // `length` must be power of 2. Contents are zero filled.
+  void resize(size_t nLevel, size_t length)
+  {
+    constexpr size_t lineSize = Arena::alignment / sizeof(Sample);
+
+    this->nLevel = std::max<size_t>(nLevel, 2);
+    this->length = std::max<size_t>(length, 1);
+    stride = (this->length + guard + lineSize - 1) / lineSize * lineSize;
+    maxOctave = Sample(this->nLevel - 2);
+
+    storage.reserve(Arena::bytes<Sample>(this->nLevel * stride));
+    data = storage.allocate<Sample>(this->nLevel * stride);
+    std::fill(data, data + this->nLevel * stride, Sample(0));
+  }
+
+  size_t levels() const { return nLevel; }
+  size_t size() const { return length; }
+
+  Sample *level(size_t index) { return data + index * stride; }
+  const Sample *level(size_t index) const { return data + index * stride; }
+
+  // Call after writing `level(index)[0:length]`.
+  void fillGuard(size_t index)
+  {
+    auto lv = level(index);
+    lv[length] = lv[0];
+  }
+
+  /**
+  `phase` is normalized in [0, 1).
+
+  Table is read by 32-bit indices, which can be gathered in vector registers. So total
+  size must be less than 2^31.
+  */
+  inline Sample process(Sample octave, Sample phase) const
+  {
+    const auto str = int32_t(stride);
+
+    auto octFloat = std::clamp(octave, Sample(0), maxOctave);
+    auto iTbl = int32_t(octFloat);
+    auto yFrac = octFloat - Sample(iTbl);
+
+    auto pos = Sample(length) * phase;
+    auto idx = int32_t(pos);
+    auto xFrac = pos - Sample(idx);
+
+    const int32_t i0 = iTbl * str + idx;
+    const int32_t i1 = i0 + str;
+    auto s0 = data[i0] + xFrac * (data[i0 + 1] - data[i0]);
+    auto s1 = data[i1] + xFrac * (data[i1 + 1] - data[i1]);
+    return s0 + yFrac * (s1 - s0);
+  }
+
+  /**
+  Same as calling `process` for each lane.
+
+  Full chunks of lanes are written to a local buffer first, because the compiler can't
+  tell that gathers from the table don't alias `output`. Remaining lanes are scalar.
+  */
+  void processBatch(
+    const size_t count, const Sample *octave, const Sample *phase, Sample *output) const
+  {
+    alignas(Arena::alignment) Sample chunk[chunkSize];
+
+    size_t start = 0;
+    for (; start + chunkSize <= count; start += chunkSize) {
+      for (size_t i = 0; i < chunkSize; ++i) {
+        chunk[i] = process(octave[start + i], phase[start + i]);
+      }
+      std::copy_n(chunk, chunkSize, output + start);
+    }
+    for (; start < count; ++start) output[start] = process(octave[start], phase[start]);
+  }
+};
+
+} // namespace SomeDSP
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "fir.hpp"
 #include "multiratecoefficient.hpp"
 
 #include <algorithm>
@@ -95,45 +96,41 @@ public:
 };
 
 template<typename Sample, typename FractionalDelayFIR> class FirUpSampler {
-  std::array<Sample, FractionalDelayFIR::bufferSize> buf{};
+  static constexpr auto coefficient = transposeFir(FractionalDelayFIR::coefficient);
+
+  FirHistory<Sample, FractionalDelayFIR::bufferSize> buf;
 
 public:
   std::array<Sample, FractionalDelayFIR::upfold> output;
 
-  void reset() { buf.fill(Sample(0)); }
+  void reset() { buf.reset(); }
 
   void process(Sample input)
   {
-    std::rotate(buf.rbegin(), buf.rbegin() + 1, buf.rend());
-    buf[0] = input;
+    buf.push(input);
 
     std::fill(output.begin(), output.end(), Sample(0));
-    for (size_t i = 0; i < FractionalDelayFIR::coefficient.size(); ++i) {
-      auto &&phase = FractionalDelayFIR::coefficient[i];
-      for (size_t n = 0; n < phase.size(); ++n) output[i] += buf[n] * phase[n];
-    }
+    firPolyPhase(buf.data(), coefficient, output.data());
   }
 };
 
 template<typename Sample, typename FractionalDelayFIR> class TruePeakMeterConvolver {
-  std::array<Sample, FractionalDelayFIR::bufferSize> buf{};
+  static constexpr auto coefficient = transposeFir(FractionalDelayFIR::coefficient);
+
+  FirHistory<Sample, FractionalDelayFIR::bufferSize> buf;
 
 public:
   std::array<Sample, FractionalDelayFIR::upfold> output;
 
-  void reset() { buf.fill(Sample(0)); }
+  void reset() { buf.reset(); }
 
   void process(Sample input)
   {
-    std::rotate(buf.rbegin(), buf.rbegin() + 1, buf.rend());
-    buf[0] = input;
+    buf.push(input);
 
     std::fill(output.begin(), output.end() - 1, Sample(0));
     output.back() = buf[FractionalDelayFIR::intDelay];
-    for (size_t i = 0; i < FractionalDelayFIR::coefficient.size(); ++i) {
-      auto &&phase = FractionalDelayFIR::coefficient[i];
-      for (size_t n = 0; n < phase.size(); ++n) output[i] += buf[n] * phase[n];
-    }
+    firPolyPhase(buf.data(), coefficient, output.data());
   }
 };
 
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+namespace SomeDSP {
+
+/**
+Queue of note events received in processing cycles. `Note` must have `frame` member which
+stores `sampleOffset` of the event.
+
+- Notes are kept sorted by `frame` on `push`. Hosts usually send events in order, so the
+  insertion is O(1) in most cases. Notes on the same frame keep the order of arrival.
+- Consumed notes are skipped by a cursor, and discarded on next `push`. Checking for
+  notes on each frame is O(1).
+- Memory is only allocated when pending notes exceed the reserved capacity.
+*/
+template<typename Note> class NoteQueue {
+private:
+  std::vector<Note> notes;
+  size_t cursor = 0;
+
+public:
+  static constexpr size_t noFrame = std::numeric_limits<size_t>::max();
+
+  NoteQueue(size_t capacity = 1024) { notes.reserve(capacity); }
+
+  void reserve(size_t capacity) { notes.reserve(capacity); }
+  bool empty() const { return cursor >= notes.size(); }
+
+  void clear()
+  {
+    notes.clear();
+    cursor = 0;
+  }
+
+  void push(const Note &note)
+  {
+    if (cursor > 0) {
+      notes.erase(notes.begin(), notes.begin() + cursor);
+      cursor = 0;
+    }
+
+    auto it = notes.end();
+    while (it != notes.begin() && note.frame < std::prev(it)->frame) --it;
+    notes.insert(it, note);
+  }
+
+  // Returns `noFrame` when there's no pending note.
+  size_t nextFrame() const { return empty() ? noFrame : size_t(notes[cursor].frame); }
+
+  // Calls `func(note)` for each pending note where `note.frame <= frame`.
+  template<typename Func> void dispatch(size_t frame, Func func)
+  {
+    while (cursor < notes.size() && size_t(notes[cursor].frame) <= frame) {
+      func(notes[cursor++]);
+    }
+  }
+
+  /**
+  Splits `[0, length)` at the frames of pending notes. On each split point, notes are
+  passed to `onNote(note)`, then `onBlock(begin, end)` is called for frames in between.
+  DSP code in `onBlock` can run without checking notes on every frame.
+  */
+  template<typename NoteFunc, typename BlockFunc>
+  void splitBlock(size_t length, NoteFunc onNote, BlockFunc onBlock)
+  {
+    size_t begin = 0;
+    while (begin < length) {
+      dispatch(begin, onNote);
+      size_t end = std::min(nextFrame(), length);
+      onBlock(begin, end);
+      begin = end;
+    }
+  }
+};
+
+} // namespace SomeDSP
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+namespace SomeDSP {
+
+/**
+Peak hold using van Herk/Gil-Werman algorithm. Output is the maximum of last `frames`
+inputs, same as `PeakHold`. Input must be non-negative.
+
+Time is split into segments of length `L = (frames - 1) / 2`. A window of `frames`
+samples is covered by a suffix of an old segment, 1 or 2 whole segments, and a prefix of
+the current segment. Suffix maxima of the previous segment are computed backwards by 1
+sample on each call, and they are complete before the window reaches them. So every
+call does the same O(1) amount of work, without loops or unbounded queue pops.
+
+- When `setFrames(0)`, all output becomes 0.
+- When `setFrames(1)`, VanHerkPeakHold will bypass the input.
+- Changing `frames` rebuilds the segments from the input history in O(frames).
+*/
+template<typename Sample> class VanHerkPeakHold {
+private:
+  std::vector<Sample> x;      // Input history.
+  std::vector<Sample> suffix; // Suffix maxima of past segments.
+  size_t wptr = 0;            // Write position.
+  size_t rptr = 0;            // Oldest position in the window.
+  size_t sptr = 0;            // Position to compute suffix maximum.
+
+  size_t maxFrames = 0;
+  size_t frames = 0;
+  size_t segment = 0; // Segment length. 0 when `frames <= 2`.
+  size_t index = 0;   // Position in current segment.
+  size_t extraIndex = 0;
+
+  Sample prefixMax = 0;
+  Sample suffixMax = 0;
+  Sample total1 = 0; // Maximum of previous segment.
+  Sample total2 = 0; // Maximum of the segment before previous.
+
+  inline size_t increment(size_t idx) { return ++idx >= x.size() ? 0 : idx; }
+  inline size_t decrement(size_t idx) { return (idx == 0 ? x.size() : idx) - 1; }
+  inline size_t back(size_t idx, size_t offset)
+  {
+    return idx >= offset ? idx - offset : idx + x.size() - offset;
+  }
+
+public:
+  VanHerkPeakHold(size_t size = 65536)
+  {
+    resize(size);
+    setFrames(1);
+  }
+
+  // `size` is the maximum of `frames`.
+  void resize(size_t size)
+  {
+    maxFrames = size;
+    x.resize(3 * (size / 2) + 4);
+    suffix.resize(x.size());
+    wptr = 0;
+    reset();
+  }
+
+  void reset()
+  {
+    std::fill(x.begin(), x.end(), Sample(0));
+    std::fill(suffix.begin(), suffix.end(), Sample(0));
+    rebuild();
+  }
+
+  void setFrames(size_t newFrames)
+  {
+    newFrames = std::min(newFrames, maxFrames);
+    if (frames == newFrames) return;
+    frames = newFrames;
+    rebuild();
+  }
+
+  Sample process(Sample input)
+  {
+    if (segment == 0) return processShort(input);
+
+    x[wptr] = input;
+    prefixMax = index == 0 ? input : std::max(prefixMax, input);
+
+    suffixMax = index == 0 ? x[sptr] : std::max(x[sptr], suffixMax);
+    suffix[sptr] = suffixMax;
+
+    Sample output = std::max(std::max(prefixMax, suffix[rptr]), total1);
+    if (index < extraIndex) output = std::max(output, total2);
+
+    wptr = increment(wptr);
+    rptr = increment(rptr);
+    sptr = decrement(sptr);
+    if (++index >= segment) {
+      index = 0;
+      total2 = total1;
+      total1 = prefixMax;
+      sptr = decrement(wptr);
+    }
+    return output;
+  }
+
+  void process(const size_t length, const Sample *input, Sample *output)
+  {
+    for (size_t i = 0; i < length; ++i) output[i] = process(input[i]);
+  }
+
+private:
+  Sample processShort(Sample input)
+  {
+    auto prev = x[decrement(wptr)];
+    x[wptr] = input;
+    wptr = increment(wptr);
+    if (frames == 0) return Sample(0);
+    return frames == 1 ? input : std::max(input, prev);
+  }
+
+  // Starts a new segment on next `process` call, and fills suffix maxima of 3 segments
+  // before it.
+  void rebuild()
+  {
+    segment = frames <= 2 ? 0 : (frames - 1) / 2;
+    extraIndex = segment == 0 ? 0 : frames - 1 - 2 * segment;
+    index = 0;
+    prefixMax = 0;
+    suffixMax = 0;
+    total1 = 0;
+    total2 = 0;
+    if (segment == 0) return;
+
+    rptr = back(wptr, frames - 1);
+    sptr = decrement(wptr);
+
+    size_t ptr = wptr;
+    for (size_t seg = 0; seg < 3; ++seg) {
+      Sample max = 0;
+      for (size_t i = 0; i < segment; ++i) {
+        ptr = decrement(ptr);
+        max = std::max(max, x[ptr]);
+        suffix[ptr] = max;
+      }
+      if (seg == 0) total1 = max;
+      if (seg == 1) total2 = max;
+    }
+  }
+};
+
+} // namespace SomeDSP
@@ -92,32 +92,64 @@ public:
   }
 };
 
-template<typename Sample> class SmootherCommon {
+/**
+Parameters shared by smoothers in a DSP instance. Own one in `DSPCore`, and pass it to
+`process` or `push` of smoothers by reference.
+
+Aligned to cache line, so that instances running on different threads don't write to the
+same line.
+*/
+template<typename Sample> class alignas(64) SmootherContext {
 public:
-  static void setSampleRate(Sample _sampleRate, Sample time = 0.04)
+  Sample sampleRate = Sample(44100);
+  Sample timeInSamples = Sample(0);
+  Sample kp = Sample(1);
+  Sample bufferSize = Sample(44100);
+
+  void setSampleRate(Sample _sampleRate, Sample time = 0.04)
   {
     sampleRate = _sampleRate;
     setTime(time);
   }
 
-  static void setTime(Sample seconds)
+  void setTime(Sample seconds)
   {
     timeInSamples = seconds * sampleRate;
     kp = Sample(EMAFilter<double>::cutoffToP(
       sampleRate, std::clamp<double>(1.0 / seconds, 0.0, sampleRate / 2.0)));
   }
-  static void setBufferSize(Sample _bufferSize) { bufferSize = _bufferSize; }
 
-  static Sample sampleRate;
-  static Sample timeInSamples;
-  static Sample kp;
-  static Sample bufferSize;
+  void setBufferSize(Sample _bufferSize) { bufferSize = _bufferSize; }
 };
 
-template<typename Sample> Sample SmootherCommon<Sample>::sampleRate = 44100.0;
-template<typename Sample> Sample SmootherCommon<Sample>::timeInSamples = 0.0;
-template<typename Sample> Sample SmootherCommon<Sample>::kp = 1.0;
-template<typename Sample> Sample SmootherCommon<Sample>::bufferSize = 44100.0;
+/**
+Legacy global context. Used when smoothers are called without `SmootherContext`.
+
+All instances of a plugin share `context`. This is a data race when a host processes
+instances on multiple threads. Deprecated, use `SmootherContext`.
+*/
+template<typename Sample> class SmootherCommon {
+public:
+  [[deprecated("Use SmootherContext.")]] static void
+  setSampleRate(Sample _sampleRate, Sample time = 0.04)
+  {
+    context.setSampleRate(_sampleRate, time);
+  }
+
+  [[deprecated("Use SmootherContext.")]] static void setTime(Sample seconds)
+  {
+    context.setTime(seconds);
+  }
+
+  [[deprecated("Use SmootherContext.")]] static void setBufferSize(Sample _bufferSize)
+  {
+    context.setBufferSize(_bufferSize);
+  }
+
+  static SmootherContext<Sample> context;
+};
+
+template<typename Sample> SmootherContext<Sample> SmootherCommon<Sample>::context{};
 
 template<typename Sample> class ExpSmoother {
 public:
@@ -137,7 +169,26 @@ public:
   // Intended to be used after `push`.
   void catchUp() { value = target; }
 
-  Sample process() { return value += SmootherCommon<Sample>::kp * (target - value); }
+  Sample process(const SmootherContext<Sample> &context)
+  {
+    return value += context.kp * (target - value);
+  }
+
+  [[deprecated("Pass SmootherContext.")]] Sample process()
+  {
+    return process(SmootherCommon<Sample>::context);
+  }
+
+  // True when `process` doesn't change `value` anymore.
+  bool isSettled(const SmootherContext<Sample> &context) const
+  {
+    return value + context.kp * (target - value) == value;
+  }
+
+  [[deprecated("Pass SmootherContext.")]] bool isSettled() const
+  {
+    return isSettled(SmootherCommon<Sample>::context);
+  }
 };
 
 template<typename Sample> class ExpSmootherLocal {
@@ -175,10 +226,100 @@ public:
   void catchUp() { value = target; }
   void catchUpAt(size_t index) { value[index] = target[index]; }
 
-  void process()
+  void process(const SmootherContext<Sample> &context)
+  {
+    for (size_t i = 0; i < length; ++i) value[i] += context.kp * (target[i] - value[i]);
+  }
+
+  [[deprecated("Pass SmootherContext.")]] void process()
+  {
+    process(SmootherCommon<Sample>::context);
+  }
+
+  bool isSettled(const SmootherContext<Sample> &context) const
   {
     for (size_t i = 0; i < length; ++i) {
-      value[i] += SmootherCommon<Sample>::kp * (target[i] - value[i]);
+      if (value[i] + context.kp * (target[i] - value[i]) != value[i]) return false;
+    }
+    return true;
+  }
+
+  [[deprecated("Pass SmootherContext.")]] bool isSettled() const
+  {
+    return isSettled(SmootherCommon<Sample>::context);
+  }
+};
+
+/**
+Contiguous bank of exponential smoothers. Same output as `ExpSmoother` on each lane.
+
+- Lanes are updated in chunks of `chunkSize`. Inner loop is independent for each lane, so
+  compiler can vectorize it.
+- A chunk is skipped after an update that changes none of its values. It's a fixed point,
+  so skipping doesn't change output. `pushAt` with a new target or change of `kp` wakes
+  the chunk again.
+*/
+template<typename Sample, size_t length> class SmootherBank {
+public:
+  static constexpr size_t chunkSize = 64 / sizeof(Sample);
+  static constexpr size_t nChunk = (length + chunkSize - 1) / chunkSize;
+
+  alignas(64) std::array<Sample, nChunk * chunkSize> value{};
+  alignas(64) std::array<Sample, nChunk * chunkSize> target{};
+
+private:
+  std::array<bool, nChunk> isMoving{};
+  Sample kp = Sample(-1);
+
+public:
+  inline Sample getValueAt(size_t index) const { return value[index]; }
+
+  inline void resetAt(size_t index, Sample resetValue = 0)
+  {
+    value[index] = resetValue;
+    target[index] = resetValue;
+  }
+
+  inline void pushAt(size_t index, Sample newTarget)
+  {
+    if (target[index] == newTarget) return;
+    target[index] = newTarget;
+    isMoving[index / chunkSize] = true;
+  }
+
+  void reset(Sample resetValue = 0)
+  {
+    value.fill(resetValue);
+    target.fill(resetValue);
+    isMoving.fill(false);
+  }
+
+  // True when `process` doesn't change any lane.
+  bool isSettled(const SmootherContext<Sample> &context) const
+  {
+    return kp == context.kp
+      && std::none_of(isMoving.begin(), isMoving.end(), [](bool b) { return b; });
+  }
+
+  void process(const SmootherContext<Sample> &context)
+  {
+    if (kp != context.kp) {
+      kp = context.kp;
+      isMoving.fill(true);
+    }
+
+    for (size_t chunk = 0; chunk < nChunk; ++chunk) {
+      if (!isMoving[chunk]) continue;
+
+      Sample *v = value.data() + chunk * chunkSize;
+      const Sample *t = target.data() + chunk * chunkSize;
+      unsigned moved = 0;
+      for (size_t i = 0; i < chunkSize; ++i) {
+        auto next = v[i] + kp * (t[i] - v[i]);
+        moved |= unsigned(next != v[i]);
+        v[i] = next;
+      }
+      isMoving[chunk] = moved != 0;
     }
   }
 };
@@ -198,7 +339,12 @@ public:
   using Common = SmootherCommon<Sample>;
 
   inline Sample getValue() { return value; }
-  virtual void refresh() { push(target); }
+  void refresh(const SmootherContext<Sample> &context) { push(target, context); }
+
+  [[deprecated("Pass SmootherContext.")]] virtual void refresh()
+  {
+    push(target, Common::context);
+  }
 
   void reset(Sample value)
   {
@@ -206,17 +352,22 @@ public:
     target = value;
   }
 
-  void push(Sample newTarget)
+  void push(Sample newTarget, const SmootherContext<Sample> &context)
   {
     target = newTarget;
-    if (Common::timeInSamples < Common::bufferSize) {
+    if (context.timeInSamples < context.bufferSize) {
       value = target;
       ramp = 0;
     } else {
-      ramp = (target - value) / Common::timeInSamples;
+      ramp = (target - value) / context.timeInSamples;
     }
   }
 
+  [[deprecated("Pass SmootherContext.")]] void push(Sample newTarget)
+  {
+    push(newTarget, Common::context);
+  }
+
   Sample process()
   {
     value += ramp;
@@ -242,13 +393,25 @@ public:
 
   void setTime(Sample seconds) { timeInSamples = seconds * sampleRate; }
   void reset(Sample value) { this->value = target = value; }
-  void refresh() { push(target); }
   inline Sample getValue() { return value; }
 
-  void push(Sample newTarget)
+  void refresh(const SmootherContext<Sample> &context) { push(target, context); }
+
+  [[deprecated("Pass SmootherContext.")]] void refresh()
+  {
+    push(target, Common::context);
+  }
+
+  [[deprecated("Pass SmootherContext.")]] void push(Sample newTarget)
+  {
+    push(newTarget, Common::context);
+  }
+
+  // Only `bufferSize` is read from `context`. Smoothing time is local.
+  void push(Sample newTarget, const SmootherContext<Sample> &context)
   {
     target = newTarget;
-    if (timeInSamples < Common::bufferSize) {
+    if (timeInSamples < context.bufferSize) {
       value = target;
       ramp = 0;
     } else {
@@ -278,13 +441,23 @@ public:
 
   inline Sample getValue() { return value; }
   void reset(Sample value) { this->value = value; }
-  void refresh() { push(target); }
+  void refresh(const SmootherContext<Sample> &context) { push(target, context); }
   void setRange(Sample max) { this->max = max; }
 
-  void push(Sample newTarget)
+  [[deprecated("Pass SmootherContext.")]] void refresh()
+  {
+    push(target, Common::context);
+  }
+
+  [[deprecated("Pass SmootherContext.")]] void push(Sample newTarget)
+  {
+    push(newTarget, Common::context);
+  }
+
+  void push(Sample newTarget, const SmootherContext<Sample> &context)
   {
     target = newTarget;
-    if (Common::timeInSamples < Common::bufferSize) {
+    if (context.timeInSamples < context.bufferSize) {
       value = target;
       return;
     }
@@ -294,19 +467,21 @@ public:
     if (dist1 < 0) {
       auto dist2 = target + max - value;
       if (std::fabs(dist1) > dist2) {
-        ramp = std::max(dist2 / Common::timeInSamples, max * eps);
+        ramp = std::max(dist2 / context.timeInSamples, max * eps);
         return;
       }
     } else {
       auto dist2 = target - max - value;
       if (dist1 > std::fabs(dist2)) {
-        ramp = std::min(dist2 / Common::timeInSamples, -max * eps);
+        ramp = std::min(dist2 / context.timeInSamples, -max * eps);
         return;
       }
     }
-    ramp = dist1 / Common::timeInSamples;
+    ramp = dist1 / context.timeInSamples;
   }
 
+  bool isSettled() const { return value == target; }
+
   Sample process()
   {
     if (value == target) return value;
@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace SomeDSP {
+
+/**
+Renders polyphonic voices in voice-major order.
+
+A block is split at note events and at every `maxFrame` samples. Each voice renders a
+whole sub-block into a scratch buffer before the next voice starts, so the state of a
+voice stays in cache instead of being reloaded on every sample.
+
+Voices are summed in the order of `voices`, starting from 0. The result is the same as
+summing the voices on each sample.
+
+Voices can also be distributed to worker threads by passing a pool to `render`.
+*/
+template<typename Sample, size_t nChannel, size_t maxFrame = 64> class VoiceRenderer {
+public:
+  using Buffer = std::array<std::array<Sample, maxFrame>, nChannel>;
+
+private:
+  alignas(64) Buffer voiceBuffer{};
+  alignas(64) Buffer mixBuffer{};
+
+  // Used by `render` with a pool. Slots are indices of `voices`.
+  std::vector<Buffer> slotBuffer;
+  std::vector<size_t> slotFrames;
+
+public:
+  // Allocates buffers for `render` with a pool. Call before processing.
+  void reserve(size_t nVoice)
+  {
+    slotBuffer.resize(nVoice);
+    slotFrames.resize(nVoice);
+  }
+
+  /**
+  - `onNote(note)` is called for each event of `queue`, before the sub-block which starts
+    on the frame of the event.
+  - `prepare`, `renderVoice` and `onBlock` are described in `render`.
+  */
+  template<
+    typename Queue,
+    typename Voices,
+    typename NoteFunc,
+    typename PrepareFunc,
+    typename VoiceFunc,
+    typename BlockFunc>
+  void process(
+    size_t length,
+    Queue &queue,
+    Voices &voices,
+    NoteFunc onNote,
+    PrepareFunc prepare,
+    VoiceFunc renderVoice,
+    BlockFunc onBlock)
+  {
+    queue.splitBlock(length, onNote, [&](size_t begin, size_t end) {
+      render(begin, end, voices, prepare, renderVoice, onBlock);
+    });
+  }
+
+  /**
+  Renders the frames `[begin, end)` without note events. Use this directly when frames
+  are not on the same rate as the note queue, such as oversampling.
+
+  - `prepare(offset, frames)` is called before voices render the frames
+    `[offset, offset + frames)`. It fills per frame values of shared state, such as
+    smoothers and LFO, which are read by voices. It may return the number of prepared
+    frames, which is in `[1, frames]`, to end the sub-block early.
+  - `renderVoice(voice, frames, buffer)` writes up to `frames` samples to `buffer`, and
+    returns the number of written samples. Returning less than `frames` means the voice
+    has stopped. Inactive voices return 0.
+  - `onBlock(offset, frames, mix)` receives the sum of voices for the frames
+    `[offset, offset + frames)`.
+  */
+  template<typename Voices, typename PrepareFunc, typename VoiceFunc, typename BlockFunc>
+  void render(
+    size_t begin,
+    size_t end,
+    Voices &voices,
+    PrepareFunc prepare,
+    VoiceFunc renderVoice,
+    BlockFunc onBlock)
+  {
+    renderBlocks(begin, end, prepare, onBlock, [&](size_t frames) {
+      for (auto &voice : voices) {
+        accumulate(renderVoice(voice, frames, voiceBuffer), voiceBuffer);
+      }
+    });
+  }
+
+  /**
+  Same as above, but voices are rendered by `pool.run(count, func)` of `WorkerPool`.
+  `renderVoice` is called from multiple threads at a time, each with a different voice.
+  Each voice writes to its own slot, and the slots are summed in the order of `voices`.
+  So the output is the same as single threaded `render`.
+
+  `reserve(voices.size())` must be called beforehand.
+  */
+  template<
+    typename Pool,
+    typename Voices,
+    typename PrepareFunc,
+    typename VoiceFunc,
+    typename BlockFunc>
+  void render(
+    Pool &pool,
+    size_t begin,
+    size_t end,
+    Voices &voices,
+    PrepareFunc prepare,
+    VoiceFunc renderVoice,
+    BlockFunc onBlock)
+  {
+    renderBlocks(begin, end, prepare, onBlock, [&](size_t frames) {
+      auto task = [&](size_t slot) {
+        slotFrames[slot] = renderVoice(voices[slot], frames, slotBuffer[slot]);
+      };
+      pool.run(voices.size(), task);
+
+      for (size_t slot = 0; slot < voices.size(); ++slot) {
+        accumulate(slotFrames[slot], slotBuffer[slot]);
+      }
+    });
+  }
+
+  // For voices which don't read shared state.
+  template<
+    typename Queue,
+    typename Voices,
+    typename NoteFunc,
+    typename VoiceFunc,
+    typename BlockFunc>
+  void process(
+    size_t length,
+    Queue &queue,
+    Voices &voices,
+    NoteFunc onNote,
+    VoiceFunc renderVoice,
+    BlockFunc onBlock)
+  {
+    process(
+      length, queue, voices, onNote, [](size_t, size_t) {}, renderVoice, onBlock);
+  }
+
+private:
+  template<typename PrepareFunc, typename BlockFunc, typename MixFunc>
+  void renderBlocks(
+    size_t begin, size_t end, PrepareFunc &prepare, BlockFunc &onBlock, MixFunc mixVoices)
+  {
+    size_t offset = begin;
+    while (offset < end) {
+      size_t frames = std::min(maxFrame, end - offset);
+      if constexpr (std::is_void_v<decltype(prepare(offset, frames))>) {
+        prepare(offset, frames);
+      } else {
+        frames = prepare(offset, frames);
+      }
+
+      for (auto &mix : mixBuffer) std::fill_n(mix.begin(), frames, Sample(0));
+      mixVoices(frames);
+
+      onBlock(offset, frames, mixBuffer);
+      offset += frames;
+    }
+  }
+
+  void accumulate(size_t frames, const Buffer &buffer)
+  {
+    for (size_t ch = 0; ch < nChannel; ++ch) {
+      for (size_t i = 0; i < frames; ++i) mixBuffer[ch][i] += buffer[ch][i];
+    }
+  }
+};
+
+} // namespace SomeDSP
@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+  #include <pthread.h>
+  #include <sched.h>
+#elif defined(_MSC_VER)
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#endif
+
+namespace SomeDSP {
+
+/**
+Worker threads which run indexed tasks together with the calling thread.
+
+`run(count, func)` calls `func(index)` for each index in `[0, count)`, and returns after
+all calls are done. The caller also takes tasks, so `run` finishes even when workers are
+parked or busy. The thread which runs an index is not fixed. To get the same result on
+every run, `func` should write to a slot of `index`, and the caller should reduce the
+slots in index order after `run`.
+
+- Tasks are claimed by compare-and-swap on a single atomic word, which packs a job
+  number, task count and next index. `run` doesn't lock or allocate.
+- Workers spin for `spinTime` after the last task, then park on a condition variable.
+  `run` wakes parked workers by `notify_all` without holding lock. A missed notification
+  is picked up by timeout.
+- Workers are pinned to cores `[1, nCore)` on Linux and Windows, to leave core 0 for the
+  host. Each pool starts from the core after the last worker of the previous pool, so
+  multiple instances are spread over cores. Pinning is skipped on other platforms.
+- Workers run on real-time priority, `SCHED_FIFO` on Linux and time critical on Windows.
+  `run` busy-waits for the tasks taken by workers, so a preempted worker would stall the
+  audio thread. Raising priority may fail without permission, such as `RLIMIT_RTPRIO`
+  on Linux. Then workers stay on default priority.
+
+Floating point environment is not inherited. Flush denormals in `func` if required.
+*/
+class WorkerPool {
+private:
+  using Invoke = void (*)(void *, size_t);
+
+  static constexpr auto spinTime = std::chrono::microseconds(200);
+  static constexpr uint64_t fieldMask = 0xffff;
+  static constexpr size_t maxCount = fieldMask;
+
+  // Bits [32, 64) are job number, [16, 32) are task count, [0, 16) are next index.
+  alignas(64) std::atomic<uint64_t> cursor{0};
+  alignas(64) std::atomic<size_t> nDone{0};
+  alignas(64) std::atomic<int> nParked{0};
+  std::atomic<bool> isQuitting{false};
+
+  // Written before publishing `cursor`. Only read after claiming a task.
+  Invoke invoke = nullptr;
+  void *context = nullptr;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::vector<std::thread> workers;
+
+  // Shared by all pools to spread workers of each instance over cores.
+  static inline std::atomic<size_t> nextCore{0};
+
+public:
+  // Number of workers is capped at `hardware_concurrency - 1`.
+  WorkerPool(size_t maxWorker)
+  {
+    const size_t nCore = std::thread::hardware_concurrency();
+    const size_t nWorker = nCore > 1 ? std::min(maxWorker, nCore - 1) : 0;
+
+    const size_t offset = nextCore.fetch_add(nWorker, std::memory_order_relaxed);
+    workers.reserve(nWorker);
+    for (size_t idx = 0; idx < nWorker; ++idx) {
+      workers.emplace_back(&WorkerPool::work, this);
+      pin(workers.back(), 1 + (offset + idx) % (nCore - 1));
+      raisePriority(workers.back());
+    }
+  }
+
+  ~WorkerPool()
+  {
+    isQuitting.store(true, std::memory_order_release);
+    condition.notify_all();
+    for (auto &worker : workers) worker.join();
+  }
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  // Number of threads excluding the caller of `run`.
+  size_t size() const { return workers.size(); }
+
+  // Not reentrant. Call from a single thread at a time.
+  template<typename Func> void run(size_t count, Func &func)
+  {
+    if (workers.empty() || count <= 1 || count > maxCount) {
+      for (size_t idx = 0; idx < count; ++idx) func(idx);
+      return;
+    }
+
+    invoke = [](void *ctx, size_t index) { (*static_cast<Func *>(ctx))(index); };
+    context = static_cast<void *>(&func);
+    nDone.store(0, std::memory_order_relaxed);
+
+    const uint64_t job = (cursor.load(std::memory_order_relaxed) >> 32) + 1;
+    cursor.store((job << 32) | (uint64_t(count) << 16), std::memory_order_seq_cst);
+    if (nParked.load(std::memory_order_seq_cst) > 0) condition.notify_all();
+
+    while (runTask()) continue;
+    while (nDone.load(std::memory_order_acquire) < count) continue;
+  }
+
+private:
+  static void pin(std::thread &thread, size_t core)
+  {
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet);
+#elif defined(_MSC_VER)
+    SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << (core % 64));
+#endif
+  }
+
+  static void raisePriority(std::thread &thread)
+  {
+#if defined(__linux__)
+    // Middle of the range, to stay below the threads of audio driver.
+    const int minPriority = sched_get_priority_min(SCHED_FIFO);
+    const int maxPriority = sched_get_priority_max(SCHED_FIFO);
+    sched_param param{};
+    param.sched_priority = minPriority + (maxPriority - minPriority) / 2;
+    pthread_setschedparam(thread.native_handle(), SCHED_FIFO, &param);
+#elif defined(_MSC_VER)
+    SetThreadPriority(thread.native_handle(), THREAD_PRIORITY_TIME_CRITICAL);
+#endif
+  }
+
+  bool hasTask()
+  {
+    const auto value = cursor.load(std::memory_order_acquire);
+    return (value & fieldMask) < ((value >> 16) & fieldMask);
+  }
+
+  // Returns false when there's no task left to claim.
+  bool runTask()
+  {
+    auto value = cursor.load(std::memory_order_acquire);
+    while ((value & fieldMask) < ((value >> 16) & fieldMask)) {
+      if (!cursor.compare_exchange_weak(
+            value, value + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+        continue;
+
+      invoke(context, size_t(value & fieldMask));
+      nDone.fetch_add(1, std::memory_order_release);
+      return true;
+    }
+    return false;
+  }
+
+  void work()
+  {
+    using namespace std::chrono_literals;
+    using Clock = std::chrono::steady_clock;
+
+    auto spinStart = Clock::now();
+    while (!isQuitting.load(std::memory_order_acquire)) {
+      if (runTask()) {
+        spinStart = Clock::now();
+        continue;
+      }
+      if (Clock::now() - spinStart < spinTime) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      nParked.fetch_add(1, std::memory_order_seq_cst);
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait_for(lock, 50ms, [&]() {
+          return isQuitting.load(std::memory_order_acquire) || hasTask();
+        });
+      }
+      nParked.fetch_sub(1, std::memory_order_seq_cst);
+      spinStart = Clock::now();
+    }
+  }
+};
+
+} // namespace SomeDSP
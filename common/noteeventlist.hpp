@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "dsp/notequeue.hpp"
+#include "pluginterfaces/vst/ivstevents.h"
+
+#include <algorithm>
+
+namespace Steinberg::Synth {
+
+/**
+Note events of a processing cycle, to be used with `ParameterAutomation::splitBlock`.
+
+`IEventList` is read once in `fetch`. Then `dispatch` passes the events in each sub-block
+with `frame` rebased to the start of the sub-block. Events are consumed by a cursor, so
+splitting a cycle doesn't rescan the list.
+
+- Events on the same offset keep the order of `IEventList`.
+- Events after the end of cycle are passed in the last sub-block.
+- Memory is only allocated when events exceed the reserved capacity.
+*/
+class NoteEventList {
+public:
+  struct Note {
+    uint32 frame;
+    bool isNoteOn;
+    int32 id;
+    int16 pitch;
+    float tuning;
+    float velocity;
+  };
+
+  NoteEventList(size_t capacity = 1024) : queue(capacity) {}
+
+  void fetch(Vst::IEventList *events)
+  {
+    queue.clear();
+    if (events == nullptr) return;
+
+    int32 eventCount = events->getEventCount();
+    for (int32 index = 0; index < eventCount; ++index) {
+      Vst::Event event;
+      if (events->getEvent(index, event) != kResultOk) continue;
+      auto frame = uint32(std::max(event.sampleOffset, int32(0)));
+      switch (event.type) {
+        case Vst::Event::kNoteOnEvent: {
+          const auto &on = event.noteOn;
+          queue.push(
+            {frame, true, on.noteId == -1 ? on.pitch : on.noteId, on.pitch, on.tuning,
+             on.velocity});
+        } break;
+
+        case Vst::Event::kNoteOffEvent: {
+          const auto &off = event.noteOff;
+          queue.push(
+            {frame, false, off.noteId == -1 ? off.pitch : off.noteId, 0, 0.0f, 0.0f});
+        } break;
+
+          // Add other event type here.
+      }
+    }
+  }
+
+  // Calls `func(note)` for each event in `[begin, end)`. `length` is the cycle length.
+  template<typename Func> void dispatch(size_t begin, size_t end, size_t length, Func func)
+  {
+    const size_t last = end >= length ? SomeDSP::NoteQueue<Note>::noFrame : end - 1;
+    queue.dispatch(last, [&](const Note &note) {
+      Note rebased = note;
+      rebased.frame = uint32(note.frame - begin);
+      func(rebased);
+    });
+  }
+
+private:
+  SomeDSP::NoteQueue<Note> queue;
+};
+
+} // namespace Steinberg::Synth
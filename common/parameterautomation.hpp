@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "pluginterfaces/vst/ivstparameterchanges.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace Steinberg::Synth {
+
+/**
+Sample accurate parameter automation.
+
+By default, processors only read the last point of each `IParamValueQueue`, and apply it
+once per processing cycle. `ParameterAutomation` keeps all the points sorted by sample
+offset, and splits a processing cycle at the offsets. This is opt-in for each plugin.
+
+- Points on the same offset keep the order of `IParameterChanges`.
+- Points after the end of cycle are applied at the end of cycle.
+- Memory is only allocated when points exceed the reserved capacity.
+*/
+class ParameterAutomation {
+public:
+  struct Point {
+    int32 offset;
+    uint32 order;
+    Vst::ParamID id;
+    Vst::ParamValue value;
+  };
+
+  static constexpr int32 endOffset = std::numeric_limits<int32>::max();
+
+  ParameterAutomation(size_t capacity = 4096) { points.reserve(capacity); }
+
+  void fetch(Vst::IParameterChanges *changes)
+  {
+    points.clear();
+    cursor = 0;
+    if (changes == nullptr) return;
+
+    uint32 order = 0;
+    int32 parameterCount = changes->getParameterCount();
+    for (int32 index = 0; index < parameterCount; ++index) {
+      auto queue = changes->getParameterData(index);
+      if (!queue) continue;
+      auto id = queue->getParameterId();
+      int32 pointCount = queue->getPointCount();
+      for (int32 pt = 0; pt < pointCount; ++pt) {
+        Vst::ParamValue value;
+        int32 sampleOffset;
+        if (queue->getPoint(pt, sampleOffset, value) != kResultTrue) continue;
+        points.push_back({std::max(sampleOffset, int32(0)), order++, id, value});
+      }
+    }
+
+    std::sort(points.begin(), points.end(), [](const Point &a, const Point &b) {
+      return a.offset < b.offset || (a.offset == b.offset && a.order < b.order);
+    });
+  }
+
+  // Returns `endOffset` when there's no pending point.
+  int32 nextOffset() const
+  {
+    return cursor < points.size() ? points[cursor].offset : endOffset;
+  }
+
+  // Calls `func(id, value)` for each pending point where `point.offset <= offset`.
+  template<typename Func> void dispatch(int32 offset, Func func)
+  {
+    while (cursor < points.size() && points[cursor].offset <= offset) {
+      func(points[cursor].id, points[cursor].value);
+      ++cursor;
+    }
+  }
+
+  /**
+  Splits `[0, length)` at the offsets of pending points. On each split point, points are
+  passed to `apply(id, value)`, then `onBlock(begin, end)` is called for frames in
+  between. Remaining points are applied after the last block.
+  */
+  template<typename ApplyFunc, typename BlockFunc>
+  void splitBlock(int32 length, ApplyFunc apply, BlockFunc onBlock)
+  {
+    int32 begin = 0;
+    while (begin < length) {
+      dispatch(begin, apply);
+      int32 end = std::min(nextOffset(), length);
+      onBlock(size_t(begin), size_t(end));
+      begin = end;
+    }
+    dispatch(endOffset, apply);
+  }
+
+private:
+  std::vector<Point> points;
+  size_t cursor = 0;
+};
+
+} // namespace Steinberg::Synth